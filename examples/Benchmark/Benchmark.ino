@@ -0,0 +1,258 @@
+/**
+ * @file Benchmark.ino
+ * @brief Microbenchmark for the WiFiCreds lookup API
+ * @author Rithik Krisna M
+ * @version 1.0.4
+ * @date 2025
+ *
+ * This example measures the cost of every public WiFiCreds accessor in
+ * nanoseconds per call and prints the results as CSV (or JSON lines) over
+ * Serial, so numbers can be collected and compared between library versions.
+ *
+ * Each accessor is measured against several name distributions:
+ * - hit:     names that exist in CREDENTIAL_SETS
+ * - miss:    names that do not exist (getSSID/getPassword fall back to default)
+ * - prefix:  names sharing a prefix with an existing name (worst case for strcmp)
+ * - default: nullptr, the default credential set
+ *
+ * Sealed passwords (WIFICREDS_SET_SEALED) are measured with copyPassword(),
+ * which decrypts them, next to getPassword() on plaintext entries. The
+ * benchmark sets BENCH_KEY, so generate the header with
+ * credgen --key 000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f
+ * to compare a sealed table with the same plaintext table. The unseal row
+ * decrypts a 64-character password, the longest possible, whatever the table.
+ *
+ * The table size is whatever credentials.h defines. To sweep table sizes,
+ * generate credentials.h files with the desired number of entries and re-run,
+ * or run `make -C extras/tests bench`, which compares the name index with a
+ * linear scan at 4, 64, 1024 and 8192 entries on the host.
+ * Works on any board; no Wi-Fi connection is made.
+ */
+
+#include <WiFiCreds.h>
+#include <WiFiCredsCipher.h>
+
+// Benchmark configuration
+const unsigned long ITERATIONS = 20000; // Calls per measurement
+const size_t MAX_PROBES = 8;            // Distinct names per distribution
+const size_t PROBE_LENGTH = 40;         // Buffer size per probe name
+
+// Set to 1 for JSON lines instead of CSV
+#define BENCH_OUTPUT_JSON 0
+
+// Probe names live in RAM, like names received at runtime
+char probes[MAX_PROBES][PROBE_LENGTH];
+size_t probeCount = 0;
+
+// Results are written here so the compiler cannot drop the calls
+volatile uintptr_t sink = 0;
+
+// Key for sealed tables; a real sketch never keeps its key in the firmware
+const uint8_t BENCH_KEY[WIFICREDS_CIPHER_KEY_LENGTH] = {
+  0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+  0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f};
+
+// Destination of copyPassword(), sized for the longest password
+char passwordCopy[WIFICREDS_PASSWORD_BUFFER_SIZE];
+
+typedef void (*BenchOp)(const char* name);
+
+void opGetSSID(const char* name) { sink += reinterpret_cast<uintptr_t>(WiFiCreds::getSSID(name)); }
+void opGetPassword(const char* name) { sink += reinterpret_cast<uintptr_t>(WiFiCreds::getPassword(name)); }
+void opIsValid(const char* name) { sink += WiFiCreds::isValid(name); }
+void opHasCredential(const char* name) { sink += WiFiCreds::hasCredential(name); }
+void opGetSSIDLength(const char* name) { sink += WiFiCreds::getSSIDLength(name); }
+void opGetPasswordLength(const char* name) { sink += WiFiCreds::getPasswordLength(name); }
+void opGetCredentialCount(const char*) { sink += WiFiCreds::getCredentialCount(); }
+void opCopyPassword(const char* name) {
+  sink += WiFiCreds::copyPassword(name, passwordCopy, sizeof(passwordCopy));
+  WiFiCredsCipher::wipe(passwordCopy, sizeof(passwordCopy));
+}
+void opBaseline(const char* name) { sink += reinterpret_cast<uintptr_t>(name); }
+
+/**
+ * @brief The four-call pattern used by the platform examples before resolve()
+ */
+void opFourCalls(const char* name) {
+  sink += reinterpret_cast<uintptr_t>(WiFiCreds::getSSID(name));
+  sink += reinterpret_cast<uintptr_t>(WiFiCreds::getPassword(name));
+  sink += WiFiCreds::getSSIDLength(name);
+  sink += WiFiCreds::getPasswordLength(name);
+}
+
+/**
+ * @brief The same data fetched with a single resolve() call
+ */
+void opResolve(const char* name) {
+  CredentialView view = WiFiCreds::resolve(name);
+  sink += reinterpret_cast<uintptr_t>(view.ssid) + reinterpret_cast<uintptr_t>(view.password);
+  sink += view.ssidLength + view.passwordLength;
+}
+
+void setup() {
+  Serial.begin(115200);
+
+  // Wait for serial to be ready
+  while (!Serial) {
+    delay(10);
+  }
+
+  Serial.println("=== WiFiCreds Benchmark ===");
+  Serial.print("Credential sets: ");
+  Serial.println(WiFiCreds::getCredentialCount());
+  Serial.println();
+
+  WiFiCredsCipher::setKey(BENCH_KEY);
+
+  if (WiFiCreds::getCredentialCount() == 0) {
+    Serial.println("ERROR: No credential sets found!");
+    return;
+  }
+
+#if !BENCH_OUTPUT_JSON
+  Serial.println("api,distribution,table_size,iterations,ns_per_op");
+#endif
+
+  const char* distributions[] = {"hit", "miss", "prefix", "default"};
+  const BenchOp ops[] = {opGetSSID, opGetPassword, opCopyPassword, opIsValid, opHasCredential,
+                         opGetSSIDLength, opGetPasswordLength, opFourCalls, opResolve, opBaseline};
+  const char* opNames[] = {"getSSID", "getPassword", "copyPassword", "isValid", "hasCredential",
+                           "getSSIDLength", "getPasswordLength", "four_call_pattern", "resolve", "baseline"};
+
+  for (size_t d = 0; d < sizeof(distributions) / sizeof(distributions[0]); d++) {
+    prepareProbes(distributions[d]);
+    for (size_t o = 0; o < sizeof(ops) / sizeof(ops[0]); o++) {
+      // hasCredential(nullptr) is a trivial early return, not worth reporting
+      if (ops[o] == opHasCredential && probeCount == 0) {
+        continue;
+      }
+      reportResult(opNames[o], distributions[d], measure(ops[o]));
+    }
+  }
+
+  // Index-based and argument-free accessors
+  reportResult("getCredentialName", "index", measureCredentialName());
+  prepareProbes("default");
+  reportResult("getCredentialCount", "none", measure(opGetCredentialCount));
+  reportResult("unseal", "64_chars", measureUnseal());
+
+  Serial.println();
+  Serial.println("Benchmark complete");
+}
+
+void loop() {
+  // This example only runs once in setup()
+}
+
+/**
+ * @brief Fill the probe buffers for a name distribution
+ * @param distribution One of "hit", "miss", "prefix" or "default"
+ */
+void prepareProbes(const char* distribution) {
+  size_t count = WiFiCreds::getCredentialCount();
+  probeCount = 0;
+
+  if (strcmp(distribution, "default") == 0) {
+    return; // nullptr probes
+  }
+
+  for (size_t i = 0; i < MAX_PROBES; i++) {
+    const char* name = WiFiCreds::getCredentialName(i % count);
+
+    if (strcmp(distribution, "hit") == 0) {
+      snprintf(probes[i], PROBE_LENGTH, "%s", name);
+    } else if (strcmp(distribution, "miss") == 0) {
+      snprintf(probes[i], PROBE_LENGTH, "~missing-%u", static_cast<unsigned>(i));
+    } else {
+      // Alternate between an extended name and a name missing its last character
+      snprintf(probes[i], PROBE_LENGTH, "%s", name);
+      size_t length = strlen(probes[i]);
+      if ((i % 2) == 0 && length + 1 < PROBE_LENGTH) {
+        probes[i][length] = '_';
+        probes[i][length + 1] = '\0';
+      } else if (length > 0) {
+        probes[i][length - 1] = '\0';
+      }
+    }
+    probeCount++;
+  }
+}
+
+/**
+ * @brief Time an operation over the current probes
+ * @param op Operation to measure
+ * @return Average nanoseconds per call
+ */
+unsigned long measure(BenchOp op) {
+  unsigned long start = micros();
+  for (unsigned long i = 0; i < ITERATIONS; i++) {
+    op((probeCount > 0) ? probes[i % probeCount] : nullptr);
+  }
+  unsigned long elapsed = micros() - start;
+  return static_cast<unsigned long>((static_cast<unsigned long long>(elapsed) * 1000ULL) / ITERATIONS);
+}
+
+/**
+ * @brief Time getCredentialName() over all valid indexes
+ * @return Average nanoseconds per call
+ */
+unsigned long measureCredentialName() {
+  size_t count = WiFiCreds::getCredentialCount();
+  unsigned long start = micros();
+  for (unsigned long i = 0; i < ITERATIONS; i++) {
+    sink += reinterpret_cast<uintptr_t>(WiFiCreds::getCredentialName(i % count));
+  }
+  unsigned long elapsed = micros() - start;
+  return static_cast<unsigned long>((static_cast<unsigned long long>(elapsed) * 1000ULL) / ITERATIONS);
+}
+
+/**
+ * @brief Time the decryption of a 64-character sealed password into a wiped buffer
+ * @return Average nanoseconds per call
+ */
+unsigned long measureUnseal() {
+  // The ciphertext bytes do not matter for timing, only the length does
+  uint8_t sealed[WIFICREDS_SEALED_NONCE_LENGTH + WIFICREDS_PASSWORD_BUFFER_SIZE - 1];
+  for (size_t i = 0; i < sizeof(sealed); i++) {
+    sealed[i] = static_cast<uint8_t>(i * 7);
+  }
+  unsigned long start = micros();
+  for (unsigned long i = 0; i < ITERATIONS; i++) {
+    sink += WiFiCredsCipher::unseal(sealed, WIFICREDS_PASSWORD_BUFFER_SIZE - 1, passwordCopy, sizeof(passwordCopy));
+    WiFiCredsCipher::wipe(passwordCopy, sizeof(passwordCopy));
+  }
+  unsigned long elapsed = micros() - start;
+  return static_cast<unsigned long>((static_cast<unsigned long long>(elapsed) * 1000ULL) / ITERATIONS);
+}
+
+/**
+ * @brief Print one result row
+ * @param api Name of the measured API
+ * @param distribution Name distribution used
+ * @param nsPerOp Measured nanoseconds per call
+ */
+void reportResult(const char* api, const char* distribution, unsigned long nsPerOp) {
+#if BENCH_OUTPUT_JSON
+  Serial.print("{\"api\":\"");
+  Serial.print(api);
+  Serial.print("\",\"distribution\":\"");
+  Serial.print(distribution);
+  Serial.print("\",\"table_size\":");
+  Serial.print(WiFiCreds::getCredentialCount());
+  Serial.print(",\"iterations\":");
+  Serial.print(ITERATIONS);
+  Serial.print(",\"ns_per_op\":");
+  Serial.print(nsPerOp);
+  Serial.println("}");
+#else
+  Serial.print(api);
+  Serial.print(",");
+  Serial.print(distribution);
+  Serial.print(",");
+  Serial.print(WiFiCreds::getCredentialCount());
+  Serial.print(",");
+  Serial.print(ITERATIONS);
+  Serial.print(",");
+  Serial.println(nsPerOp);
+#endif
+}
@@ -11,17 +11,37 @@
  */
 
 #include <WiFiCreds.h>
+#include <WiFiCredsChannelMap.h>
+#include <WiFiCredsFastReconnect.h>
+#include <WiFiCredsFormat.h>
+#include <WiFiCredsScan.h>
+#include <WiFiCredsScanScheduler.h>
 #include <WiFi.h>
+#include <EEPROM.h>
+#include <WiFiCredsEepromStorage.h>
+#include <WiFiCredsArduinoDriver.h>
 #include <esp_wifi.h>
 #include <esp_sleep.h>
 
 // ESP32 specific configuration
 const int LED_PIN = 2; // Built-in LED on most ESP32 boards
 const unsigned long WIFI_TIMEOUT = 30000; // 30 seconds timeout
-const unsigned long SCAN_INTERVAL = 60000; // Scan for networks every minute
+const unsigned long FAST_RECONNECT_TIMEOUT = 3000; // Directed reconnect after deep sleep
+const unsigned long SCAN_MIN_PERIOD = 10000; // Background scan period while networks change
+const unsigned long SCAN_MAX_PERIOD = 160000; // Background scan period while nothing changes
+const size_t MAX_CANDIDATES = 8; // Ranked networks kept from each scan
+
+// Reads scan results into fixed buffers instead of String objects
+WiFiCredsArduinoDriver driver;
+
+// Remembers the channels of the known networks across resets
+WiFiCredsEepromStorage channelStorage(0, WIFICREDS_CHANNEL_MAP_STORAGE_SIZE);
+WiFiCredsChannelMap channels(channelStorage);
+
+// Scans in the background, only on the known channels, so loop() never waits for the radio
+WiFiCredsScanScheduler scanner(driver, channels);
 
 // Global variables
-unsigned long lastScanTime = 0;
 bool wifiConnected = false;
 const char* currentCredentialName = nullptr; // Track which credential set we're using
 
@@ -57,18 +77,23 @@ void setup() {
   
   // Use default credentials (first set)
   currentCredentialName = nullptr; // Use default
+  CredentialView creds = WiFiCreds::resolve(currentCredentialName);
   Serial.println("Using default credentials:");
   Serial.print("SSID: ");
-  Serial.println(WiFiCreds::getSSID());
+  Serial.println(creds.ssid);
   
   Serial.print("SSID Length: ");
-  Serial.println(WiFiCreds::getSSIDLength());
+  Serial.println(creds.ssidLength);
   Serial.print("Password Length: ");
-  Serial.println(WiFiCreds::getPasswordLength());
+  Serial.println(creds.passwordLength);
   Serial.println();
   
   // Configure WiFi
   configureWiFi();
+  scanner.setPeriodRange(SCAN_MIN_PERIOD, SCAN_MAX_PERIOD);
+  if (!channels.begin()) {
+    Serial.println("No saved channel map, the first background scan covers the whole band");
+  }
   
   // Scan for available networks
   scanWiFiNetworks();
@@ -119,10 +144,10 @@ void loop() {
     }
   }
   
-  // Periodically scan for networks
-  if (millis() - lastScanTime > SCAN_INTERVAL) {
-    scanWiFiNetworks();
-    lastScanTime = millis();
+  // Background scans: poll() returns at once while the radio scans, scans
+  // more often while the known networks change and less often while stable
+  if (scanner.poll()) {
+    printKnownNetworks();
   }
   
   delay(1000);
@@ -156,14 +181,25 @@ void configureWiFi() {
 bool connectToWiFi() {
   Serial.println("Connecting to WiFi...");
   
-  const char* ssid = WiFiCreds::getSSID(currentCredentialName);
-  const char* password = WiFiCreds::getPassword(currentCredentialName);
+  // After deep sleep, try the remembered AP, channel and IP lease first
+  if (fastReconnect()) {
+    Serial.println("Fast reconnect succeeded");
+    return true;
+  }
+  
+  // Resolve the credential set once for both SSID and password
+  CredentialView creds = WiFiCreds::resolve(currentCredentialName);
   
   Serial.print("Network: ");
-  Serial.println(ssid);
+  Serial.println(creds.ssid);
   
-  // Start connection
-  WiFi.begin(ssid, password);
+  // Start connection with the PMK as hex PSK, so the stack skips PBKDF2
+  char psk[WIFICREDS_PSK_HEX_SIZE];
+  if (WiFiCreds::getPSKHex(currentCredentialName, psk)) {
+    WiFi.begin(creds.ssid, psk);
+  } else {
+    WiFi.begin(creds.ssid, creds.password);
+  }
   
   // Wait for connection with timeout
   unsigned long startTime = millis();
@@ -183,9 +219,56 @@ bool connectToWiFi() {
   }
   
   Serial.println();
+  rememberConnection(creds.index);
+  return true;
+}
+
+/**
+ * @brief Reconnect using the state saved before deep sleep
+ * @return true if connected, false if nothing was saved or the attempt failed
+ */
+bool fastReconnect() {
+  WiFiCredsLinkState state;
+  if (!WiFiCredsFastReconnect::load(state)) {
+    return false;
+  }
+  
+  CredentialView creds = WiFiCreds::resolveIndex(state.credentialIndex);
+  Serial.print("Fast reconnect to: ");
+  Serial.println(creds.ssid);
+  
+  // Previous lease as static IP, locked to the previous AP and channel
+  char psk[WIFICREDS_PSK_HEX_SIZE];
+  const char* password = WiFiCreds::getPSKHex(creds.name, psk) ? psk : creds.password;
+  WiFi.config(state.localIP, state.gateway, state.subnet, state.dns);
+  WiFi.begin(creds.ssid, password, state.channel, state.bssid);
+  
+  unsigned long startTime = millis();
+  while (WiFi.status() != WL_CONNECTED) {
+    delay(10);
+    
+    if (millis() - startTime > FAST_RECONNECT_TIMEOUT) {
+      // Forget the saved state and go back to DHCP for the normal path
+      Serial.println("Fast reconnect failed, using normal connect");
+      WiFiCredsFastReconnect::invalidate();
+      WiFi.disconnect();
+      WiFi.config(0U, 0U, 0U);
+      return false;
+    }
+  }
+  
   return true;
 }
 
+/**
+ * @brief Save the current connection for a fast reconnect after deep sleep
+ * @param credentialIndex Index of the credential set that connected
+ */
+void rememberConnection(size_t credentialIndex) {
+  WiFiCredsFastReconnect::save(credentialIndex, WiFi.BSSID(), WiFi.channel(),
+                               WiFi.localIP(), WiFi.gatewayIP(), WiFi.subnetMask(), WiFi.dnsIP());
+}
+
 /**
  * @brief Scan for available WiFi networks
  */
@@ -200,39 +283,64 @@ void scanWiFiNetworks() {
     Serial.print(n);
     Serial.println(" networks found:");
     
+    // Every scan result is copied into the same fixed buffers; nothing is allocated per result
+    WiFiCredsScanEntry entry;
+    char line[WIFICREDS_SCAN_ENTRY_STRING_SIZE];
+    
     for (int i = 0; i < n; ++i) {
-      Serial.print(i + 1);
-      Serial.print(": ");
-      Serial.print(WiFi.SSID(i));
-      Serial.print(" (");
-      Serial.print(WiFi.RSSI(i));
-      Serial.print(")");
-      Serial.println((WiFi.encryptionType(i) == WIFI_AUTH_OPEN) ? " " : "*");
+      if (driver.scanResult(i, entry) && WiFiCredsFormat::scanEntry(entry, line, sizeof(line))) {
+        Serial.print(i + 1);
+        Serial.print(": ");
+        Serial.println(line);
+      }
       delay(10);
     }
     
-    // Check if our target network is in range
-    bool targetFound = false;
-    const char* targetSSID = WiFiCreds::getSSID(currentCredentialName);
+    // Join the scan against all credential sets, strongest signal first
+    WiFiCredsCandidate candidates[MAX_CANDIDATES];
+    const size_t candidateCount = WiFiCredsScan::rank(driver, n, candidates, MAX_CANDIDATES);
     
-    for (int i = 0; i < n; ++i) {
-      if (WiFi.SSID(i) == targetSSID) {
-        Serial.print("Target network found! Signal strength: ");
-        Serial.print(WiFi.RSSI(i));
-        Serial.println(" dBm");
-        targetFound = true;
-        break;
-      }
+    if (candidateCount == 0) {
+      Serial.println("WARNING: No known network found in scan!");
     }
     
-    if (!targetFound) {
-      Serial.println("WARNING: Target network not found in scan!");
+    for (size_t i = 0; i < candidateCount; ++i) {
+      Serial.print("Known network: ");
+      Serial.print(WiFiCreds::getCredentialName(candidates[i].credentialIndex));
+      Serial.print(" on channel ");
+      Serial.print(candidates[i].channel);
+      Serial.print(", signal strength: ");
+      Serial.print(candidates[i].rssi);
+      Serial.println(" dBm");
     }
   }
   
+  WiFi.scanDelete();
   Serial.println();
 }
 
+/**
+ * @brief Print the known networks found by the last background scan
+ */
+void printKnownNetworks() {
+  Serial.print(scanner.fullSweep() ? "Full sweep: " : "Directed scan: ");
+  Serial.print(scanner.count());
+  Serial.print(" known network(s), next scan in ");
+  Serial.print(scanner.period() / 1000);
+  Serial.println(" s");
+  
+  for (size_t i = 0; i < scanner.count(); ++i) {
+    const WiFiCredsCandidate* known = scanner.candidate(i);
+    Serial.print("  ");
+    Serial.print(WiFiCreds::getCredentialName(known->credentialIndex));
+    Serial.print(" on channel ");
+    Serial.print(known->channel);
+    Serial.print(", signal strength: ");
+    Serial.print(known->rssi);
+    Serial.println(" dBm");
+  }
+}
+
 /**
  * @brief Print current network information
  */
@@ -266,25 +374,10 @@ void printNetworkInfo() {
 
 /**
  * @brief Get WiFi status as string
- * @return String representation of WiFi status
+ * @return Constant string for the WiFi status; no String is built
  */
-String getWiFiStatusString() {
-  switch (WiFi.status()) {
-    case WL_CONNECTED:
-      return "Connected";
-    case WL_DISCONNECTED:
-      return "Disconnected";
-    case WL_CONNECT_FAILED:
-      return "Connection Failed";
-    case WL_NO_SSID_AVAIL:
-      return "SSID Not Available";
-    case WL_IDLE_STATUS:
-      return "Idle";
-    case WL_SCAN_COMPLETED:
-      return "Scan Completed";
-    default:
-      return "Unknown";
-  }
+const char* getWiFiStatusString() {
+  return WiFiCredsArduinoDriver::statusName(WiFi.status());
 }
 
 /**
@@ -0,0 +1,103 @@
+/**
+ * @file Footprint.ino
+ * @brief SRAM footprint report for the credential table
+ * @author Rithik Krisna M
+ * @version 1.0.4
+ * @date 2025
+ * 
+ * This example reports how much SRAM the credential table costs on the
+ * current board and how much PROGMEM mode saves per entry.
+ * 
+ * On AVR and ESP8266, constants are copied to SRAM at startup unless they
+ * are marked PROGMEM. In the default mode that includes the CREDENTIAL_SETS
+ * array and all of its strings. In PROGMEM mode (WIFICREDS_USE_PROGMEM in
+ * credentials.h) both stay in flash, and only a fixed set of copy buffers
+ * lives in SRAM. Other boards read constants from flash in either mode.
+ * 
+ * Flash both modes and compare the "Free SRAM" lines for a measured saving.
+ * No Wi-Fi connection is made.
+ */
+
+#include <WiFiCreds.h>
+
+#if defined(__AVR__)
+extern int __heap_start;
+extern int* __brkval;
+#endif
+
+// SRAM of the copy buffers used in PROGMEM mode
+const size_t PROGMEM_BUFFERS = WIFICREDS_NAME_BUFFER_SIZE + WIFICREDS_SSID_BUFFER_SIZE +
+                               WIFICREDS_PASSWORD_BUFFER_SIZE + WIFICREDS_PMK_LENGTH;
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial) {
+    delay(10);
+  }
+  
+  Serial.println("=== WiFiCreds Footprint ===");
+  Serial.println();
+  
+  size_t count = WiFiCreds::getCredentialCount();
+  
+  // Table entries including the terminator, plus every string with its terminator
+  size_t tableBytes = sizeof(CredentialSet) * (count + 1);
+  size_t stringBytes = 0;
+  for (size_t i = 0; i < count; i++) {
+    const char* name = WiFiCreds::getCredentialName(i);
+    CredentialView creds = WiFiCreds::resolveIndex(i);
+    stringBytes += strlen(name) + 1 + creds.ssidLength + 1 + creds.passwordLength + 1;
+  }
+  
+  Serial.print("Storage mode: ");
+  Serial.println(WiFiCreds::usesProgmem() ? "PROGMEM" : "default");
+  Serial.print("Credential sets: ");
+  Serial.println(count);
+  Serial.print("sizeof(CredentialSet): ");
+  Serial.println(sizeof(CredentialSet));
+  Serial.print("Table bytes: ");
+  Serial.println(tableBytes);
+  Serial.print("String bytes: ");
+  Serial.println(stringBytes);
+  
+  if (count > 0) {
+    Serial.print("Bytes per entry: ");
+    Serial.println((tableBytes + stringBytes) / count);
+  }
+  
+#if defined(__AVR__) || defined(ESP8266)
+  size_t defaultSram = tableBytes + stringBytes;
+  Serial.print("SRAM in default mode: ");
+  Serial.println(defaultSram);
+  Serial.print("SRAM in PROGMEM mode: ");
+  Serial.println(PROGMEM_BUFFERS);
+  if (count > 0) {
+    Serial.print("SRAM saved per entry: ");
+    Serial.println(((long)defaultSram - (long)PROGMEM_BUFFERS) / (long)count);
+  }
+#else
+  Serial.println("This board reads constants from flash; the table uses no SRAM in either mode");
+#endif
+  
+  Serial.print("Free SRAM: ");
+  Serial.println(freeMemory());
+}
+
+void loop() {
+  // Nothing to do here
+}
+
+/**
+ * @brief Free SRAM between heap and stack, or free heap where that is not measurable
+ * @return long Free bytes, or -1 if unknown on this board
+ */
+long freeMemory() {
+#if defined(__AVR__)
+  int top;
+  return (long)&top - (__brkval == 0 ? (long)&__heap_start : (long)__brkval);
+#elif defined(ESP8266) || defined(ESP32)
+  return (long)ESP.getFreeHeap();
+#else
+  return -1;
+#endif
+}
@@ -0,0 +1,141 @@
+/**
+ * @file NonBlocking.ino
+ * @brief Non-blocking Wi-Fi connection with WiFiCredsConnection
+ * @author Rithik Krisna M
+ * @version 1.0.4
+ * @date 2025
+ * 
+ * This example connects without ever blocking loop(). WiFiCredsConnection
+ * starts an attempt and is then polled once per loop() pass, so sensor work
+ * keeps running at its own rate while the radio connects. If an attempt
+ * fails or times out, the next credential set is tried after a short pause.
+ * Attempt timeouts are learned per network from earlier connects.
+ * 
+ * The longest time a single poll() held loop() is printed, to show that the
+ * connection logic stays out of the way.
+ * 
+ * Works on ESP32, ESP8266, Arduino UNO R4 WiFi and Raspberry Pi Pico W.
+ */
+
+#include <WiFiCreds.h>
+#if defined(ESP8266)
+#include <ESP8266WiFi.h>
+#else
+#include <WiFi.h>
+#endif
+#include <WiFiCredsArduinoDriver.h>
+#include <WiFiCredsConnection.h>
+
+// Configuration
+const int LED_PIN = LED_BUILTIN;
+const unsigned long RETRY_DELAY = 2000;     // Pause before the next attempt
+const unsigned long SENSOR_INTERVAL = 100;  // Simulated sensor work
+const unsigned long REPORT_INTERVAL = 5000; // Status output
+
+WiFiCredsArduinoDriver driver;
+WiFiCredsConnection connection(driver);
+
+// Global variables
+size_t nextCredential = 0;
+unsigned long idleSince = 0;
+unsigned long lastSensorRead = 0;
+unsigned long lastReport = 0;
+unsigned long sensorReads = 0;
+unsigned long longestPollMicros = 0;
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial) {
+    delay(10);
+  }
+  
+  pinMode(LED_PIN, OUTPUT);
+  digitalWrite(LED_PIN, LOW);
+  
+  Serial.println("=== WiFiCreds Non-Blocking Example ===");
+  Serial.println();
+  
+  if (WiFiCreds::getCredentialCount() == 0) {
+    Serial.println("ERROR: No credential sets found!");
+    return;
+  }
+  
+  connection.onEvent(onWiFiEvent);
+  connection.connectIndex(nextCredential); // Timeout learned per network
+}
+
+void loop() {
+  // Advance the connection; returns immediately
+  unsigned long pollStart = micros();
+  WiFiCredsConnectionState state = connection.poll();
+  unsigned long pollMicros = micros() - pollStart;
+  if (pollMicros > longestPollMicros) {
+    longestPollMicros = pollMicros;
+  }
+  
+  // Start the next attempt after a short pause
+  if (state == WiFiCredsConnectionState::Idle && WiFiCreds::getCredentialCount() > 0 &&
+      millis() - idleSince >= RETRY_DELAY) {
+    if (!connection.connectIndex(nextCredential)) {
+      // A sealed set cannot be used before WiFiCredsCipher::setKey(); skip it
+      nextCredential = (nextCredential + 1) % WiFiCreds::getCredentialCount();
+      idleSince = millis();
+    }
+  }
+  
+  // Sensor work keeps its schedule while Wi-Fi connects
+  if (millis() - lastSensorRead >= SENSOR_INTERVAL) {
+    lastSensorRead = millis();
+    sensorReads++;
+  }
+  
+  if (millis() - lastReport >= REPORT_INTERVAL) {
+    lastReport = millis();
+    Serial.print("Sensor reads: ");
+    Serial.print(sensorReads);
+    Serial.print(", longest poll: ");
+    Serial.print(longestPollMicros);
+    Serial.println(" us");
+  }
+}
+
+/**
+ * @brief Handle connection events
+ * @param event What happened
+ * @param creds Credential set the event belongs to
+ * @param context Unused
+ */
+void onWiFiEvent(WiFiCredsEvent event, const CredentialView& creds, void* context) {
+  (void)context;
+  
+  switch (event) {
+    case WiFiCredsEvent::Connecting:
+      Serial.print("Connecting to ");
+      Serial.println(creds.ssid);
+      break;
+      
+    case WiFiCredsEvent::Connected:
+      Serial.print("Connected to ");
+      Serial.print(creds.ssid);
+      Serial.print(" in ");
+      Serial.print(connection.lastAttemptDuration());
+      Serial.println(" ms");
+      digitalWrite(LED_PIN, HIGH);
+      break;
+      
+    case WiFiCredsEvent::Failed:
+    case WiFiCredsEvent::Timeout:
+      Serial.print((event == WiFiCredsEvent::Failed) ? "Connection failed: " : "Connection timeout: ");
+      Serial.println(creds.ssid);
+      // Try the next credential set
+      nextCredential = (creds.index + 1) % WiFiCreds::getCredentialCount();
+      idleSince = millis();
+      break;
+      
+    case WiFiCredsEvent::Disconnected:
+      Serial.println("Connection lost");
+      digitalWrite(LED_PIN, LOW);
+      idleSince = millis();
+      break;
+  }
+}
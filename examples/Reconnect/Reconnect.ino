@@ -0,0 +1,142 @@
+/**
+ * @file Reconnect.ino
+ * @brief Reconnecting with backoff, jitter and an attempt budget with WiFiCredsReconnect
+ * @author Rithik Krisna M
+ * @version 1.0.4
+ * @date 2025
+ * 
+ * A sketch that retries every few seconds after a lost link is fine on its
+ * own, but a hundred of them behind one access point all retry at the same
+ * moment when it reboots, and keep the AP busy with association requests.
+ * This example hands reconnecting to WiFiCredsReconnect instead:
+ * - the first attempt after a lost link waits a random part of the base delay
+ * - each failed attempt grows the delay of that network with random jitter
+ * - an attempt budget limits how often the device tries at all
+ * 
+ * The primary network is tried first and the fallback network has its own
+ * backoff, so it is not held up while the primary one is down. The jitter is
+ * seeded from the MAC address, so no two devices retry in step.
+ * 
+ * Works on ESP32, ESP8266, Arduino UNO R4 WiFi and Raspberry Pi Pico W.
+ */
+
+#include <WiFiCreds.h>
+#if defined(ESP8266)
+#include <ESP8266WiFi.h>
+#else
+#include <WiFi.h>
+#endif
+#include <WiFiCredsArduinoDriver.h>
+#include <WiFiCredsConnection.h>
+#include <WiFiCredsReconnect.h>
+
+// Configuration
+const char* PRIMARY = "office";             // Network tried first
+const char* FALLBACK = "mobile";            // Network tried while the primary one is down
+const unsigned long REPORT_INTERVAL = 5000; // Status output
+
+WiFiCredsArduinoDriver driver;
+WiFiCredsConnection connection(driver);
+WiFiCredsReconnect reconnect(driver, connection);
+
+// Global variables
+unsigned long lastReport = 0;
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial) {
+    delay(10);
+  }
+  
+  Serial.println("=== WiFiCreds Reconnect Example ===");
+  Serial.println();
+  
+  if (WiFiCreds::getCredentialCount() == 0) {
+    Serial.println("ERROR: No credential sets found!");
+    return;
+  }
+  
+  reconnect.setSeed(macSeed());
+  reconnect.add(PRIMARY);
+  reconnect.add(FALLBACK);
+  connection.onEvent(onWiFiEvent);
+}
+
+void loop() {
+  // Connects, and reconnects after a lost link; returns immediately
+  reconnect.poll();
+  
+  if (millis() - lastReport >= REPORT_INTERVAL) {
+    lastReport = millis();
+    printStatus();
+  }
+}
+
+/**
+ * @brief Seed for the jitter that differs between devices
+ * @return uint32_t FNV-1a hash of the MAC address and the boot time
+ */
+uint32_t macSeed() {
+  uint8_t mac[6];
+  WiFi.macAddress(mac);
+  
+  uint32_t hash = 2166136261UL;
+  for (size_t i = 0; i < sizeof(mac); ++i) {
+    hash = (hash ^ mac[i]) * 16777619UL;
+  }
+  return hash ^ micros();
+}
+
+/**
+ * @brief Print the connection state and the reconnect backoff
+ */
+void printStatus() {
+  if (connection.isConnected()) {
+    Serial.print("Connected to ");
+    Serial.print(connection.credentials().ssid);
+  } else if (reconnect.waiting()) {
+    Serial.print("Next attempt in ");
+    Serial.print(reconnect.nextAttemptIn());
+    Serial.print(" ms");
+  } else {
+    Serial.print("Connecting");
+  }
+  Serial.print(", attempts ");
+  Serial.print(reconnect.attempts());
+  Serial.print(", budget left ");
+  Serial.println(reconnect.budget());
+}
+
+/**
+ * @brief Handle connection events
+ * @param event What happened
+ * @param creds Credential set the event belongs to
+ * @param context Unused
+ */
+void onWiFiEvent(WiFiCredsEvent event, const CredentialView& creds, void* context) {
+  (void)context;
+  
+  switch (event) {
+    case WiFiCredsEvent::Connecting:
+      Serial.print("Connecting to ");
+      Serial.println(creds.ssid);
+      break;
+      
+    case WiFiCredsEvent::Connected:
+      Serial.print("Connected to ");
+      Serial.print(creds.ssid);
+      Serial.print(" in ");
+      Serial.print(connection.lastAttemptDuration());
+      Serial.println(" ms");
+      break;
+      
+    case WiFiCredsEvent::Failed:
+    case WiFiCredsEvent::Timeout:
+      Serial.println((event == WiFiCredsEvent::Failed) ? "Connection failed, backing off" : "Connection timeout, backing off");
+      break;
+      
+    case WiFiCredsEvent::Disconnected:
+      Serial.println("Connection lost");
+      break;
+  }
+}
@@ -0,0 +1,161 @@
+/**
+ * @file Roaming.ino
+ * @brief Roaming between access points of one network with WiFiCredsRoaming
+ * @author Rithik Krisna M
+ * @version 1.0.4
+ * @date 2025
+ * 
+ * In a warehouse or office, one SSID is served by many access points. The
+ * Wi-Fi stack stays with its access point until the link is gone, and only
+ * then reconnects. This example moves the link to a stronger access point
+ * of the same network while the old one still works:
+ * - WiFiCredsScanScheduler scans in the background
+ * - WiFiCredsRoaming watches the RSSI trend of the link and reconnects,
+ *   pinned to the better access point, once it beats the current one by
+ *   the hysteresis margin
+ * 
+ * A packet is "sent" every 100 ms while connected, and the longest gap is
+ * printed, so the effect of roaming can be watched while walking around.
+ * 
+ * Works on ESP32 and ESP8266 (background scans are needed).
+ */
+
+#include <WiFiCreds.h>
+#if defined(ESP8266)
+#include <ESP8266WiFi.h>
+#else
+#include <WiFi.h>
+#endif
+#include <WiFiCredsArduinoDriver.h>
+#include <WiFiCredsConnection.h>
+#include <WiFiCredsScanScheduler.h>
+#include <WiFiCredsRoaming.h>
+
+// Configuration
+const char* NETWORK = "office";              // Credential set served by several access points
+const int8_t ROAM_TRIGGER = -67;             // Look for a better access point below this RSSI
+const uint8_t ROAM_MARGIN = 8;               // A new access point must be this much stronger
+const unsigned long RETRY_DELAY = 2000;      // Pause before reconnecting after a lost link
+const unsigned long PACKET_INTERVAL = 100;   // Simulated telemetry
+const unsigned long REPORT_INTERVAL = 5000;  // Status output
+
+WiFiCredsArduinoDriver driver;
+WiFiCredsConnection connection(driver);
+WiFiCredsScanScheduler scanner(driver);
+WiFiCredsRoaming roaming(driver, connection, scanner);
+
+// Global variables
+unsigned long idleSince = 0;
+unsigned long lastPacket = 0;
+unsigned long lastDelivered = 0;
+unsigned long longestGap = 0;
+unsigned long lastReport = 0;
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial) {
+    delay(10);
+  }
+  
+  Serial.println("=== WiFiCreds Roaming Example ===");
+  Serial.println();
+  
+  if (WiFiCreds::getCredentialCount() == 0) {
+    Serial.println("ERROR: No credential sets found!");
+    return;
+  }
+  
+  roaming.setTrigger(ROAM_TRIGGER);
+  roaming.setMargin(ROAM_MARGIN);
+  connection.onEvent(onWiFiEvent);
+  connection.connect(NETWORK);
+}
+
+void loop() {
+  connection.poll();
+  scanner.poll();
+  if (roaming.poll()) {
+    Serial.println("Roaming to a stronger access point");
+  }
+  
+  // Reconnect after a lost link; a roam in progress handles its own failures
+  if (connection.state() == WiFiCredsConnectionState::Idle && !roaming.roaming() &&
+      WiFiCreds::getCredentialCount() > 0 && millis() - idleSince >= RETRY_DELAY) {
+    connection.connect(NETWORK);
+  }
+  
+  if (millis() - lastPacket >= PACKET_INTERVAL) {
+    lastPacket = millis();
+    if (connection.isConnected()) {
+      if (lastDelivered != 0 && lastPacket - lastDelivered > longestGap) {
+        longestGap = lastPacket - lastDelivered;
+      }
+      lastDelivered = lastPacket;
+    }
+  }
+  
+  if (millis() - lastReport >= REPORT_INTERVAL) {
+    lastReport = millis();
+    printStatus();
+  }
+}
+
+/**
+ * @brief Print the link, its trend and the roaming candidates
+ */
+void printStatus() {
+  Serial.print("RSSI ");
+  Serial.print(roaming.rssi());
+  Serial.print(" dBm, trend ");
+  Serial.print(roaming.trend() / 10.0);
+  Serial.print(" dB/s, roams ");
+  Serial.print(roaming.roamCount());
+  Serial.print(", longest gap ");
+  Serial.print(longestGap);
+  Serial.println(" ms");
+  
+  for (size_t i = 0; i < roaming.candidateCount(); ++i) {
+    const WiFiCredsCandidate* other = roaming.candidate(i);
+    Serial.print("  candidate on channel ");
+    Serial.print(other->channel);
+    Serial.print(": ");
+    Serial.print(other->rssi);
+    Serial.println(" dBm");
+  }
+}
+
+/**
+ * @brief Handle connection events
+ * @param event What happened
+ * @param creds Credential set the event belongs to
+ * @param context Unused
+ */
+void onWiFiEvent(WiFiCredsEvent event, const CredentialView& creds, void* context) {
+  (void)context;
+  
+  switch (event) {
+    case WiFiCredsEvent::Connecting:
+      Serial.print("Connecting to ");
+      Serial.println(creds.ssid);
+      break;
+      
+    case WiFiCredsEvent::Connected:
+      Serial.print("Connected to ");
+      Serial.print(creds.ssid);
+      Serial.print(" in ");
+      Serial.print(connection.lastAttemptDuration());
+      Serial.println(" ms");
+      break;
+      
+    case WiFiCredsEvent::Failed:
+    case WiFiCredsEvent::Timeout:
+      Serial.println((event == WiFiCredsEvent::Failed) ? "Connection failed" : "Connection timeout");
+      idleSince = millis();
+      break;
+      
+    case WiFiCredsEvent::Disconnected:
+      Serial.println("Connection lost");
+      idleSince = millis();
+      break;
+  }
+}
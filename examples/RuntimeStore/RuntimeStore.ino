@@ -0,0 +1,128 @@
+/**
+ * @file RuntimeStore.ino
+ * @brief Changing credentials at runtime with WiFiCredsStore
+ * @author Rithik Krisna M
+ * @version 1.0.4
+ * @date 2025
+ * 
+ * This example keeps a writable credential store in EEPROM next to the
+ * compile-time table from credentials.h. Sets written over the serial port
+ * are saved persistently, survive a reset and take precedence over the
+ * compiled-in set with the same name, so a changed password does not need
+ * a new firmware.
+ * 
+ * Serial commands (one per line):
+ *   put <name> <ssid> <password>   Add or replace a set
+ *   del <name>                     Remove a set from the store
+ *   get <name>                     Show how a name resolves
+ *   list                           Show the store usage
+ * 
+ * Works on ESP32, ESP8266, Arduino UNO R4 WiFi, Raspberry Pi Pico W and AVR boards.
+ */
+
+#include <WiFiCreds.h>
+#include <EEPROM.h>
+#include <WiFiCredsEepromStorage.h>
+#include <WiFiCredsStore.h>
+
+// Configuration
+const size_t STORE_OFFSET = 0;   // First EEPROM byte used by the store
+const size_t STORE_SIZE = 512;   // Bytes reserved for the store
+
+WiFiCredsEepromStorage storage(STORE_OFFSET, STORE_SIZE);
+WiFiCredsStore store(storage);
+
+// Global variables
+char line[160];
+size_t lineLength = 0;
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial) {
+    delay(10);
+  }
+  
+  Serial.println("=== WiFiCreds Runtime Store Example ===");
+  Serial.println();
+  
+  if (!store.begin()) {
+    Serial.println("ERROR: Credential store could not be opened!");
+    return;
+  }
+  
+  Serial.print("Stored sets: ");
+  Serial.println(store.getCredentialCount());
+  Serial.print("Compiled-in sets: ");
+  Serial.println(WiFiCreds::getCredentialCount());
+  printResolved(nullptr);
+  Serial.println();
+  Serial.println("Commands: put <name> <ssid> <password> | del <name> | get <name> | list");
+}
+
+void loop() {
+  while (Serial.available() > 0) {
+    char c = Serial.read();
+    if (c == '\r') {
+      continue;
+    }
+    if (c == '\n') {
+      line[lineLength] = '\0';
+      handleCommand(line);
+      lineLength = 0;
+    } else if (lineLength < sizeof(line) - 1) {
+      line[lineLength++] = c;
+    }
+  }
+}
+
+void handleCommand(char* command) {
+  char* verb = strtok(command, " ");
+  char* name = strtok(nullptr, " ");
+  
+  if (verb == nullptr) {
+    return;
+  }
+  
+  if (strcmp(verb, "put") == 0 && name != nullptr) {
+    char* ssid = strtok(nullptr, " ");
+    char* password = strtok(nullptr, "");
+    if (ssid == nullptr) {
+      Serial.println("usage: put <name> <ssid> <password>");
+      return;
+    }
+    Serial.println(store.put(name, ssid, (password != nullptr) ? password : "") ? "Saved" : "ERROR: not saved");
+    printResolved(name);
+  } else if (strcmp(verb, "del") == 0 && name != nullptr) {
+    Serial.println(store.remove(name) ? "Removed" : "Not in the store");
+    printResolved(name);
+  } else if (strcmp(verb, "get") == 0) {
+    printResolved(name);
+  } else if (strcmp(verb, "list") == 0) {
+    Serial.print("Stored sets: ");
+    Serial.println(store.getCredentialCount());
+    Serial.print("Log usage: ");
+    Serial.print(store.usedBytes());
+    Serial.print(" / ");
+    Serial.print(store.capacity());
+    Serial.print(" bytes, generation ");
+    Serial.println(store.generation());
+  } else {
+    Serial.println("Unknown command");
+  }
+}
+
+void printResolved(const char* name) {
+  CredentialView creds = store.resolve(name);
+  
+  if (creds.resolution == CredentialResolution::None) {
+    Serial.println("No credential sets available");
+    return;
+  }
+  
+  Serial.print(creds.name);
+  Serial.print(" -> SSID '");
+  Serial.print(creds.ssid);
+  Serial.print("', password length ");
+  Serial.print(creds.passwordLength);
+  Serial.println(store.isStored(creds.name) ? " (store)" : " (credentials.h)");
+}
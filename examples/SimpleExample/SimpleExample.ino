@@ -136,29 +136,13 @@
    Serial.println("#define CREDENTIALS_H");
    Serial.println();
    Serial.println("// Multiple credential sets");
-   Serial.println("const CredentialSet CREDENTIAL_SETS[] = {");
+   Serial.println("constexpr CredentialSet CREDENTIAL_SETS[] = {");
    Serial.println("    // First set is always the default");
-   Serial.println("    {");
-   Serial.println("        .name = \"home\",");
-   Serial.println("        .ssid = \"MyHomeWiFi\",");
-   Serial.println("        .password = \"HomePassword123\"");
-   Serial.println("    },");
-   Serial.println("    {");
-   Serial.println("        .name = \"office\",");
-   Serial.println("        .ssid = \"OfficeNetwork\",");
-   Serial.println("        .password = \"OfficePassword456\"");
-   Serial.println("    },");
-   Serial.println("    {");
-   Serial.println("        .name = \"guest\",");
-   Serial.println("        .ssid = \"GuestWiFi\",");
-   Serial.println("        .password = \"GuestPassword789\"");
-   Serial.println("    },");
+   Serial.println("    WIFICREDS_SET(\"home\", \"MyHomeWiFi\", \"HomePassword123\"),");
+   Serial.println("    WIFICREDS_SET(\"office\", \"OfficeNetwork\", \"OfficePassword456\"),");
+   Serial.println("    WIFICREDS_SET(\"guest\", \"GuestWiFi\", \"GuestPassword789\"),");
    Serial.println("    // Terminator entry - must be last!");
-   Serial.println("    {");
-   Serial.println("        .name = nullptr,");
-   Serial.println("        .ssid = nullptr,");
-   Serial.println("        .password = nullptr");
-   Serial.println("    }");
+   Serial.println("    WIFICREDS_TERMINATOR");
    Serial.println("};");
    Serial.println();
    Serial.println("#endif");
@@ -0,0 +1,1781 @@
+/**
+ * @file credgen.cpp
+ * @brief Host tool that generates credentials.h with precomputed WPA2 PMKs
+ * @author Rithik Krisna M
+ * @version 1.0.4
+ * @date 2025
+ *
+ * Reads a credential list and writes a credentials.h whose entries carry the
+ * WPA2 pairwise master key (PBKDF2-HMAC-SHA1, 4096 iterations), so devices
+ * never run the derivation themselves. PMKs are computed in parallel on all
+ * cores, and SHA-1 is vectorized across independent derivations (4 lanes with
+ * SSE2, 8 lanes with AVX2).
+ *
+ * With --format blob the same data is written as a packed binary credential
+ * blob (see src/WiFiCredsBlob.h), and --format blob-header wraps that blob in
+ * a header as a uint8_t array. The blob needs no pointer per string, which
+ * is what makes tables of thousands of sets fit.
+ *
+ * With --key the passwords in credentials.h are sealed: encrypted with
+ * ChaCha20 under the given 32-byte key (see src/WiFiCredsCipher.h), each
+ * with its own random nonce. --device-id derives the key of one board from
+ * that master key, as WiFiCredsCipher::beginDeviceKey() does on the board.
+ * Sealed sets get no precomputed PMK, which would be as good as the password.
+ *
+ * Build (not compiled by the Arduino IDE):
+ * @code
+ * g++ -std=c++17 -O3 -march=native -pthread extras/credgen/credgen.cpp -o credgen
+ * @endcode
+ *
+ * Headers are written for tables of tens of thousands of sets: names after
+ * the default set are sorted (binary search where the hash index is not
+ * built), the hash indexes of src/WiFiCredsIndex.h are emitted precomputed
+ * so the compiler only checks them, and strings shared by several sets are
+ * stored once. PMKs are cached in <output>.pmkcache, so a rerun only derives
+ * the PMKs of new or changed SSID/password pairs, and an output that did not
+ * change is not rewritten.
+ *
+ * Input is CSV, one credential set per line: name,ssid,password. Fields may
+ * be double-quoted ("" escapes a quote); empty lines and lines starting with
+ * '#' are ignored. The first line is the default set. Files ending in .json
+ * or .yaml/.yml hold the same list as objects with name, ssid and password
+ * (see readYaml() and JsonReader).
+ *
+ * @code
+ * ./credgen -o src/credentials.h site.csv
+ * ./credgen -o src/credentials.h --cache build/pmk.cache sites.yaml
+ * ./credgen --format blob -o credentials.bin fleet.csv
+ * ./credgen --format blob-header -o src/credentials_blob.h fleet.csv
+ * ./credgen --key $(cat master.hex) --device-id 24a1600c3f8e0000 -o src/credentials.h site.csv
+ * ./credgen --bench 20000
+ * @endcode
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#include "../../src/WiFiCredsIndex.h" // WiFiCredsIndex::hashName()
+
+namespace {
+
+const size_t PMK_LENGTH = 32;
+const uint32_t PBKDF2_ITERATIONS = 4096;
+
+// Blob format, must match src/WiFiCredsBlob.h
+const uint16_t BLOB_VERSION = 1;
+const size_t BLOB_HEADER_SIZE = 20;
+const size_t BLOB_ALIGNMENT = 4;
+const uint8_t BLOB_RECORD_PMK = 0x01;
+
+// Sealed passwords, must match src/WiFiCredsCipher.h
+const size_t KEY_LENGTH = 32;
+const size_t NONCE_LENGTH = 12;
+
+struct Credential {
+    std::string name;
+    std::string ssid;
+    std::string password;
+    bool hasPmk = false;
+    uint8_t pmk[PMK_LENGTH] = {};
+    std::string sealed;        ///< Nonce and ciphertext when the password is sealed, empty otherwise
+};
+
+// ===== SHA-1 LANE TYPES =====
+
+/// One derivation per call, used for setup, odd tails and --scalar
+struct Scalar {
+    static const size_t LANES = 1;
+    uint32_t v;
+};
+
+inline Scalar set1(Scalar, uint32_t x) { return {x}; }
+inline Scalar load(Scalar, const uint32_t* p) { return {p[0]}; }
+inline void store(uint32_t* p, Scalar a) { p[0] = a.v; }
+inline Scalar operator+(Scalar a, Scalar b) { return {a.v + b.v}; }
+inline Scalar operator^(Scalar a, Scalar b) { return {a.v ^ b.v}; }
+inline Scalar operator&(Scalar a, Scalar b) { return {a.v & b.v}; }
+inline Scalar operator|(Scalar a, Scalar b) { return {a.v | b.v}; }
+inline Scalar andNot(Scalar a, Scalar b) { return {~a.v & b.v}; }
+template <int Bits> inline Scalar rotl(Scalar a) { return {(a.v << Bits) | (a.v >> (32 - Bits))}; }
+
+#if defined(__AVX2__)
+/// Eight derivations per call
+struct Simd {
+    static const size_t LANES = 8;
+    __m256i v;
+};
+
+inline Simd set1(Simd, uint32_t x) { return {_mm256_set1_epi32(static_cast<int>(x))}; }
+inline Simd load(Simd, const uint32_t* p) { return {_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p))}; }
+inline void store(uint32_t* p, Simd a) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), a.v); }
+inline Simd operator+(Simd a, Simd b) { return {_mm256_add_epi32(a.v, b.v)}; }
+inline Simd operator^(Simd a, Simd b) { return {_mm256_xor_si256(a.v, b.v)}; }
+inline Simd operator&(Simd a, Simd b) { return {_mm256_and_si256(a.v, b.v)}; }
+inline Simd operator|(Simd a, Simd b) { return {_mm256_or_si256(a.v, b.v)}; }
+inline Simd andNot(Simd a, Simd b) { return {_mm256_andnot_si256(a.v, b.v)}; }
+template <int Bits> inline Simd rotl(Simd a) {
+    return {_mm256_or_si256(_mm256_slli_epi32(a.v, Bits), _mm256_srli_epi32(a.v, 32 - Bits))};
+}
+#define CREDGEN_SIMD_NAME "AVX2"
+#elif defined(__SSE2__)
+/// Four derivations per call
+struct Simd {
+    static const size_t LANES = 4;
+    __m128i v;
+};
+
+inline Simd set1(Simd, uint32_t x) { return {_mm_set1_epi32(static_cast<int>(x))}; }
+inline Simd load(Simd, const uint32_t* p) { return {_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))}; }
+inline void store(uint32_t* p, Simd a) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), a.v); }
+inline Simd operator+(Simd a, Simd b) { return {_mm_add_epi32(a.v, b.v)}; }
+inline Simd operator^(Simd a, Simd b) { return {_mm_xor_si128(a.v, b.v)}; }
+inline Simd operator&(Simd a, Simd b) { return {_mm_and_si128(a.v, b.v)}; }
+inline Simd operator|(Simd a, Simd b) { return {_mm_or_si128(a.v, b.v)}; }
+inline Simd andNot(Simd a, Simd b) { return {_mm_andnot_si128(a.v, b.v)}; }
+template <int Bits> inline Simd rotl(Simd a) {
+    return {_mm_or_si128(_mm_slli_epi32(a.v, Bits), _mm_srli_epi32(a.v, 32 - Bits))};
+}
+#define CREDGEN_SIMD_NAME "SSE2"
+#else
+using Simd = Scalar;
+#define CREDGEN_SIMD_NAME "scalar"
+#endif
+
+// ===== SHA-1 =====
+
+/**
+ * @brief SHA-1 compression, one independent message per lane
+ *
+ * @param state Five state words per lane, updated in place
+ * @param w Sixteen message words per lane (clobbered)
+ */
+template <class V>
+inline void sha1Compress(V state[5], V w[16]) {
+    const V k1 = set1(V(), 0x5A827999U), k2 = set1(V(), 0x6ED9EBA1U);
+    const V k3 = set1(V(), 0x8F1BBCDCU), k4 = set1(V(), 0xCA62C1D6U);
+    V a = state[0], b = state[1], c = state[2], d = state[3], e = state[4];
+
+    for (int i = 0; i < 80; i++) {
+        if (i >= 16) {
+            w[i & 15] = rotl<1>(w[(i + 13) & 15] ^ w[(i + 8) & 15] ^ w[(i + 2) & 15] ^ w[i & 15]);
+        }
+        V f, k;
+        if (i < 20) {
+            f = (b & c) | andNot(b, d);
+            k = k1;
+        } else if (i < 40) {
+            f = b ^ c ^ d;
+            k = k2;
+        } else if (i < 60) {
+            f = (b & c) | (b & d) | (c & d);
+            k = k3;
+        } else {
+            f = b ^ c ^ d;
+            k = k4;
+        }
+        V t = rotl<5>(a) + f + e + k + w[i & 15];
+        e = d;
+        d = c;
+        c = rotl<30>(b);
+        b = a;
+        a = t;
+    }
+
+    state[0] = state[0] + a;
+    state[1] = state[1] + b;
+    state[2] = state[2] + c;
+    state[3] = state[3] + d;
+    state[4] = state[4] + e;
+}
+
+void sha1Init(uint32_t state[5]) {
+    state[0] = 0x67452301U;
+    state[1] = 0xEFCDAB89U;
+    state[2] = 0x98BADCFEU;
+    state[3] = 0x10325476U;
+    state[4] = 0xC3D2E1F0U;
+}
+
+/// Scalar compression of a byte block
+void sha1CompressBytes(uint32_t state[5], const uint8_t block[64]) {
+    Scalar s[5], w[16];
+    for (int i = 0; i < 5; i++) {
+        s[i].v = state[i];
+    }
+    for (int i = 0; i < 16; i++) {
+        w[i].v = (uint32_t(block[i * 4]) << 24) | (uint32_t(block[i * 4 + 1]) << 16) |
+                 (uint32_t(block[i * 4 + 2]) << 8) | uint32_t(block[i * 4 + 3]);
+    }
+    sha1Compress(s, w);
+    for (int i = 0; i < 5; i++) {
+        state[i] = s[i].v;
+    }
+}
+
+/**
+ * @brief One PBKDF2 output block, prepared for the iteration loop
+ *
+ * The HMAC key pads are absorbed once; U1 is computed with scalar code since
+ * the salt length varies. Only the 4095 fixed-shape iterations run in lanes.
+ */
+struct Job {
+    uint32_t inner[5];
+    uint32_t outer[5];
+    uint32_t u[5];
+    uint32_t t[5];
+    uint8_t* out;
+    size_t outLength;
+};
+
+/// Hash @p length bytes (< 56) on top of a state that already absorbed one block
+void finishShort(const uint32_t prefix[5], const uint8_t* data, size_t length, uint32_t digest[5]) {
+    uint8_t block[64] = {};
+    memcpy(block, data, length);
+    block[length] = 0x80;
+    const uint64_t bits = (64 + length) * 8;
+    for (int i = 0; i < 8; i++) {
+        block[63 - i] = static_cast<uint8_t>(bits >> (i * 8));
+    }
+    memcpy(digest, prefix, 5 * sizeof(uint32_t));
+    sha1CompressBytes(digest, block);
+}
+
+void digestBytes(const uint32_t digest[5], uint8_t out[20]) {
+    for (int i = 0; i < 5; i++) {
+        out[i * 4] = static_cast<uint8_t>(digest[i] >> 24);
+        out[i * 4 + 1] = static_cast<uint8_t>(digest[i] >> 16);
+        out[i * 4 + 2] = static_cast<uint8_t>(digest[i] >> 8);
+        out[i * 4 + 3] = static_cast<uint8_t>(digest[i]);
+    }
+}
+
+Job prepareJob(const Credential& cred, uint8_t blockIndex, uint8_t* out, size_t outLength) {
+    Job job;
+    uint8_t pad[64];
+
+    memset(pad, 0x36, sizeof(pad));
+    for (size_t i = 0; i < cred.password.size(); i++) {
+        pad[i] ^= static_cast<uint8_t>(cred.password[i]);
+    }
+    sha1Init(job.inner);
+    sha1CompressBytes(job.inner, pad);
+
+    memset(pad, 0x5C, sizeof(pad));
+    for (size_t i = 0; i < cred.password.size(); i++) {
+        pad[i] ^= static_cast<uint8_t>(cred.password[i]);
+    }
+    sha1Init(job.outer);
+    sha1CompressBytes(job.outer, pad);
+
+    uint8_t salt[36];
+    memcpy(salt, cred.ssid.data(), cred.ssid.size());
+    salt[cred.ssid.size()] = 0;
+    salt[cred.ssid.size() + 1] = 0;
+    salt[cred.ssid.size() + 2] = 0;
+    salt[cred.ssid.size() + 3] = blockIndex;
+
+    uint32_t innerDigest[5];
+    uint8_t innerBytes[20];
+    finishShort(job.inner, salt, cred.ssid.size() + 4, innerDigest);
+    digestBytes(innerDigest, innerBytes);
+    finishShort(job.outer, innerBytes, sizeof(innerBytes), job.u);
+    memcpy(job.t, job.u, sizeof(job.t));
+
+    job.out = out;
+    job.outLength = outLength;
+    return job;
+}
+
+/**
+ * @brief Run the remaining PBKDF2 iterations for V::LANES jobs at once
+ */
+template <class V>
+void iterateJobs(Job* jobs) {
+    const size_t lanes = V::LANES;
+    uint32_t scratch[5][lanes];
+    V inner[5], outer[5], u[5], t[5];
+
+    // Transpose job words into lane vectors
+    for (int word = 0; word < 5; word++) {
+        for (size_t lane = 0; lane < lanes; lane++) {
+            scratch[word][lane] = jobs[lane].inner[word];
+        }
+        inner[word] = load(V(), scratch[word]);
+        for (size_t lane = 0; lane < lanes; lane++) {
+            scratch[word][lane] = jobs[lane].outer[word];
+        }
+        outer[word] = load(V(), scratch[word]);
+        for (size_t lane = 0; lane < lanes; lane++) {
+            scratch[word][lane] = jobs[lane].u[word];
+        }
+        u[word] = load(V(), scratch[word]);
+        t[word] = u[word];
+    }
+
+    // Every iteration hashes a 20-byte digest: fixed padding and length words
+    const V zero = set1(V(), 0);
+    const V padWord = set1(V(), 0x80000000U);
+    const V lengthWord = set1(V(), (64 + 20) * 8);
+
+    for (uint32_t iteration = 1; iteration < PBKDF2_ITERATIONS; iteration++) {
+        V w[16];
+        V s[5];
+
+        for (int i = 0; i < 5; i++) {
+            w[i] = u[i];
+            s[i] = inner[i];
+        }
+        w[5] = padWord;
+        for (int i = 6; i < 15; i++) {
+            w[i] = zero;
+        }
+        w[15] = lengthWord;
+        sha1Compress(s, w);
+
+        for (int i = 0; i < 5; i++) {
+            w[i] = s[i];
+            u[i] = outer[i];
+        }
+        w[5] = padWord;
+        for (int i = 6; i < 15; i++) {
+            w[i] = zero;
+        }
+        w[15] = lengthWord;
+        sha1Compress(u, w);
+
+        for (int i = 0; i < 5; i++) {
+            t[i] = t[i] ^ u[i];
+        }
+    }
+
+    for (int word = 0; word < 5; word++) {
+        store(scratch[word], t[word]);
+    }
+    for (size_t lane = 0; lane < lanes; lane++) {
+        uint32_t words[5];
+        uint8_t bytes[20];
+        for (int word = 0; word < 5; word++) {
+            words[word] = scratch[word][lane];
+        }
+        digestBytes(words, bytes);
+        memcpy(jobs[lane].out, bytes, jobs[lane].outLength);
+    }
+}
+
+// ===== BATCH DERIVATION =====
+
+bool isWpaPassphrase(const Credential& cred) {
+    return !cred.ssid.empty() && cred.ssid.size() <= 32 && cred.password.size() >= 8 && cred.password.size() <= 63;
+}
+
+int hexValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+/// A 64-character hex password already is the PSK
+bool parseHexPsk(const std::string& password, uint8_t pmk[PMK_LENGTH]) {
+    if (password.size() != PMK_LENGTH * 2) {
+        return false;
+    }
+    for (size_t i = 0; i < PMK_LENGTH; i++) {
+        int hi = hexValue(password[i * 2]);
+        int lo = hexValue(password[i * 2 + 1]);
+        if (hi < 0 || lo < 0) {
+            return false;
+        }
+        pmk[i] = static_cast<uint8_t>((hi << 4) | lo);
+    }
+    return true;
+}
+
+/**
+ * @brief Compute PMKs for every credential that has a WPA2 passphrase
+ *
+ * @param creds Credentials, hasPmk/pmk are filled in; sets that already have a PMK are skipped
+ * @param threads Number of worker threads
+ * @param useSimd false to force one lane per derivation
+ */
+void derivePmks(std::vector<Credential>& creds, unsigned threads, bool useSimd) {
+    std::vector<Job> jobs;
+    jobs.reserve(creds.size() * 2);
+    for (Credential& cred : creds) {
+        if (cred.hasPmk) {
+            continue;
+        }
+        if (parseHexPsk(cred.password, cred.pmk)) {
+            cred.hasPmk = true;
+        } else if (isWpaPassphrase(cred)) {
+            // Two PBKDF2 blocks: 20 bytes from T1, 12 bytes from T2
+            jobs.push_back(prepareJob(cred, 1, cred.pmk, 20));
+            jobs.push_back(prepareJob(cred, 2, cred.pmk + 20, PMK_LENGTH - 20));
+            cred.hasPmk = true;
+        }
+    }
+
+    const size_t lanes = useSimd ? Simd::LANES : 1;
+    const size_t batches = (jobs.size() + lanes - 1) / lanes;
+    std::atomic<size_t> nextBatch(0);
+
+    auto worker = [&]() {
+        for (;;) {
+            size_t batch = nextBatch.fetch_add(1);
+            if (batch >= batches) {
+                return;
+            }
+            size_t first = batch * lanes;
+            size_t count = std::min(lanes, jobs.size() - first);
+            if (count == lanes && lanes > 1) {
+                iterateJobs<Simd>(&jobs[first]);
+            } else {
+                for (size_t i = 0; i < count; i++) {
+                    iterateJobs<Scalar>(&jobs[first + i]);
+                }
+            }
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned i = 1; i < threads; i++) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (std::thread& thread : pool) {
+        thread.join();
+    }
+}
+
+// ===== SEALED PASSWORDS =====
+
+inline uint32_t rotl32(uint32_t value, unsigned bits) {
+    return (value << bits) | (value >> (32 - bits));
+}
+
+/// One ChaCha20 block (RFC 8439), the same function as in src/WiFiCredsCipher.cpp
+void chachaBlock(const uint8_t key[KEY_LENGTH], const uint8_t nonce[NONCE_LENGTH], uint32_t counter, uint8_t out[64]) {
+    uint32_t state[16] = {0x61707865U, 0x3320646eU, 0x79622d32U, 0x6b206574U};
+    for (size_t i = 0; i < 8; i++) {
+        memcpy(&state[4 + i], key + i * 4, 4);
+    }
+    state[12] = counter;
+    memcpy(&state[13], nonce, NONCE_LENGTH);
+
+    uint32_t x[16];
+    memcpy(x, state, sizeof(x));
+    auto quarter = [&x](size_t a, size_t b, size_t c, size_t d) {
+        x[a] += x[b]; x[d] = rotl32(x[d] ^ x[a], 16);
+        x[c] += x[d]; x[b] = rotl32(x[b] ^ x[c], 12);
+        x[a] += x[b]; x[d] = rotl32(x[d] ^ x[a], 8);
+        x[c] += x[d]; x[b] = rotl32(x[b] ^ x[c], 7);
+    };
+    for (int round = 0; round < 10; round++) {
+        quarter(0, 4, 8, 12);
+        quarter(1, 5, 9, 13);
+        quarter(2, 6, 10, 14);
+        quarter(3, 7, 11, 15);
+        quarter(0, 5, 10, 15);
+        quarter(1, 6, 11, 12);
+        quarter(2, 7, 8, 13);
+        quarter(3, 4, 9, 14);
+    }
+    for (size_t i = 0; i < 16; i++) {
+        x[i] += state[i];
+    }
+    // Little-endian hosts only, like the rest of the tool
+    memcpy(out, x, 64);
+}
+
+bool parseHexBytes(const std::string& text, std::vector<uint8_t>& bytes) {
+    if (text.size() % 2 != 0) {
+        return false;
+    }
+    bytes.clear();
+    for (size_t i = 0; i < text.size(); i += 2) {
+        int hi = hexValue(text[i]);
+        int lo = hexValue(text[i + 1]);
+        if (hi < 0 || lo < 0) {
+            return false;
+        }
+        bytes.push_back(static_cast<uint8_t>((hi << 4) | lo));
+    }
+    return true;
+}
+
+/// Device key as derived by WiFiCredsCipher::deriveKey()
+void deriveDeviceKey(const uint8_t master[KEY_LENGTH], const std::vector<uint8_t>& id, uint8_t key[KEY_LENGTH]) {
+    uint8_t nonce[NONCE_LENGTH] = {};
+    memcpy(nonce, id.data(), std::min(id.size(), NONCE_LENGTH));
+    uint8_t block[64];
+    chachaBlock(master, nonce, 0, block);
+    memcpy(key, block, KEY_LENGTH);
+}
+
+/**
+ * @brief Encrypt every password under @p key, each with a fresh random nonce
+ * @return false if a password is longer than one ChaCha20 block
+ */
+bool sealPasswords(std::vector<Credential>& creds, const uint8_t key[KEY_LENGTH]) {
+    std::random_device random;
+    for (Credential& cred : creds) {
+        // Open networks have nothing to hide
+        if (cred.password.empty()) {
+            continue;
+        }
+        if (cred.password.size() > 64) {
+            std::cerr << "credgen: password of " << cred.name << " is longer than 64 characters\n";
+            return false;
+        }
+        uint8_t nonce[NONCE_LENGTH];
+        for (size_t i = 0; i < NONCE_LENGTH; i += 4) {
+            const uint32_t word = random();
+            memcpy(nonce + i, &word, 4);
+        }
+        uint8_t stream[64];
+        chachaBlock(key, nonce, 0, stream);
+        cred.sealed.assign(reinterpret_cast<const char*>(nonce), NONCE_LENGTH);
+        for (size_t i = 0; i < cred.password.size(); i++) {
+            cred.sealed += static_cast<char>(static_cast<uint8_t>(cred.password[i]) ^ stream[i]);
+        }
+    }
+    return true;
+}
+
+// ===== INPUT =====
+
+/**
+ * @brief Check one credential set and append it
+ * @param where Position for error messages, "file:line"
+ * @param names Names seen so far, to reject duplicates
+ */
+bool addCredential(const std::string& where, const std::string& name, const std::string& ssid,
+                   const std::string& password, std::set<std::string>& names, std::vector<Credential>& creds) {
+    if (name.empty()) {
+        std::cerr << where << ": empty name\n";
+        return false;
+    }
+    if (!names.insert(name).second) {
+        std::cerr << where << ": duplicate name '" << name << "'\n";
+        return false;
+    }
+    if (ssid.size() > 32) {
+        std::cerr << where << ": SSID longer than 32 bytes\n";
+        return false;
+    }
+    if (password.size() > 255) {
+        std::cerr << where << ": password longer than 255 bytes\n";
+        return false;
+    }
+    Credential cred;
+    cred.name = name;
+    cred.ssid = ssid;
+    cred.password = password;
+    creds.push_back(cred);
+    return true;
+}
+
+/**
+ * @brief Split one CSV line, honouring double quotes
+ * @return false if a quoted field is not closed
+ */
+bool splitCsv(const std::string& line, std::vector<std::string>& fields) {
+    fields.clear();
+    std::string field;
+    bool quoted = false;
+    for (size_t i = 0; i < line.size(); i++) {
+        char c = line[i];
+        if (quoted) {
+            if (c == '"' && i + 1 < line.size() && line[i + 1] == '"') {
+                field += '"';
+                i++;
+            } else if (c == '"') {
+                quoted = false;
+            } else {
+                field += c;
+            }
+        } else if (c == '"') {
+            quoted = true;
+        } else if (c == ',') {
+            fields.push_back(field);
+            field.clear();
+        } else if (c != '\r') {
+            field += c;
+        }
+    }
+    fields.push_back(field);
+    return !quoted;
+}
+
+bool readCsv(std::istream& in, const std::string& source, std::vector<Credential>& creds) {
+    std::string line;
+    std::vector<std::string> fields;
+    std::set<std::string> names;
+    size_t lineNumber = 0;
+
+    while (std::getline(in, line)) {
+        lineNumber++;
+        if (line.empty() || line[0] == '#' || line.find_first_not_of(" \t\r") == std::string::npos) {
+            continue;
+        }
+        if (!splitCsv(line, fields) || fields.size() != 3) {
+            std::cerr << source << ":" << lineNumber << ": expected name,ssid,password\n";
+            return false;
+        }
+        if (!addCredential(source + ":" + std::to_string(lineNumber), fields[0], fields[1], fields[2], names, creds)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Minimal JSON reader for credential lists
+ *
+ * Accepts an array of objects, or an object whose "networks" member is such
+ * an array. Each object needs "name" and "ssid" strings; "password" may be
+ * left out for open networks. Other members are ignored.
+ */
+class JsonReader {
+public:
+    JsonReader(const std::string& text, const std::string& source) : _text(text), _source(source), _pos(0) {}
+
+    bool read(std::vector<Credential>& creds) {
+        skipSpace();
+        if (peek() == '{') {
+            // {"networks": [...]}: find the member, skip everything else
+            _pos++;
+            bool found = false;
+            for (;;) {
+                skipSpace();
+                std::string key;
+                if (!parseString(key) || !expect(':')) {
+                    return false;
+                }
+                skipSpace();
+                if (key == "networks" && peek() == '[') {
+                    if (!readArray(creds)) {
+                        return false;
+                    }
+                    found = true;
+                } else if (!skipValue(0)) {
+                    return false;
+                }
+                skipSpace();
+                if (peek() == ',') {
+                    _pos++;
+                } else {
+                    break;
+                }
+            }
+            if (!expect('}')) {
+                return false;
+            }
+            if (!found) {
+                return fail("expected a \"networks\" array");
+            }
+        } else if (!readArray(creds)) {
+            return false;
+        }
+        skipSpace();
+        return (_pos == _text.size()) ? true : fail("unexpected text after the list");
+    }
+
+private:
+    const std::string& _text;
+    const std::string& _source;
+    size_t _pos;
+
+    char peek() const { return (_pos < _text.size()) ? _text[_pos] : '\0'; }
+
+    size_t line() const { return 1 + std::count(_text.begin(), _text.begin() + _pos, '\n'); }
+
+    bool fail(const char* message) const {
+        std::cerr << _source << ":" << line() << ": " << message << "\n";
+        return false;
+    }
+
+    void skipSpace() {
+        while (_pos < _text.size() && strchr(" \t\r\n", _text[_pos]) != nullptr) {
+            _pos++;
+        }
+    }
+
+    bool expect(char c) {
+        skipSpace();
+        if (peek() != c) {
+            std::string message = std::string("expected '") + c + "'";
+            return fail(message.c_str());
+        }
+        _pos++;
+        return true;
+    }
+
+    static void appendUtf8(std::string& out, uint32_t code) {
+        if (code < 0x80) {
+            out += static_cast<char>(code);
+        } else if (code < 0x800) {
+            out += static_cast<char>(0xC0 | (code >> 6));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        } else if (code < 0x10000) {
+            out += static_cast<char>(0xE0 | (code >> 12));
+            out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        } else {
+            out += static_cast<char>(0xF0 | (code >> 18));
+            out += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        }
+    }
+
+    bool parseHex4(uint32_t& code) {
+        code = 0;
+        for (int i = 0; i < 4; i++) {
+            const int digit = hexValue(peek());
+            if (digit < 0) {
+                return fail("bad \\u escape");
+            }
+            code = (code << 4) | static_cast<uint32_t>(digit);
+            _pos++;
+        }
+        return true;
+    }
+
+    bool parseString(std::string& out) {
+        out.clear();
+        if (!expect('"')) {
+            return false;
+        }
+        while (_pos < _text.size() && _text[_pos] != '"') {
+            char c = _text[_pos++];
+            if (c != '\\') {
+                out += c;
+                continue;
+            }
+            c = peek();
+            _pos++;
+            switch (c) {
+                case '"': case '\\': case '/': out += c; break;
+                case 'b': out += '\b'; break;
+                case 'f': out += '\f'; break;
+                case 'n': out += '\n'; break;
+                case 'r': out += '\r'; break;
+                case 't': out += '\t'; break;
+                case 'u': {
+                    uint32_t code;
+                    if (!parseHex4(code)) {
+                        return false;
+                    }
+                    // A surrogate pair encodes one code point above U+FFFF
+                    if (code >= 0xD800 && code < 0xDC00 && peek() == '\\' && _pos + 1 < _text.size() &&
+                        _text[_pos + 1] == 'u') {
+                        _pos += 2;
+                        uint32_t low;
+                        if (!parseHex4(low)) {
+                            return false;
+                        }
+                        code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                    }
+                    appendUtf8(out, code);
+                    break;
+                }
+                default:
+                    return fail("bad escape in string");
+            }
+        }
+        if (_pos >= _text.size()) {
+            return fail("unterminated string");
+        }
+        _pos++;
+        return true;
+    }
+
+    /// Skip a value of any type; members the tool does not use may hold anything
+    bool skipValue(int depth) {
+        skipSpace();
+        const char c = peek();
+        if (depth > 64) {
+            return fail("nested too deeply");
+        }
+        if (c == '"') {
+            std::string ignored;
+            return parseString(ignored);
+        }
+        if (c == '[' || c == '{') {
+            const char close = (c == '[') ? ']' : '}';
+            _pos++;
+            skipSpace();
+            if (peek() == close) {
+                _pos++;
+                return true;
+            }
+            for (;;) {
+                if (c == '{') {
+                    std::string key;
+                    if (!parseString(key) || !expect(':')) {
+                        return false;
+                    }
+                }
+                if (!skipValue(depth + 1)) {
+                    return false;
+                }
+                skipSpace();
+                if (peek() != ',') {
+                    break;
+                }
+                _pos++;
+                skipSpace();
+            }
+            return expect(close);
+        }
+        // Numbers, true, false, null
+        const size_t start = _pos;
+        while (_pos < _text.size() && strchr(",]} \t\r\n", _text[_pos]) == nullptr) {
+            _pos++;
+        }
+        return (_pos > start) ? true : fail("expected a value");
+    }
+
+    bool readArray(std::vector<Credential>& creds) {
+        std::set<std::string> names;
+        if (!expect('[')) {
+            return false;
+        }
+        skipSpace();
+        if (peek() == ']') {
+            _pos++;
+            return true;
+        }
+        for (;;) {
+            skipSpace();
+            const std::string where = _source + ":" + std::to_string(line());
+            std::string fields[3];
+            bool present[3] = {false, false, false};
+            if (!expect('{')) {
+                return false;
+            }
+            skipSpace();
+            while (peek() != '}') {
+                std::string key;
+                if (!parseString(key) || !expect(':')) {
+                    return false;
+                }
+                skipSpace();
+                const int field = (key == "name") ? 0 : (key == "ssid") ? 1 : (key == "password") ? 2 : -1;
+                if (field >= 0 && peek() == '"') {
+                    if (!parseString(fields[field])) {
+                        return false;
+                    }
+                    present[field] = true;
+                } else if (field >= 0) {
+                    return fail("name, ssid and password must be strings");
+                } else if (!skipValue(0)) {
+                    return false;
+                }
+                skipSpace();
+                if (peek() == ',') {
+                    _pos++;
+                    skipSpace();
+                } else if (peek() != '}') {
+                    return fail("expected ',' or '}'");
+                }
+            }
+            _pos++;
+            if (!present[0] || !present[1]) {
+                std::cerr << where << ": expected \"name\" and \"ssid\"\n";
+                return false;
+            }
+            if (!addCredential(where, fields[0], fields[1], fields[2], names, creds)) {
+                return false;
+            }
+            skipSpace();
+            if (peek() == ',') {
+                _pos++;
+            } else {
+                return expect(']');
+            }
+        }
+    }
+};
+
+/**
+ * @brief Parse a YAML scalar: plain, 'single-quoted' or "double-quoted"
+ * @return false if a quoted scalar is not closed
+ */
+bool parseYamlScalar(const std::string& text, std::string& value) {
+    value.clear();
+    if (!text.empty() && text[0] == '\'') {
+        for (size_t i = 1; i < text.size(); i++) {
+            if (text[i] == '\'' && i + 1 < text.size() && text[i + 1] == '\'') {
+                value += '\'';
+                i++;
+            } else if (text[i] == '\'') {
+                return true;
+            } else {
+                value += text[i];
+            }
+        }
+        return false;
+    }
+    if (!text.empty() && text[0] == '"') {
+        for (size_t i = 1; i < text.size(); i++) {
+            if (text[i] == '\\' && i + 1 < text.size()) {
+                const char c = text[++i];
+                value += (c == 'n') ? '\n' : (c == 't') ? '\t' : c;
+            } else if (text[i] == '"') {
+                return true;
+            } else {
+                value += text[i];
+            }
+        }
+        return false;
+    }
+    // Plain scalars end at a comment
+    size_t end = text.find(" #");
+    value = text.substr(0, end);
+    value.erase(value.find_last_not_of(" \t\r") + 1);
+    return true;
+}
+
+/**
+ * @brief Read the YAML subset written by typical inventory tools
+ *
+ * A sequence of mappings, optionally under a top-level "networks:" key:
+ * @code
+ * networks:
+ *   - name: home
+ *     ssid: MyHomeWiFi
+ *     password: "secret # not a comment"
+ * @endcode
+ */
+bool readYaml(std::istream& in, const std::string& source, std::vector<Credential>& creds) {
+    std::string line;
+    std::set<std::string> names;
+    size_t lineNumber = 0;
+    std::string where;
+    std::string fields[3];
+    bool present[3] = {false, false, false};
+    bool open = false;
+
+    auto finish = [&]() {
+        if (!open) {
+            return true;
+        }
+        open = false;
+        if (!present[0] || !present[1]) {
+            std::cerr << where << ": expected name and ssid\n";
+            return false;
+        }
+        return addCredential(where, fields[0], fields[1], fields[2], names, creds);
+    };
+
+    while (std::getline(in, line)) {
+        lineNumber++;
+        size_t start = line.find_first_not_of(" \t\r");
+        if (start == std::string::npos || line[start] == '#' || line.compare(start, 3, "---") == 0) {
+            continue;
+        }
+        if (line.compare(start, 2, "- ") == 0 || line.compare(start, 2, "-") == 0) {
+            if (!finish()) {
+                return false;
+            }
+            open = true;
+            where = source + ":" + std::to_string(lineNumber);
+            for (int i = 0; i < 3; i++) {
+                fields[i].clear();
+                present[i] = false;
+            }
+            start = line.find_first_not_of(" \t\r", start + 1);
+            if (start == std::string::npos) {
+                continue;
+            }
+        }
+        const size_t colon = line.find(':', start);
+        if (colon == std::string::npos) {
+            std::cerr << source << ":" << lineNumber << ": expected key: value\n";
+            return false;
+        }
+        std::string key = line.substr(start, colon - start);
+        key.erase(key.find_last_not_of(" \t") + 1);
+        const size_t valueStart = line.find_first_not_of(" \t\r", colon + 1);
+        const std::string rest = (valueStart == std::string::npos) ? std::string() : line.substr(valueStart);
+        if (!open) {
+            // Top-level key holding the list, such as "networks:"
+            if (!rest.empty() && rest[0] != '#') {
+                std::cerr << source << ":" << lineNumber << ": expected a list of networks\n";
+                return false;
+            }
+            continue;
+        }
+        const int field = (key == "name") ? 0 : (key == "ssid") ? 1 : (key == "password") ? 2 : -1;
+        if (field < 0) {
+            continue;
+        }
+        if (!parseYamlScalar(rest, fields[field])) {
+            std::cerr << source << ":" << lineNumber << ": unterminated quoted value\n";
+            return false;
+        }
+        present[field] = true;
+    }
+    return finish();
+}
+
+// ===== HASH INDEX =====
+
+// Must match src/WiFiCredsIndex.h
+const uint16_t EMPTY_SLOT = 0xFFFF;
+const uint32_t MAX_SEED = 1U << 16;
+
+/// The library's hash, so the written index always matches the one the library checks
+uint32_t hashName(const std::string& s, uint32_t seed) {
+    return WiFiCredsIndex::hashName(s.c_str(), seed);
+}
+
+size_t tableSizeFor(size_t n) {
+    size_t size = 1;
+    while (size < n) {
+        size <<= 1;
+    }
+    return size;
+}
+
+/// Contents of WiFiCredsIndex::NameIndex and WiFiCredsIndex::SsidIndex
+struct HashIndex {
+    std::vector<int32_t> displacement;
+    std::vector<uint16_t> nameSlots;
+    std::vector<uint16_t> ssidSlots;
+    std::vector<uint16_t> ssidTags;
+};
+
+/**
+ * @brief Build the name and SSID indexes the way WiFiCredsIndex.h builds them at compile time
+ * @return false if there are too many sets or no displacement seed was found
+ */
+bool buildIndex(const std::vector<Credential>& creds, HashIndex& index) {
+    if (creds.size() >= EMPTY_SLOT) {
+        return false;
+    }
+    const size_t m = tableSizeFor(creds.size());
+    index.displacement.assign(m, 0);
+    index.nameSlots.assign(m, EMPTY_SLOT);
+
+    std::vector<std::vector<uint16_t>> buckets(m);
+    for (size_t i = 0; i < creds.size(); i++) {
+        buckets[hashName(creds[i].name, 0) & (m - 1)].push_back(static_cast<uint16_t>(i));
+    }
+
+    // Multi-name buckets, largest first, each with the first seed that places all of its names
+    std::vector<size_t> order;
+    for (size_t b = 0; b < m; b++) {
+        if (buckets[b].size() >= 2) {
+            order.push_back(b);
+        }
+    }
+    std::stable_sort(order.begin(), order.end(),
+                     [&buckets](size_t a, size_t b) { return buckets[a].size() > buckets[b].size(); });
+
+    std::vector<bool> taken(m, false);
+    std::vector<size_t> slots;
+    for (size_t b : order) {
+        const std::vector<uint16_t>& members = buckets[b];
+        uint32_t seed = 1;
+        for (;; seed++) {
+            if (seed > MAX_SEED) {
+                return false;
+            }
+            slots.clear();
+            bool fits = true;
+            for (size_t k = 0; k < members.size() && fits; k++) {
+                const size_t slot = hashName(creds[members[k]].name, seed) & (m - 1);
+                fits = !taken[slot] && std::find(slots.begin(), slots.end(), slot) == slots.end();
+                slots.push_back(slot);
+            }
+            if (fits) {
+                break;
+            }
+        }
+        for (size_t k = 0; k < members.size(); k++) {
+            taken[slots[k]] = true;
+            index.nameSlots[slots[k]] = members[k];
+        }
+        index.displacement[b] = static_cast<int32_t>(seed);
+    }
+
+    // Single-name buckets take the free slots in order
+    size_t nextFree = 0;
+    for (size_t b = 0; b < m; b++) {
+        if (buckets[b].size() != 1) {
+            continue;
+        }
+        while (taken[nextFree]) {
+            nextFree++;
+        }
+        taken[nextFree] = true;
+        index.nameSlots[nextFree] = buckets[b][0];
+        index.displacement[b] = -static_cast<int32_t>(nextFree + 1);
+    }
+
+    // SSIDs: linear probing in a table at most half full
+    const size_t ssidSize = tableSizeFor(creds.size() * 2);
+    index.ssidSlots.assign(ssidSize, EMPTY_SLOT);
+    index.ssidTags.assign(ssidSize, 0);
+    for (size_t i = 0; i < creds.size(); i++) {
+        if (creds[i].ssid.empty()) {
+            continue;
+        }
+        const uint32_t hash = hashName(creds[i].ssid, 0);
+        size_t slot = hash & (ssidSize - 1);
+        while (index.ssidSlots[slot] != EMPTY_SLOT) {
+            slot = (slot + 1) & (ssidSize - 1);
+        }
+        index.ssidSlots[slot] = static_cast<uint16_t>(i);
+        index.ssidTags[slot] = static_cast<uint16_t>(hash >> 16);
+    }
+    return true;
+}
+
+// ===== PMK CACHE =====
+
+/// SHA-1 of a short message, used to key the cache without storing passwords
+void sha1Bytes(const std::string& data, uint8_t out[20]) {
+    uint32_t state[5];
+    sha1Init(state);
+    std::string message = data;
+    message += static_cast<char>(0x80);
+    while (message.size() % 64 != 56) {
+        message += '\0';
+    }
+    const uint64_t bits = static_cast<uint64_t>(data.size()) * 8;
+    for (int i = 7; i >= 0; i--) {
+        message += static_cast<char>(bits >> (i * 8));
+    }
+    for (size_t offset = 0; offset < message.size(); offset += 64) {
+        sha1CompressBytes(state, reinterpret_cast<const uint8_t*>(message.data() + offset));
+    }
+    digestBytes(state, out);
+}
+
+std::string toHex(const uint8_t* data, size_t length) {
+    static const char digits[] = "0123456789abcdef";
+    std::string hex;
+    for (size_t i = 0; i < length; i++) {
+        hex += digits[data[i] >> 4];
+        hex += digits[data[i] & 15];
+    }
+    return hex;
+}
+
+std::string cacheKey(const Credential& cred) {
+    uint8_t digest[20];
+    sha1Bytes(cred.ssid + '\0' + cred.password, digest);
+    return toHex(digest, sizeof(digest));
+}
+
+/**
+ * @brief PMKs from earlier runs, keyed by SHA-1 of SSID and password
+ *
+ * One line per PMK: 40 hex digits of key, a space, 64 hex digits of PMK.
+ */
+typedef std::map<std::string, std::string> PmkCache;
+
+void loadPmkCache(const std::string& path, PmkCache& cache) {
+    std::ifstream in(path);
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.size() == 40 + 1 + PMK_LENGTH * 2 && line[40] == ' ') {
+            cache[line.substr(0, 40)] = line.substr(41);
+        }
+    }
+}
+
+/**
+ * @brief Take every PMK the cache holds for @p creds
+ * @return size_t Number of sets served from the cache
+ */
+size_t applyPmkCache(std::vector<Credential>& creds, const PmkCache& cache) {
+    size_t hits = 0;
+    std::vector<uint8_t> pmk;
+    for (Credential& cred : creds) {
+        if (!isWpaPassphrase(cred)) {
+            continue;
+        }
+        auto found = cache.find(cacheKey(cred));
+        if (found != cache.end() && parseHexBytes(found->second, pmk) && pmk.size() == PMK_LENGTH) {
+            memcpy(cred.pmk, pmk.data(), PMK_LENGTH);
+            cred.hasPmk = true;
+            hits++;
+        }
+    }
+    return hits;
+}
+
+/// Rewrite the cache with the PMKs of the current list only, so it does not grow forever
+bool savePmkCache(const std::string& path, const std::vector<Credential>& creds) {
+    std::ostringstream text;
+    text << "# credgen PMK cache: SHA-1(ssid NUL password) PMK. As sensitive as the passwords.\n";
+    for (const Credential& cred : creds) {
+        if (cred.hasPmk && isWpaPassphrase(cred)) {
+            text << cacheKey(cred) << ' ' << toHex(cred.pmk, PMK_LENGTH) << '\n';
+        }
+    }
+    const std::string temporary = path + ".tmp";
+    std::ofstream out(temporary, std::ios::binary);
+    out << text.str();
+    out.close();
+    if (!out || std::rename(temporary.c_str(), path.c_str()) != 0) {
+        std::remove(temporary.c_str());
+        return false;
+    }
+    return true;
+}
+
+// ===== OUTPUT =====
+
+/// C string literal; octal escapes cannot run into following digits
+std::string quote(const std::string& s) {
+    std::string out = "\"";
+    char buffer[8];
+    for (unsigned char c : s) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += static_cast<char>(c);
+        } else if (c < 0x20 || c >= 0x7F || c == '?') {
+            snprintf(buffer, sizeof(buffer), "\\%03o", c);
+            out += buffer;
+        } else {
+            out += static_cast<char>(c);
+        }
+    }
+    return out + "\"";
+}
+
+/**
+ * @brief Order sets for credentials.h: the default (first input line) stays
+ *        first, the others are sorted by name in strcmp order
+ */
+void sortForHeader(std::vector<Credential>& creds) {
+    if (creds.size() > 2) {
+        std::sort(creds.begin() + 1, creds.end(),
+                  [](const Credential& a, const Credential& b) { return a.name < b.name; });
+    }
+}
+
+/// Emit a table as comma-separated numbers, 16 per line
+template <typename T>
+void writeNumbers(std::ostream& out, const std::vector<T>& values) {
+    for (size_t i = 0; i < values.size(); i++) {
+        out << ((i % 16 == 0) ? (i == 0 ? "\n        " : ",\n        ") : ", ") << static_cast<long>(values[i]);
+    }
+}
+
+void writeHeader(std::ostream& out, const std::vector<Credential>& creds, const HashIndex* index) {
+    out << "/**\n"
+           " * @file credentials.h\n"
+           " * @brief Wi-Fi credentials configuration file\n"
+           " *\n"
+           " * Generated by extras/credgen. Do not edit by hand; regenerate instead.\n"
+           " *\n"
+           " * IMPORTANT: Never commit this file to version control!\n"
+           " *\n"
+           " * NOTE: The first credential set is always used as the default.\n"
+           " * The other sets are sorted by name.\n"
+           " */\n\n"
+           "#ifndef CREDENTIALS_H\n"
+           "#define CREDENTIALS_H\n\n"
+           "#include \"WiFiCredsIndex.h\"\n\n"
+           "// Names after the first are sorted, so lookups without the hash index binary search\n"
+           "#define WIFICREDS_SORTED_NAMES 1\n\n";
+
+    // SSIDs and passwords shared by several sets are emitted once and referenced by name
+    std::map<std::string, size_t> uses;
+    for (const Credential& cred : creds) {
+        uses[cred.ssid]++;
+        if (cred.sealed.empty()) {
+            uses[cred.password]++;
+        }
+    }
+    std::map<std::string, std::string> pool;
+    for (const auto& entry : uses) {
+        if (entry.second > 1 && !entry.first.empty()) {
+            if (pool.empty()) {
+                out << "// Strings shared by several sets, stored once\n";
+            }
+            std::string id = "CREDENTIAL_STR_" + std::to_string(pool.size());
+            out << "constexpr char " << id << "[] = " << quote(entry.first) << ";\n";
+            pool[entry.first] = id;
+        }
+    }
+    if (!pool.empty()) {
+        out << "\n";
+    }
+    auto text = [&pool](const std::string& s) {
+        auto found = pool.find(s);
+        return (found != pool.end()) ? found->second : quote(s);
+    };
+
+    char hex[8];
+    bool anyPmk = false;
+    for (size_t i = 0; i < creds.size(); i++) {
+        if (!creds[i].hasPmk) {
+            continue;
+        }
+        if (!anyPmk) {
+            out << "// Precomputed WPA2 PMKs (PBKDF2-HMAC-SHA1, 4096 iterations)\n";
+            anyPmk = true;
+        }
+        out << "constexpr uint8_t CREDENTIAL_PMK_" << i << "[" << PMK_LENGTH << "] = {";
+        for (size_t b = 0; b < PMK_LENGTH; b++) {
+            snprintf(hex, sizeof(hex), "0x%02x", creds[i].pmk[b]);
+            out << (b == 0 ? "" : ", ") << hex;
+        }
+        out << "};\n";
+    }
+    if (anyPmk) {
+        out << "\n";
+    }
+
+    bool anySealed = false;
+    for (size_t i = 0; i < creds.size(); i++) {
+        if (creds[i].sealed.empty()) {
+            continue;
+        }
+        if (!anySealed) {
+            out << "// Sealed passwords: 12-byte nonce, then the ChaCha20 ciphertext (see WiFiCredsCipher.h)\n";
+            anySealed = true;
+        }
+        out << "constexpr char CREDENTIAL_SEALED_" << i << "[] = " << quote(creds[i].sealed) << ";\n";
+    }
+    if (anySealed) {
+        out << "\n";
+    }
+
+    out << "// Multiple credential sets\n"
+           "constexpr CredentialSet CREDENTIAL_SETS[] = {\n"
+           "    // First set is always the default\n";
+    for (size_t i = 0; i < creds.size(); i++) {
+        const Credential& cred = creds[i];
+        if (!cred.sealed.empty()) {
+            out << "    WIFICREDS_SET_SEALED(" << quote(cred.name) << ", " << text(cred.ssid)
+                << ", CREDENTIAL_SEALED_" << i << "),\n";
+        } else if (cred.hasPmk) {
+            out << "    WIFICREDS_SET_PMK(" << quote(cred.name) << ", " << text(cred.ssid) << ", "
+                << text(cred.password) << ", CREDENTIAL_PMK_" << i << "),\n";
+        } else {
+            out << "    WIFICREDS_SET(" << quote(cred.name) << ", " << text(cred.ssid) << ", "
+                << text(cred.password) << "),\n";
+        }
+    }
+    out << "    // Terminator entry - must be last!\n"
+           "    WIFICREDS_TERMINATOR\n"
+           "};\n\n";
+
+    if (index != nullptr) {
+        out << "#if WIFICREDS_HAS_NAME_INDEX\n"
+               "// Name and SSID hash tables (see WiFiCredsIndex.h), so the compiler does not build them\n"
+               "#define WIFICREDS_PRECOMPUTED_INDEX 1\n\n"
+               "constexpr WiFiCredsIndex::NameIndex<" << index->displacement.size() << "> CREDENTIAL_NAME_INDEX = {\n"
+               "    {";
+        writeNumbers(out, index->displacement);
+        out << "},\n    {";
+        writeNumbers(out, index->nameSlots);
+        out << "}};\n\n"
+               "constexpr WiFiCredsIndex::SsidIndex<" << index->ssidSlots.size() << "> CREDENTIAL_SSID_INDEX = {\n"
+               "    {";
+        writeNumbers(out, index->ssidSlots);
+        out << "},\n    {";
+        writeNumbers(out, index->ssidTags);
+        out << "}};\n"
+               "#endif\n\n";
+    }
+
+    out << "#endif // CREDENTIALS_H\n";
+}
+
+// ===== BLOB OUTPUT =====
+
+uint32_t crc32(const uint8_t* data, size_t length) {
+    uint32_t crc = 0xFFFFFFFFU;
+    for (size_t i = 0; i < length; i++) {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (0xEDB88320U & (0U - (crc & 1U)));
+        }
+    }
+    return ~crc;
+}
+
+void putU16(std::vector<uint8_t>& blob, size_t at, size_t value) {
+    blob[at] = static_cast<uint8_t>(value);
+    blob[at + 1] = static_cast<uint8_t>(value >> 8);
+}
+
+void putU32(std::vector<uint8_t>& blob, size_t at, uint32_t value) {
+    putU16(blob, at, value & 0xFFFF);
+    putU16(blob, at + 2, value >> 16);
+}
+
+/**
+ * @brief Pack credentials into the blob format read by WiFiCredsBlob
+ *
+ * Records are sorted by name (byte order, as strcmp) so the device can
+ * binary search; the first input line stays the default set.
+ *
+ * @return false if the credentials do not fit the format
+ */
+bool buildBlob(const std::vector<Credential>& creds, std::vector<uint8_t>& blob) {
+    if (creds.size() > 0xFFFF) {
+        std::cerr << "credgen: a blob holds at most 65535 credential sets\n";
+        return false;
+    }
+
+    std::vector<size_t> order(creds.size());
+    for (size_t i = 0; i < order.size(); i++) {
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return creds[a].name < creds[b].name; });
+
+    blob.assign(BLOB_HEADER_SIZE + creds.size() * 2, 0);
+    memcpy(blob.data(), "WCB1", 4);
+    putU16(blob, 4, BLOB_VERSION);
+    putU16(blob, 6, creds.size());
+
+    for (size_t rank = 0; rank < order.size(); rank++) {
+        const Credential& cred = creds[order[rank]];
+        if (cred.name.size() > 255 || cred.name.find('\0') != std::string::npos) {
+            std::cerr << "credgen: name '" << cred.name << "' does not fit a blob record\n";
+            return false;
+        }
+        if (order[rank] == 0) {
+            putU16(blob, 8, rank);
+        }
+
+        blob.resize((blob.size() + BLOB_ALIGNMENT - 1) / BLOB_ALIGNMENT * BLOB_ALIGNMENT, 0);
+        const size_t offset = blob.size();
+        if (offset / BLOB_ALIGNMENT > 0xFFFF) {
+            std::cerr << "credgen: blob exceeds " << (0x10000 * BLOB_ALIGNMENT / 1024) << " KB\n";
+            return false;
+        }
+        putU16(blob, BLOB_HEADER_SIZE + rank * 2, offset / BLOB_ALIGNMENT);
+
+        blob.push_back(static_cast<uint8_t>(cred.name.size()));
+        blob.push_back(static_cast<uint8_t>(cred.ssid.size()));
+        blob.push_back(static_cast<uint8_t>(cred.password.size()));
+        blob.push_back(cred.hasPmk ? BLOB_RECORD_PMK : 0);
+        for (const std::string* s : {&cred.name, &cred.ssid, &cred.password}) {
+            blob.insert(blob.end(), s->begin(), s->end());
+            blob.push_back(0);
+        }
+        if (cred.hasPmk) {
+            blob.insert(blob.end(), cred.pmk, cred.pmk + PMK_LENGTH);
+        }
+    }
+
+    putU32(blob, 12, static_cast<uint32_t>(blob.size()));
+    putU32(blob, 16, crc32(blob.data() + BLOB_HEADER_SIZE, blob.size() - BLOB_HEADER_SIZE));
+    return true;
+}
+
+/**
+ * @brief Bytes the same credentials take as a CREDENTIAL_SETS table
+ *
+ * Assumes 32-bit pointers: a 16-byte CredentialSet (name, ssid, password,
+ * pmk pointers) per set plus the terminator, and every string and PMK stored
+ * once.
+ */
+size_t tableSize(const std::vector<Credential>& creds) {
+    size_t size = (creds.size() + 1) * 16;
+    for (const Credential& cred : creds) {
+        size += cred.name.size() + 1 + cred.ssid.size() + 1 + cred.password.size() + 1;
+        if (cred.hasPmk) {
+            size += PMK_LENGTH;
+        }
+    }
+    return size;
+}
+
+void writeBlobHeader(std::ostream& out, const std::vector<uint8_t>& blob) {
+    out << "/**\n"
+           " * @file credentials_blob.h\n"
+           " * @brief Packed Wi-Fi credential blob, read with WiFiCredsBlob\n"
+           " *\n"
+           " * Generated by extras/credgen. Do not edit by hand; regenerate instead.\n"
+           " *\n"
+           " * IMPORTANT: Never commit this file to version control!\n"
+           " */\n\n"
+           "#ifndef CREDENTIALS_BLOB_H\n"
+           "#define CREDENTIALS_BLOB_H\n\n"
+           "#include <stdint.h>\n\n"
+           "alignas(4) const uint8_t CREDENTIAL_BLOB["
+        << blob.size() << "] = {";
+    char hex[8];
+    for (size_t i = 0; i < blob.size(); i++) {
+        snprintf(hex, sizeof(hex), "0x%02x", blob[i]);
+        out << (i % 16 == 0 ? "\n    " : " ") << hex << ",";
+    }
+    out << "\n};\n\n"
+           "#endif // CREDENTIALS_BLOB_H\n";
+}
+
+// ===== BENCHMARK =====
+
+int runBenchmark(size_t count, unsigned threads) {
+    std::vector<Credential> creds(count);
+    for (size_t i = 0; i < count; i++) {
+        creds[i].name = "bench" + std::to_string(i);
+        creds[i].ssid = "BenchNetwork-" + std::to_string(i % 97);
+        creds[i].password = "passphrase-" + std::to_string(i * 2654435761U);
+    }
+
+    const bool modes[] = {false, true};
+    for (bool simd : modes) {
+        if (simd && Simd::LANES == 1) {
+            continue;
+        }
+        std::vector<Credential> work = creds;
+        auto start = std::chrono::steady_clock::now();
+        derivePmks(work, threads, simd);
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        printf("%-6s lanes=%zu threads=%u pmks=%zu seconds=%.3f pmks_per_second=%.0f\n",
+               simd ? CREDGEN_SIMD_NAME : "scalar", simd ? Simd::LANES : size_t(1), threads, count,
+               elapsed.count(), count / elapsed.count());
+    }
+    return 0;
+}
+
+/// csv, json or yaml from the file extension, csv if there is none
+std::string inputFormatOf(const std::string& path) {
+    const size_t dot = path.rfind('.');
+    std::string extension = (dot == std::string::npos) ? std::string() : path.substr(dot + 1);
+    std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+    if (extension == "json") {
+        return "json";
+    }
+    if (extension == "yaml" || extension == "yml") {
+        return "yaml";
+    }
+    return "csv";
+}
+
+bool readInput(std::istream& in, const std::string& source, const std::string& format,
+               std::vector<Credential>& creds) {
+    if (format == "json") {
+        std::stringstream text;
+        text << in.rdbuf();
+        const std::string contents = text.str();
+        JsonReader reader(contents, source);
+        return reader.read(creds);
+    }
+    if (format == "yaml") {
+        return readYaml(in, source, creds);
+    }
+    return readCsv(in, source, creds);
+}
+
+void usage() {
+    std::cerr << "usage: credgen [-o output] [-j threads] [--scalar] [--format header|blob|blob-header]\n"
+                 "               [--input csv|json|yaml] [--cache file | --no-cache]\n"
+                 "               [--key hex [--device-id hex]] input\n"
+                 "       credgen --bench count [-j threads]\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string inputPath;
+    std::string outputPath;
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    bool useSimd = true;
+    size_t benchCount = 0;
+    std::string format = "header";
+    std::string keyHex;
+    std::string deviceIdHex;
+    std::string inputFormat;
+    std::string cachePath;
+    bool useCache = true;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "-o" && i + 1 < argc) {
+            outputPath = argv[++i];
+        } else if (arg == "-j" && i + 1 < argc) {
+            threads = std::max(1, atoi(argv[++i]));
+        } else if (arg == "--scalar") {
+            useSimd = false;
+        } else if (arg == "--format" && i + 1 < argc) {
+            format = argv[++i];
+            if (format != "header" && format != "blob" && format != "blob-header") {
+                usage();
+                return 2;
+            }
+        } else if (arg == "--input" && i + 1 < argc) {
+            inputFormat = argv[++i];
+            if (inputFormat != "csv" && inputFormat != "json" && inputFormat != "yaml") {
+                usage();
+                return 2;
+            }
+        } else if (arg == "--cache" && i + 1 < argc) {
+            cachePath = argv[++i];
+        } else if (arg == "--no-cache") {
+            useCache = false;
+        } else if (arg == "--key" && i + 1 < argc) {
+            keyHex = argv[++i];
+        } else if (arg == "--device-id" && i + 1 < argc) {
+            deviceIdHex = argv[++i];
+        } else if (arg == "--bench" && i + 1 < argc) {
+            benchCount = static_cast<size_t>(strtoull(argv[++i], nullptr, 10));
+        } else if (arg == "-h" || arg == "--help") {
+            usage();
+            return 0;
+        } else if (!arg.empty() && arg[0] != '-' && inputPath.empty()) {
+            inputPath = arg;
+        } else {
+            usage();
+            return 2;
+        }
+    }
+
+    if (benchCount > 0) {
+        return runBenchmark(benchCount, threads);
+    }
+    if (inputPath.empty()) {
+        usage();
+        return 2;
+    }
+
+    const auto started = std::chrono::steady_clock::now();
+    std::ifstream in(inputPath);
+    if (!in) {
+        std::cerr << "credgen: cannot open " << inputPath << "\n";
+        return 1;
+    }
+    std::vector<Credential> creds;
+    if (!readInput(in, inputPath, inputFormat.empty() ? inputFormatOf(inputPath) : inputFormat, creds)) {
+        return 1;
+    }
+    if (creds.empty()) {
+        std::cerr << "credgen: " << inputPath << " holds no credential sets\n";
+        return 1;
+    }
+
+    // PBKDF2 dominates the run time; PMKs of unchanged SSID/password pairs
+    // come from the cache of the previous run
+    if (cachePath.empty() && !outputPath.empty()) {
+        cachePath = outputPath + ".pmkcache";
+    }
+    useCache = useCache && !cachePath.empty() && keyHex.empty();
+    size_t cached = 0;
+    size_t derived = 0;
+    if (keyHex.empty()) {
+        PmkCache cache;
+        if (useCache) {
+            loadPmkCache(cachePath, cache);
+            cached = applyPmkCache(creds, cache);
+        }
+        for (const Credential& cred : creds) {
+            derived += (!cred.hasPmk && isWpaPassphrase(cred)) ? 1 : 0;
+        }
+        derivePmks(creds, threads, useSimd);
+        // Rewritten when PMKs were added or entries went stale
+        const bool cacheChanged = derived > 0 || cache.size() != cached;
+        if (useCache && cacheChanged && !savePmkCache(cachePath, creds)) {
+            std::cerr << "credgen: cannot write " << cachePath << "\n";
+        }
+    } else {
+        std::vector<uint8_t> key;
+        std::vector<uint8_t> deviceId;
+        if (!parseHexBytes(keyHex, key) || key.size() != KEY_LENGTH ||
+            !parseHexBytes(deviceIdHex, deviceId) || deviceId.size() > NONCE_LENGTH) {
+            std::cerr << "credgen: --key needs 64 hex digits, --device-id at most 24\n";
+            return 2;
+        }
+        if (format != "header") {
+            std::cerr << "credgen: --key only applies to --format header\n";
+            return 2;
+        }
+        if (!deviceId.empty()) {
+            deriveDeviceKey(key.data(), deviceId, key.data());
+        }
+        if (!sealPasswords(creds, key.data())) {
+            return 1;
+        }
+    }
+
+    std::ostringstream header;
+    if (format == "header") {
+        // Sorted names give a binary search everywhere; the hash index is
+        // checked by the library at compile time instead of being built there
+        sortForHeader(creds);
+        HashIndex index;
+        const bool indexed = buildIndex(creds, index);
+        if (!indexed) {
+            std::cerr << "credgen: no hash index for " << creds.size() << " sets, lookups use binary search\n";
+        }
+        writeHeader(header, creds, indexed ? &index : nullptr);
+        if (creds.size() > 1000) {
+            std::cerr << "credgen: " << creds.size() << " sets, compile with -DWIFICREDS_MAX_CREDENTIALS="
+                      << creds.size() << " or more\n";
+        }
+    } else {
+        std::vector<uint8_t> blob;
+        if (!buildBlob(creds, blob)) {
+            return 1;
+        }
+        if (format == "blob") {
+            header.write(reinterpret_cast<const char*>(blob.data()), static_cast<std::streamsize>(blob.size()));
+        } else {
+            writeBlobHeader(header, blob);
+        }
+        const size_t table = tableSize(creds);
+        std::cerr << "credgen: " << creds.size() << " sets, blob " << blob.size() << " bytes, table "
+                  << table << " bytes (" << (table > blob.size() ? table - blob.size() : 0) << " bytes saved)\n";
+    }
+    const double seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    std::cerr << "credgen: " << creds.size() << " sets, " << derived << " PMKs derived, " << cached
+              << " from cache, " << seconds << " s\n";
+
+    if (outputPath.empty()) {
+        std::cout << header.str();
+    } else {
+        // Leave an unchanged file alone so the build does not recompile against it
+        std::ifstream previous(outputPath, std::ios::binary);
+        std::stringstream previousText;
+        previousText << previous.rdbuf();
+        if (previous && previousText.str() == header.str()) {
+            std::cerr << "credgen: " << outputPath << " is up to date\n";
+            return 0;
+        }
+        // Write next to the target and rename over it, so a process mapping
+        // the file (WiFiCredsMappedBlob) never sees a partial file
+        previous.close();
+        const std::string temporary = outputPath + ".tmp";
+        std::ofstream out(temporary, std::ios::binary);
+        out << header.str();
+        out.close();
+        if (!out || std::rename(temporary.c_str(), outputPath.c_str()) != 0) {
+            std::remove(temporary.c_str());
+            std::cerr << "credgen: cannot write " << outputPath << "\n";
+            return 1;
+        }
+    }
+    return 0;
+}
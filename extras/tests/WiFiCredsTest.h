@@ -0,0 +1,53 @@
+/**
+ * @file WiFiCredsTest.h
+ * @brief Minimal check macro shared by the host tests
+ * @author Rithik Krisna M
+ * @version 1.0.4
+ * @date 2025
+ *
+ * Each test is a plain program built by the Makefile next to this file.
+ * CHECK() reports a failed condition with its location and carries on, and
+ * main() returns WiFiCredsTest::result(), which is non-zero after any
+ * failure so `make test` stops there.
+ */
+
+#ifndef WIFICREDS_TEST_H
+#define WIFICREDS_TEST_H
+
+#include <stdio.h>
+
+namespace WiFiCredsTest {
+
+inline unsigned& checks() {
+    static unsigned count = 0;
+    return count;
+}
+
+inline unsigned& failures() {
+    static unsigned count = 0;
+    return count;
+}
+
+inline bool check(bool ok, const char* condition, const char* file, int line) {
+    checks()++;
+    if (!ok) {
+        failures()++;
+        printf("%s:%d: CHECK(%s) failed\n", file, line, condition);
+    }
+    return ok;
+}
+
+/**
+ * @brief Print the summary of a test program
+ * @return int Exit code for main(): 0 if every check passed
+ */
+inline int result(const char* name) {
+    printf("%s: %u checks, %u failed\n", name, checks(), failures());
+    return (failures() == 0) ? 0 : 1;
+}
+
+} // namespace WiFiCredsTest
+
+#define CHECK(condition) WiFiCredsTest::check((condition), #condition, __FILE__, __LINE__)
+
+#endif // WIFICREDS_TEST_H
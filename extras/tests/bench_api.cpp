@@ -0,0 +1,182 @@
+/**
+ * @file bench_api.cpp
+ * @brief Host benchmark of the public WiFiCreds lookups against generated tables
+ * @author Rithik Krisna M
+ * @version 1.0.4
+ * @date 2025
+ *
+ * bench_lookup.cpp times the name index on its own. This program times what
+ * a sketch calls: getSSID(), getPassword(), isValid(), hasCredential(),
+ * getCredentialName() and getCredentialCount(), linked with the library as
+ * it is compiled for a board. The table is a credentials.h that credgen
+ * wrote, so it is sorted, carries the precomputed index and takes the same
+ * lookup path (index, binary search or scan) as on a device. "make bench-api"
+ * builds one program per table size from 1 to 10000 sets.
+ *
+ * Half of the names are short ("ap-…"), the other half share a 21-character
+ * prefix ("site-warehouse-north-…"), which is the expensive case for strcmp:
+ * - hit: names of the table without the long prefix
+ * - shared_prefix: names of the table with it
+ * - miss: unknown names with the long prefix; name lookups fall back to the default set
+ * - fallback: nullptr, which selects the default set without a lookup
+ * getCredentialName() is timed for valid (hit) and invalid (miss) indexes.
+ *
+ * Output is CSV rows api,distribution,table_size,iterations,ns_per_op, or with
+ * --json one JSON object per row.
+ *
+ * Every result is also checked (each set's SSID is "net-" and its name), so
+ * the program exits non-zero if a lookup returns the wrong set.
+ */
+
+#include <WiFiCreds.h>
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+namespace {
+
+const size_t PROBES = 1024;      // Probes per distribution, cycled through the table
+const double MIN_TIME_MS = 200; // Each measurement repeats the probes at least this long
+const char* const SHARED_PREFIX = "site-warehouse-north-";
+
+volatile size_t sink = 0;
+bool lookupsCorrect = true;
+bool json = false;
+
+void report(const char* api, const char* distribution, size_t lookups, double ns) {
+    const char* format = json ? "{\"api\": \"%s\", \"distribution\": \"%s\", \"table_size\": %zu, "
+                                "\"iterations\": %zu, \"ns_per_op\": %.2f}\n"
+                              : "%s,%s,%zu,%zu,%.2f\n";
+    printf(format, api, distribution, WiFiCreds::getCredentialCount(), lookups, ns / static_cast<double>(lookups));
+}
+
+/**
+ * @brief Time @p call over the probes and report ns per call
+ *
+ * @p call returns a value folded into a sink, so the calls are not optimised
+ * away. Nothing is timed if there are no probes (e.g. no shared prefix names
+ * in a one-set table).
+ */
+template <typename Probe, typename Call>
+void measure(const char* api, const char* distribution, const std::vector<Probe>& probes, Call call) {
+    if (probes.empty()) {
+        return;
+    }
+
+    size_t lookups = 0;
+    double ns = 0;
+    const auto start = std::chrono::steady_clock::now();
+    while (ns < MIN_TIME_MS * 1e6) {
+        for (const Probe& probe : probes) {
+            sink += call(probe);
+        }
+        lookups += probes.size();
+        ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    }
+    report(api, distribution, lookups, ns);
+}
+
+/// Expected SSID of a set; names outside the table expect the default set
+std::string expectedSSID(const char* name) {
+    const bool known = name != nullptr && WiFiCreds::hasCredential(name);
+    return std::string("net-") + (known ? name : WiFiCreds::getDefaultName());
+}
+
+/// Check every probe once before it is timed
+void check(const std::vector<const char*>& probes, bool expectKnown) {
+    for (const char* name : probes) {
+        const char* ssid = WiFiCreds::getSSID(name);
+        const char* password = WiFiCreds::getPassword(name);
+        if (ssid == nullptr || expectedSSID(name) != ssid || password == nullptr ||
+            strlen(password) != WIFICREDS_PSK_HEX_SIZE - 1 || !WiFiCreds::isValid(name) ||
+            (name != nullptr && WiFiCreds::hasCredential(name) != expectKnown)) {
+            lookupsCorrect = false;
+        }
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    json = argc > 1 && strcmp(argv[1], "--json") == 0;
+    const size_t count = WiFiCreds::getCredentialCount();
+
+    // Names are copied out of the table, so hits compare other memory than the stored strings
+    std::vector<std::string> shortNames;
+    std::vector<std::string> prefixedNames;
+    for (size_t i = 0; i < count; i++) {
+        const char* name = WiFiCreds::getCredentialName(i);
+        (strncmp(name, SHARED_PREFIX, strlen(SHARED_PREFIX)) == 0 ? prefixedNames : shortNames).push_back(name);
+    }
+
+    // Probes cycle through the names in a scattered order
+    std::vector<std::string> missNames;
+    std::vector<const char*> hits;
+    std::vector<const char*> shared;
+    std::vector<const char*> misses;
+    std::vector<const char*> fallbacks(PROBES, nullptr);
+    std::vector<size_t> validIndexes;
+    std::vector<size_t> invalidIndexes;
+    for (size_t p = 0; p < PROBES; p++) {
+        missNames.push_back(std::string(SHARED_PREFIX) + "x" + std::to_string(p));
+        validIndexes.push_back((p * 2654435761u) % count);
+        invalidIndexes.push_back(count + p);
+    }
+    for (size_t p = 0; p < PROBES; p++) {
+        if (!shortNames.empty()) {
+            hits.push_back(shortNames[(p * 2654435761u) % shortNames.size()].c_str());
+        }
+        if (!prefixedNames.empty()) {
+            shared.push_back(prefixedNames[(p * 2654435761u) % prefixedNames.size()].c_str());
+        }
+        misses.push_back(missNames[p].c_str());
+    }
+
+    check(hits, true);
+    check(shared, true);
+    check(misses, false);
+    check(fallbacks, true);
+    for (size_t index : validIndexes) {
+        lookupsCorrect = lookupsCorrect && WiFiCreds::getCredentialName(index) != nullptr;
+    }
+    for (size_t index : invalidIndexes) {
+        lookupsCorrect = lookupsCorrect && WiFiCreds::getCredentialName(index) == nullptr;
+    }
+
+    const struct {
+        const char* name;
+        const std::vector<const char*>& probes;
+    } distributions[] = {{"hit", hits}, {"shared_prefix", shared}, {"miss", misses}, {"fallback", fallbacks}};
+
+    for (const auto& distribution : distributions) {
+        measure("getSSID", distribution.name, distribution.probes,
+                [](const char* name) { return reinterpret_cast<size_t>(WiFiCreds::getSSID(name)); });
+    }
+    for (const auto& distribution : distributions) {
+        measure("getPassword", distribution.name, distribution.probes,
+                [](const char* name) { return reinterpret_cast<size_t>(WiFiCreds::getPassword(name)); });
+    }
+    for (const auto& distribution : distributions) {
+        measure("isValid", distribution.name, distribution.probes,
+                [](const char* name) { return static_cast<size_t>(WiFiCreds::isValid(name)); });
+    }
+    // hasCredential(nullptr) returns before any lookup, so it has no fallback row
+    for (size_t i = 0; i < 3; i++) {
+        measure("hasCredential", distributions[i].name, distributions[i].probes,
+                [](const char* name) { return static_cast<size_t>(WiFiCreds::hasCredential(name)); });
+    }
+    measure("getCredentialName", "hit", validIndexes,
+            [](size_t index) { return reinterpret_cast<size_t>(WiFiCreds::getCredentialName(index)); });
+    measure("getCredentialName", "miss", invalidIndexes,
+            [](size_t index) { return reinterpret_cast<size_t>(WiFiCreds::getCredentialName(index)); });
+    measure("getCredentialCount", "hit", validIndexes,
+            [](size_t) { return WiFiCreds::getCredentialCount(); });
+
+    if (!lookupsCorrect) {
+        fprintf(stderr, "ERROR: a lookup returned the wrong result\n");
+        return 1;
+    }
+    return 0;
+}
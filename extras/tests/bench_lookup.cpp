@@ -0,0 +1,137 @@
+/**
+ * @file bench_lookup.cpp
+ * @brief Host benchmark of name lookup: perfect-hash index against a linear scan
+ * @author Rithik Krisna M
+ * @version 1.0.4
+ * @date 2025
+ *
+ * The Benchmark example measures the table in credentials.h on a board.
+ * This program sweeps the table size on the host instead: for 4, 64, 1024
+ * and 8192 credential sets it builds the same WiFiCredsIndex::NameIndex
+ * that WiFiCreds.cpp builds at compile time, and times a lookup through it
+ * against the strcmp scan it replaced, for names that exist (hit) and names
+ * that do not (miss). Names share a long prefix, as generated site tables
+ * do, which is the expensive case for strcmp.
+ *
+ * Output is CSV: api,distribution,table_size,iterations,ns_per_op
+ *
+ * Every lookup is also checked, so the program exits non-zero if the index
+ * misses a name or finds one that is not in the table.
+ */
+
+#include <WiFiCredsIndex.h>
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+#if !WIFICREDS_HAS_NAME_INDEX
+#error "bench_lookup needs C++14 or newer for the name index"
+#endif
+
+namespace {
+
+const size_t PROBES = 1024;      // Distinct names per distribution
+const double MIN_TIME_MS = 200; // Each measurement repeats the probes at least this long
+const size_t NAME_LENGTH = 32;
+
+volatile size_t sink = 0;
+bool lookupsCorrect = true;
+
+/**
+ * @brief The lookup WiFiCreds used before the index: strcmp over every set
+ */
+size_t linearFind(const CredentialSet* sets, size_t count, const char* name) {
+    for (size_t i = 0; i < count; i++) {
+        if (strcmp(sets[i].name, name) == 0) {
+            return i;
+        }
+    }
+    return WiFiCredsIndex::EMPTY_SLOT;
+}
+
+template <size_t M>
+size_t indexFind(const WiFiCredsIndex::NameIndex<M>& index, const CredentialSet* sets, const char* name) {
+    const size_t candidate = index.candidate(name);
+    if (candidate == WiFiCredsIndex::EMPTY_SLOT || strcmp(sets[candidate].name, name) != 0) {
+        return WiFiCredsIndex::EMPTY_SLOT;
+    }
+    return candidate;
+}
+
+/**
+ * @brief Time @p find over the probe names and report ns per lookup
+ * @param expectHit Whether every probe should be found, checked on the first pass
+ */
+template <typename Find>
+void measure(const char* api, const char* distribution, size_t tableSize,
+             const std::vector<const char*>& probes, bool expectHit, Find find) {
+    for (const char* probe : probes) {
+        if ((find(probe) != WiFiCredsIndex::EMPTY_SLOT) != expectHit) {
+            lookupsCorrect = false;
+        }
+    }
+
+    size_t lookups = 0;
+    double ns = 0;
+    const auto start = std::chrono::steady_clock::now();
+    while (ns < MIN_TIME_MS * 1e6) {
+        for (const char* probe : probes) {
+            sink += find(probe);
+        }
+        lookups += probes.size();
+        ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    }
+    printf("%s,%s,%zu,%zu,%.2f\n", api, distribution, tableSize, lookups, ns / static_cast<double>(lookups));
+}
+
+/**
+ * @brief Build a table of @p N sets and its index, then measure both lookups
+ */
+template <size_t N>
+void run() {
+    constexpr size_t M = WiFiCredsIndex::tableSizeFor(N);
+    static char names[N][NAME_LENGTH];
+    static char missNames[PROBES][NAME_LENGTH];
+    static CredentialSet sets[N + 1];
+    static WiFiCredsIndex::NameIndex<M> index;
+
+    for (size_t i = 0; i < N; i++) {
+        snprintf(names[i], NAME_LENGTH, "site-warehouse-%06zu", i * 7919 % 1000003);
+        sets[i] = CredentialSet{names[i], "SSID", "password", 4, 8, false, nullptr};
+    }
+    sets[N] = CredentialSet{nullptr, nullptr, nullptr, 0, 0, false, nullptr};
+    index = WiFiCredsIndex::buildNameIndex<M>(sets, N);
+
+    // Hits cycle through the table in a scattered order; misses share the prefix
+    std::vector<const char*> hits;
+    std::vector<const char*> misses;
+    for (size_t p = 0; p < PROBES; p++) {
+        hits.push_back(names[(p * 2654435761u) % N]);
+        snprintf(missNames[p], NAME_LENGTH, "site-warehouse-x%05zu", p);
+        misses.push_back(missNames[p]);
+    }
+
+    auto linear = [](const char* name) { return linearFind(sets, N, name); };
+    auto indexed = [](const char* name) { return indexFind(index, sets, name); };
+    measure("linear_scan", "hit", N, hits, true, linear);
+    measure("linear_scan", "miss", N, misses, false, linear);
+    measure("name_index", "hit", N, hits, true, indexed);
+    measure("name_index", "miss", N, misses, false, indexed);
+}
+
+} // namespace
+
+int main() {
+    printf("api,distribution,table_size,iterations,ns_per_op\n");
+    run<4>();
+    run<64>();
+    run<1024>();
+    run<8192>();
+
+    if (!lookupsCorrect) {
+        printf("ERROR: a lookup returned the wrong result\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,30 @@
+/**
+ * @file credentials_progmem.h
+ * @brief The sets of src/credentials.h in PROGMEM mode, for test_progmem.cpp
+ * @author Rithik Krisna M
+ * @version 1.0.4
+ * @date 2025
+ *
+ * On the host PROGMEM is empty and the pgmspace functions are the plain
+ * ones, but the library still hands out its shared RAM buffers.
+ */
+
+#ifndef CREDENTIALS_H
+#define CREDENTIALS_H
+
+#define WIFICREDS_USE_PROGMEM 1
+
+WIFICREDS_FLASH_ENTRY(home, "MyHomeWiFi", "HomePassword123");
+WIFICREDS_FLASH_ENTRY(office, "OfficeNetwork", "OfficePassword456");
+WIFICREDS_FLASH_ENTRY(guest, "GuestWiFi", "GuestPassword789");
+WIFICREDS_FLASH_ENTRY(mobile, "MyPhoneHotspot", "MobilePassword");
+
+constexpr CredentialSet CREDENTIAL_SETS[] WIFICREDS_FLASH = {
+    WIFICREDS_FLASH_SET(home),
+    WIFICREDS_FLASH_SET(office),
+    WIFICREDS_FLASH_SET(guest),
+    WIFICREDS_FLASH_SET(mobile),
+    WIFICREDS_TERMINATOR
+};
+
+#endif // CREDENTIALS_H
@@ -0,0 +1,273 @@
+/**
+ * @file test_blob.cpp
+ * @brief Host test of credential blobs generated by credgen, in memory and mapped from a file
+ * @author Rithik Krisna M
+ * @version 1.0.4
+ * @date 2025
+ *
+ * credgen writes fixtures/sets.csv once with --format blob-header and once
+ * with --format blob. Both must hold the same bytes, and WiFiCredsBlob must
+ * read back every set: hits, misses, the default fallback, findSSID() and
+ * the PMKs credgen derived. Truncated and corrupted copies must be rejected
+ * by begin() and WiFiCredsMappedBlob::open(), or, without verify, resolve
+ * to no set instead of being read past their end.
+ *
+ * Finally reader threads keep resolving sets from snapshots while the file
+ * is replaced with publish() and swapped in with reload(). Run it under
+ * ThreadSanitizer with "make tsan".
+ */
+
+#include "WiFiCredsTest.h"
+#include "fixtures/credentials_blob.h"
+#include <WiFiCredsMappedBlob.h>
+#include <WiFiCredsPMK.h>
+#include <atomic>
+#include <stdio.h>
+#include <string.h>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const char* const BLOB_FILE = "build/fixtures/credentials.bin";
+const char* const MAPPED_FILE = "build/test_blob.bin";
+const int READERS = 4;
+const int SWAPS = 50;
+
+std::vector<uint8_t> fixture() {
+    return std::vector<uint8_t>(CREDENTIAL_BLOB, CREDENTIAL_BLOB + sizeof(CREDENTIAL_BLOB));
+}
+
+std::vector<uint8_t> readFile(const char* path) {
+    std::vector<uint8_t> data;
+    FILE* file = fopen(path, "rb");
+    if (file == nullptr) {
+        return data;
+    }
+    uint8_t buffer[256];
+    size_t count;
+    while ((count = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        data.insert(data.end(), buffer, buffer + count);
+    }
+    fclose(file);
+    return data;
+}
+
+uint16_t readU16(const std::vector<uint8_t>& blob, size_t at) {
+    return static_cast<uint16_t>(blob[at] | (blob[at + 1] << 8));
+}
+
+/// Byte offset of record @p index, from the offset table
+size_t recordOffset(const std::vector<uint8_t>& blob, size_t index) {
+    return static_cast<size_t>(readU16(blob, WIFICREDS_BLOB_HEADER_SIZE + index * 2)) * WIFICREDS_BLOB_ALIGNMENT;
+}
+
+/// Store a new CRC, so only the structure of a corrupted copy is wrong
+void reseal(std::vector<uint8_t>& blob) {
+    const uint32_t crc = WiFiCredsBlob::crc32(blob.data() + WIFICREDS_BLOB_HEADER_SIZE,
+                                              blob.size() - WIFICREDS_BLOB_HEADER_SIZE);
+    for (int i = 0; i < 4; i++) {
+        blob[16 + i] = static_cast<uint8_t>(crc >> (8 * i));
+    }
+}
+
+/// The fixture with the SSID of "office" changed, as an updated file would be
+std::vector<uint8_t> renamedOffice() {
+    std::vector<uint8_t> blob = fixture();
+    WiFiCredsBlob reader;
+    reader.begin(blob.data(), blob.size());
+    const CredentialView office = reader.resolve("office");
+    blob[static_cast<size_t>(reinterpret_cast<const uint8_t*>(office.ssid) - blob.data()) + office.ssidLength - 1] = '2';
+    reseal(blob);
+    return blob;
+}
+
+void testRoundTrip() {
+    const std::vector<uint8_t> file = readFile(BLOB_FILE);
+    CHECK(file == fixture());
+
+    WiFiCredsBlob blob;
+    CHECK(blob.begin(CREDENTIAL_BLOB, sizeof(CREDENTIAL_BLOB)));
+    CHECK(blob.isValid());
+    CHECK(blob.getCredentialCount() == 3);
+
+    // Records are in name order; the default is the first set of the CSV
+    CHECK(strcmp(blob.getCredentialName(0), "cafe") == 0);
+    CHECK(strcmp(blob.getCredentialName(1), "mobile") == 0);
+    CHECK(strcmp(blob.getCredentialName(2), "office") == 0);
+    CHECK(blob.getCredentialName(3) == nullptr);
+    CHECK(strcmp(blob.getDefaultName(), "office") == 0);
+
+    CredentialView mobile = blob.resolve("mobile");
+    CHECK(mobile.resolution == CredentialResolution::Found);
+    CHECK(strcmp(mobile.ssid, "MyPhoneHotspot") == 0 && mobile.ssidLength == 14);
+    CHECK(strcmp(mobile.password, "MobilePassword") == 0 && mobile.passwordLength == 14);
+    CHECK(mobile.index == 1);
+
+    CredentialView cafe = blob.resolve("cafe");
+    CHECK(cafe.resolution == CredentialResolution::Found);
+    CHECK(strcmp(cafe.password, "") == 0 && cafe.passwordLength == 0);
+    CHECK(cafe.pmk == nullptr);
+
+    CHECK(blob.resolve("unknown").resolution == CredentialResolution::Fallback);
+    CHECK(strcmp(blob.getSSID("unknown"), "OfficeNetwork") == 0);
+    CHECK(blob.resolve().resolution == CredentialResolution::Default);
+    CHECK(strcmp(blob.getPassword(), "OfficePassword456") == 0);
+    CHECK(blob.hasCredential("office"));
+    CHECK(!blob.hasCredential("unknown"));
+    CHECK(!blob.hasCredential(nullptr));
+
+    uint16_t indices[4];
+    CHECK(blob.findSSID("MyPhoneHotspot", indices, 4) == 1 && indices[0] == 1);
+    CHECK(blob.findSSID("MyPhoneHotspo", indices, 4) == 0);
+    CHECK(blob.findSSID("", indices, 4) == 0);
+
+    // credgen derived the PMKs the device would
+    const char* names[2] = {"office", "mobile"};
+    for (const char* name : names) {
+        const CredentialView creds = blob.resolve(name);
+        uint8_t pmk[WIFICREDS_PMK_LENGTH];
+        CHECK(WiFiCredsPMK::derive(creds.ssid, creds.ssidLength, creds.password, creds.passwordLength, pmk));
+        CHECK(creds.pmk != nullptr && memcmp(creds.pmk, pmk, sizeof(pmk)) == 0);
+    }
+}
+
+void testMalformed() {
+    const std::vector<uint8_t> good = fixture();
+    WiFiCredsBlob blob;
+
+    // Truncated anywhere, the header size no longer fits
+    const size_t cuts[4] = {0, WIFICREDS_BLOB_HEADER_SIZE - 1, WIFICREDS_BLOB_HEADER_SIZE + 4, good.size() - 1};
+    for (size_t cut : cuts) {
+        CHECK(!blob.begin(good.data(), cut, true));
+        CHECK(!blob.begin(good.data(), cut, false));
+    }
+    CHECK(!blob.begin(nullptr, good.size()));
+
+    std::vector<uint8_t> magic = good;
+    magic[0] = 'X';
+    CHECK(!blob.begin(magic.data(), magic.size(), false));
+    std::vector<uint8_t> version = good;
+    version[4] = WIFICREDS_BLOB_VERSION + 1;
+    CHECK(!blob.begin(version.data(), version.size(), false));
+
+    // A flipped password byte only shows in the CRC
+    std::vector<uint8_t> flipped = good;
+    flipped[good.size() - WIFICREDS_PMK_LENGTH - 2] ^= 0x01;
+    CHECK(!blob.begin(flipped.data(), flipped.size(), true));
+    CHECK(!blob.isValid());
+
+    // An offset past the end is rejected up front with verify, and read as no set without
+    std::vector<uint8_t> offset = good;
+    offset[WIFICREDS_BLOB_HEADER_SIZE] = 0xFF;
+    offset[WIFICREDS_BLOB_HEADER_SIZE + 1] = 0xFF;
+    reseal(offset);
+    CHECK(!blob.begin(offset.data(), offset.size(), true));
+    CHECK(blob.begin(offset.data(), offset.size(), false));
+    CHECK(blob.resolveIndex(0).resolution == CredentialResolution::None);
+    CHECK(blob.getCredentialName(0) == nullptr);
+    CHECK(!blob.hasCredential("cafe"));
+    CHECK(strcmp(blob.getSSID("mobile"), "MyPhoneHotspot") == 0);
+
+    // So is a record whose lengths run past the end, or into the next record
+    std::vector<uint8_t> length = good;
+    length[recordOffset(good, 2)] = 0xFF;
+    reseal(length);
+    CHECK(!blob.begin(length.data(), length.size(), true));
+    CHECK(blob.begin(length.data(), length.size(), false));
+    CHECK(blob.resolve().resolution == CredentialResolution::None);
+    CHECK(blob.getSSID("office") == nullptr);
+    uint16_t indices[4];
+    CHECK(blob.findSSID("OfficeNetwork", indices, 4) == 0);
+
+    std::vector<uint8_t> shifted = good;
+    shifted[recordOffset(good, 1) + 1]++;
+    reseal(shifted);
+    CHECK(!blob.begin(shifted.data(), shifted.size(), true));
+    CHECK(blob.begin(shifted.data(), shifted.size(), false));
+    CHECK(blob.resolve("mobile").resolution == CredentialResolution::Fallback);
+    CHECK(blob.resolveIndex(1).resolution == CredentialResolution::None);
+
+    // The same through a mapped file
+    WiFiCredsMappedBlob db(MAPPED_FILE);
+    ::remove(MAPPED_FILE);
+    CHECK(!db.open());
+    CHECK(!db.snapshot());
+    CHECK(WiFiCredsMappedBlob::publish(MAPPED_FILE, good.data(), good.size() - 1));
+    CHECK(!db.open());
+    CHECK(WiFiCredsMappedBlob::publish(MAPPED_FILE, good.data(), WIFICREDS_BLOB_HEADER_SIZE - 1));
+    CHECK(!db.open());
+    CHECK(WiFiCredsMappedBlob::publish(MAPPED_FILE, flipped.data(), flipped.size()));
+    CHECK(!db.open(true));
+    CHECK(WiFiCredsMappedBlob::publish(MAPPED_FILE, offset.data(), offset.size()));
+    CHECK(db.open());
+    CHECK(db.snapshot()->blob().resolveIndex(0).resolution == CredentialResolution::None);
+    ::remove(MAPPED_FILE);
+}
+
+void testHotSwap() {
+    const std::vector<uint8_t> versions[2] = {fixture(), renamedOffice()};
+    CHECK(WiFiCredsMappedBlob::publish(MAPPED_FILE, versions[0].data(), versions[0].size()));
+    WiFiCredsMappedBlob db(MAPPED_FILE);
+    CHECK(db.open());
+    CHECK(!db.reload());
+
+    // Held across every swap below, and never affected by them
+    const WiFiCredsMappedBlob::Snapshot first = db.snapshot();
+
+    std::atomic<bool> done(false);
+    std::atomic<int> torn(0);
+    std::atomic<long> lookups(0);
+    std::vector<std::thread> readers;
+    for (int i = 0; i < READERS; i++) {
+        readers.push_back(std::thread([&]() {
+            while (!done.load()) {
+                const WiFiCredsMappedBlob::Snapshot snapshot = db.snapshot();
+                const CredentialView office = snapshot->blob().resolve("office");
+                if (office.resolution != CredentialResolution::Found ||
+                    (strcmp(office.ssid, "OfficeNetwork") != 0 && strcmp(office.ssid, "OfficeNetwor2") != 0) ||
+                    strcmp(office.password, "OfficePassword456") != 0) {
+                    torn++;
+                }
+                lookups++;
+            }
+        }));
+    }
+
+    int swapped = 0;
+    for (int i = 1; i <= SWAPS; i++) {
+        const std::vector<uint8_t>& next = versions[i % 2];
+        if (WiFiCredsMappedBlob::publish(MAPPED_FILE, next.data(), next.size()) && db.reload()) {
+            swapped++;
+        }
+        std::this_thread::yield();
+    }
+
+    // A corrupted update is not swapped in
+    std::vector<uint8_t> corrupted = versions[0];
+    corrupted[corrupted.size() - 1] ^= 0x01;
+    CHECK(WiFiCredsMappedBlob::publish(MAPPED_FILE, corrupted.data(), corrupted.size()));
+    CHECK(!db.reload());
+
+    done = true;
+    for (std::thread& reader : readers) {
+        reader.join();
+    }
+    printf("test_blob: %d swaps, %ld lookups from snapshots\n", swapped, lookups.load());
+
+    CHECK(swapped == SWAPS);
+    CHECK(torn == 0);
+    CHECK(lookups > 0);
+    CHECK(strcmp(first->blob().getSSID("office"), "OfficeNetwork") == 0);
+    CHECK(strcmp(db.snapshot()->blob().getSSID("office"), (SWAPS % 2) ? "OfficeNetwor2" : "OfficeNetwork") == 0);
+    ::remove(MAPPED_FILE);
+}
+
+} // namespace
+
+int main() {
+    testRoundTrip();
+    testMalformed();
+    testHotSwap();
+    return WiFiCredsTest::result("test_blob");
+}
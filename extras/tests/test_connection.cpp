@@ -0,0 +1,188 @@
+/**
+ * @file test_connection.cpp
+ * @brief Host test of how long WiFiCredsConnection holds loop() per tick
+ * @author Rithik Krisna M
+ * @version 1.0.4
+ * @date 2025
+ *
+ * Runs a sketch-style loop against WiFiCredsSimDriver: poll() once per
+ * tick, then move the virtual clock on by one tick. Every poll() is checked
+ * for blocking (the virtual clock must not move inside it, as it does in a
+ * blocking scan) and for touching the driver more than once, and its wall
+ * time is measured. Events must arrive within one tick of the moment the
+ * driver reports the change.
+ *
+ * Runs against src/credentials.h (home, office, guest, mobile).
+ */
+
+#include "WiFiCredsTest.h"
+#include <WiFiCredsConnection.h>
+#include <WiFiCredsSimDriver.h>
+#include <algorithm>
+#include <chrono>
+#include <stdio.h>
+#include <vector>
+
+namespace {
+
+const uint32_t TICK_MS = 10;
+const uint32_t SCAN_DWELL_MS = 120;
+const uint32_t DHCP_MS = 500;
+
+/**
+ * @brief What the loop observed
+ */
+struct LoopRecord {
+    WiFiCredsEvent lastEvent;
+    uint32_t lastEventAt;  ///< Virtual time of the last event
+    unsigned events;
+    bool blocked;          ///< A poll() moved the virtual clock
+    bool chatty;           ///< A poll() read the driver status more than once
+    std::vector<uint32_t> pollNs;
+};
+
+struct Harness {
+    WiFiCredsSimDriver sim;
+    WiFiCredsConnection connection;
+    LoopRecord loop;
+
+    Harness() : connection(sim), loop() {
+        sim.setScanDwell(SCAN_DWELL_MS);
+        sim.setDhcpLatency(DHCP_MS);
+        connection.onEvent(handler, this);
+    }
+
+    static void handler(WiFiCredsEvent event, const CredentialView&, void* context) {
+        Harness* harness = static_cast<Harness*>(context);
+        harness->loop.lastEvent = event;
+        harness->loop.lastEventAt = harness->sim.now();
+        harness->loop.events++;
+    }
+
+    /**
+     * @brief One loop() pass: poll, then let a tick of other work pass
+     */
+    WiFiCredsConnectionState tick() {
+        const uint32_t before = sim.now();
+        const uint32_t statusBefore = sim.statusCalls();
+        const auto start = std::chrono::steady_clock::now();
+        const WiFiCredsConnectionState state = connection.poll();
+        const auto end = std::chrono::steady_clock::now();
+        loop.pollNs.push_back(static_cast<uint32_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()));
+        loop.blocked = loop.blocked || sim.now() != before;
+        loop.chatty = loop.chatty || sim.statusCalls() - statusBefore > 1;
+        sim.advance(TICK_MS);
+        return state;
+    }
+
+    /// Tick until the attempt finishes or @p limitMs of virtual time pass
+    void runWhileConnecting(uint32_t limitMs) {
+        const uint32_t start = sim.now();
+        while (tick() == WiFiCredsConnectionState::Connecting && sim.now() - start < limitMs) {
+        }
+    }
+};
+
+WiFiCredsSimAP makeAP(const char* ssid, const char* password, uint32_t latencyMs) {
+    WiFiCredsSimAP ap = {ssid, password, {0x02, 0, 0, 0, 0, 1}, 6, -60, latencyMs, 0, true};
+    return ap;
+}
+
+uint32_t percentile(std::vector<uint32_t> samples, unsigned percent) {
+    std::sort(samples.begin(), samples.end());
+    return samples.empty() ? 0 : samples[(samples.size() - 1) * percent / 100];
+}
+
+void testConnectNeverBlocks() {
+    Harness h;
+    h.sim.addAP(makeAP("MyHomeWiFi", "HomePassword123", 3000));
+
+    const uint32_t before = h.sim.now();
+    CHECK(h.connection.connect("home", 30000));
+    CHECK(h.sim.now() == before);
+    CHECK(h.loop.lastEvent == WiFiCredsEvent::Connecting);
+
+    h.runWhileConnecting(30000);
+    const uint32_t expectedAt = 3000 + 13 * SCAN_DWELL_MS + DHCP_MS;
+    CHECK(h.connection.isConnected());
+    CHECK(h.loop.lastEvent == WiFiCredsEvent::Connected);
+    CHECK(h.loop.lastEventAt >= expectedAt && h.loop.lastEventAt < expectedAt + TICK_MS);
+    CHECK(h.connection.lastAttemptDuration() >= expectedAt &&
+          h.connection.lastAttemptDuration() < expectedAt + TICK_MS);
+
+    // No poll() while connecting held the loop in virtual time
+    CHECK(h.loop.pollNs.size() >= expectedAt / TICK_MS);
+    CHECK(!h.loop.blocked);
+    CHECK(!h.loop.chatty);
+
+    // Connected: polling keeps watching the link without holding the loop either
+    for (int i = 0; i < 100; i++) {
+        h.tick();
+    }
+    CHECK(h.connection.isConnected());
+    CHECK(!h.loop.blocked);
+
+    const uint32_t p99 = percentile(h.loop.pollNs, 99);
+    const uint32_t max = percentile(h.loop.pollNs, 100);
+    printf("test_connection: %zu polls, wall time per poll p50 %u ns, p99 %u ns, max %u ns\n",
+           h.loop.pollNs.size(), percentile(h.loop.pollNs, 50), p99, max);
+    CHECK(p99 < 100000);
+}
+
+void testTimeoutWithinOneTick() {
+    Harness h;
+    h.sim.addAP(makeAP("OfficeNetwork", "OfficePassword456", 20000));
+
+    CHECK(h.connection.connect("office", 4000));
+    h.runWhileConnecting(30000);
+    CHECK(h.loop.lastEvent == WiFiCredsEvent::Timeout);
+    CHECK(h.loop.lastEventAt >= 4000 && h.loop.lastEventAt < 4000 + TICK_MS);
+    CHECK(h.connection.state() == WiFiCredsConnectionState::Idle);
+    CHECK(h.sim.currentAP() == -1); // the radio was told to stop
+    CHECK(!h.loop.blocked);
+}
+
+void testFailureAndLinkLoss() {
+    Harness h;
+    h.sim.addAP(makeAP("GuestWiFi", "ChangedPassword", 800));
+
+    CHECK(h.connection.connect("guest", 30000));
+    h.runWhileConnecting(30000);
+    CHECK(h.loop.lastEvent == WiFiCredsEvent::Failed);
+    const uint32_t failedAt = 800 + 13 * SCAN_DWELL_MS;
+    CHECK(h.loop.lastEventAt >= failedAt && h.loop.lastEventAt < failedAt + TICK_MS);
+
+    h.sim.ap(0)->password = "GuestPassword789";
+    CHECK(h.connection.connect("guest", 30000));
+    h.runWhileConnecting(30000);
+    CHECK(h.connection.isConnected());
+
+    // The AP goes down: reported on the next tick
+    h.sim.ap(0)->up = false;
+    const uint32_t downAt = h.sim.now();
+    h.tick();
+    CHECK(h.loop.lastEvent == WiFiCredsEvent::Disconnected);
+    CHECK(h.loop.lastEventAt == downAt);
+    CHECK(h.connection.state() == WiFiCredsConnectionState::Idle);
+
+    // Idle polls do not touch the driver at all
+    const uint32_t statusCalls = h.sim.statusCalls();
+    const unsigned events = h.loop.events;
+    for (int i = 0; i < 100; i++) {
+        h.tick();
+    }
+    CHECK(h.sim.statusCalls() == statusCalls);
+    CHECK(h.loop.events == events);
+    CHECK(!h.loop.blocked);
+    CHECK(!h.loop.chatty);
+}
+
+} // namespace
+
+int main() {
+    testConnectNeverBlocks();
+    testTimeoutWithinOneTick();
+    testFailureAndLinkLoss();
+    return WiFiCredsTest::result("test_connection");
+}
@@ -0,0 +1,77 @@
+/**
+ * @file test_progmem.cpp
+ * @brief Host test of the index accessors in PROGMEM mode
+ * @author Rithik Krisna M
+ * @version 1.0.4
+ * @date 2025
+ *
+ * In PROGMEM mode getSSID(), getPassword(), getCredentialName() and
+ * resolveIndex() return copies in shared RAM buffers. Scan matching and the
+ * fast reconnect cache only need one field of a set, and must not overwrite
+ * a copy the sketch still holds.
+ *
+ * Runs against fixtures/credentials_progmem.h (the sets of src/credentials.h).
+ */
+
+#include "WiFiCredsTest.h"
+#include <WiFiCreds.h>
+#include <WiFiCredsFastReconnect.h>
+#include <WiFiCredsScan.h>
+#include <string.h>
+
+namespace {
+
+void testIndexAccessors() {
+    CHECK(WiFiCreds::usesProgmem());
+    CHECK(WiFiCreds::getPasswordLengthAt(0) == strlen("HomePassword123"));
+    CHECK(WiFiCreds::getPasswordLengthAt(1) == strlen("OfficePassword456"));
+    CHECK(WiFiCreds::getPasswordLengthAt(WiFiCreds::getCredentialCount()) == 0);
+
+    char ssid[WIFICREDS_SSID_BUFFER_SIZE];
+    CHECK(WiFiCreds::copySSIDAt(3, ssid, sizeof(ssid)));
+    CHECK(strcmp(ssid, "MyPhoneHotspot") == 0);
+    CHECK(!WiFiCreds::copySSIDAt(3, ssid, strlen("MyPhoneHotspot")));
+    CHECK(!WiFiCreds::copySSIDAt(WiFiCreds::getCredentialCount(), ssid, sizeof(ssid)));
+    CHECK(!WiFiCreds::copySSIDAt(0, nullptr, sizeof(ssid)));
+}
+
+void testScanKeepsSharedBuffers() {
+    const char* name = WiFiCreds::getCredentialName(1);
+    const char* password = WiFiCreds::getPassword("office");
+    CHECK(strcmp(name, "office") == 0);
+    CHECK(strcmp(password, "OfficePassword456") == 0);
+
+    WiFiCredsScanEntry entry = {"MyHomeWiFi", {0x02, 0, 0, 0, 0, 1}, 6, -60, false};
+    WiFiCredsCandidate candidates[2];
+    CHECK(WiFiCredsScan::insert(entry, candidates, 0, 2) == 1);
+    CHECK(candidates[0].credentialIndex == 0);
+
+    // An open network of the same name is no match for a set with a password
+    entry.open = true;
+    CHECK(WiFiCredsScan::insert(entry, candidates, 0, 2) == 0);
+
+    CHECK(strcmp(name, "office") == 0);
+    CHECK(strcmp(password, "OfficePassword456") == 0);
+}
+
+void testFastReconnectKeepsSharedBuffers() {
+    const uint8_t bssid[6] = {0x02, 0, 0, 0, 0, 1};
+    const char* password = WiFiCreds::getPassword("office");
+
+    CHECK(WiFiCredsFastReconnect::save(0, bssid, 6, 0x0A00000AUL, 0x0A000001UL, 0xFFFFFF00UL, 0x0A000001UL));
+    WiFiCredsLinkState state;
+    CHECK(WiFiCredsFastReconnect::load(state));
+    CHECK(state.credentialIndex == 0);
+    CHECK(!WiFiCredsFastReconnect::save(WiFiCreds::getCredentialCount(), bssid, 6, 0, 0, 0, 0));
+
+    CHECK(strcmp(password, "OfficePassword456") == 0);
+}
+
+} // namespace
+
+int main() {
+    testIndexAccessors();
+    testScanKeepsSharedBuffers();
+    testFastReconnectKeepsSharedBuffers();
+    return WiFiCredsTest::result("test_progmem");
+}
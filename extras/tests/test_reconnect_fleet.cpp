@@ -0,0 +1,303 @@
+/**
+ * @file test_reconnect_fleet.cpp
+ * @brief Host simulation of 1000 devices reconnecting after an access point outage
+ * @author Rithik Krisna M
+ * @version 1.0.4
+ * @date 2025
+ *
+ * Every device has its own WiFiCredsSimDriver with a copy of one shared AP,
+ * all on one virtual clock. The AP admits AP_CAPACITY associations per
+ * second; beyond that each request costs it airtime, so the number it
+ * admits falls as the offered load rises. The AP goes down for 60 s while
+ * the whole fleet is connected, and comes back.
+ *
+ * The fleet runs once with the examples' fixed 1 s retry and once with
+ * WiFiCredsReconnect and its defaults, each device seeded differently. The
+ * recovery time, the association attempts the AP is offered per second and
+ * each device's attempts against its budget are measured.
+ *
+ * A single device checks what nextAttemptIn() reports while a token is due
+ * but not yet credited.
+ *
+ * Runs against src/credentials.h; every device uses the home set.
+ */
+
+#include "WiFiCredsTest.h"
+#include <WiFiCredsConnection.h>
+#include <WiFiCredsReconnect.h>
+#include <WiFiCredsSimDriver.h>
+#include <memory>
+#include <stdio.h>
+#include <vector>
+
+namespace {
+
+const size_t NODES = 1000;
+const uint32_t TICK_MS = 50;
+const size_t TICKS_PER_SECOND = 1000 / TICK_MS;
+const uint32_t AP_CAPACITY = 50;         ///< Associations per second the AP admits
+const uint32_t OUTAGE_MS = 60000;
+const uint32_t RECOVERY_LIMIT_MS = 400000;
+const uint32_t ATTEMPT_TIMEOUT_MS = 10000;
+const uint32_t RETRY_DELAY_MS = 1000;    ///< Fixed retry of the examples
+
+/**
+ * @brief One device: its radio, its connection and, unless it retries at a fixed rate, its scheduler
+ */
+struct Node {
+    WiFiCredsSimDriver sim;
+    WiFiCredsConnection connection;
+    WiFiCredsReconnect reconnect;
+    bool backoff;
+    uint32_t idleSince;
+    uint32_t beginCalls;  ///< sim.beginCalls() at the last tick
+
+    Node(size_t id, bool useBackoff)
+        : sim(static_cast<uint32_t>(id) + 1), connection(sim), reconnect(sim, connection), backoff(useBackoff),
+          idleSince(0), beginCalls(0) {
+        // Radios differ a little, so devices that fail together do not stay in step forever
+        const uint32_t latencyMs = 400 + static_cast<uint32_t>(id % 200);
+        WiFiCredsSimAP ap = {"MyHomeWiFi", "HomePassword123", {0x02, 0, 0, 0, 0, 1}, 6, -60, latencyMs, 0, true};
+        sim.addAP(ap);
+        connection.onEvent(handler, this);
+        reconnect.setSeed(0x9E3779B9UL * static_cast<uint32_t>(id + 1));
+        reconnect.setTimeout(ATTEMPT_TIMEOUT_MS);
+        reconnect.add("home");
+    }
+
+    static void handler(WiFiCredsEvent event, const CredentialView&, void* context) {
+        Node* node = static_cast<Node*>(context);
+        if (event == WiFiCredsEvent::Failed || event == WiFiCredsEvent::Timeout ||
+            event == WiFiCredsEvent::Disconnected) {
+            node->idleSince = node->sim.now();
+        }
+    }
+
+    /// One pass of loop(); returns the association attempts it started
+    uint32_t tick() {
+        if (backoff) {
+            reconnect.poll();
+        } else if (connection.poll() == WiFiCredsConnectionState::Idle &&
+                   sim.now() - idleSince >= RETRY_DELAY_MS) {
+            connection.connect("home", ATTEMPT_TIMEOUT_MS);
+        }
+        const uint32_t started = sim.beginCalls() - beginCalls;
+        beginCalls = sim.beginCalls();
+        return started;
+    }
+};
+
+/**
+ * @brief What one outage cost the fleet
+ */
+struct FleetResult {
+    uint32_t recovered50Ms;     ///< Time after the AP came back until half the fleet was connected
+    uint32_t recovered95Ms;
+    uint32_t recovered100Ms;    ///< RECOVERY_LIMIT_MS if the fleet did not recover in time
+    size_t connectedAtEnd;
+    uint32_t peakOffered;       ///< Most association attempts the AP saw in one second
+    uint32_t attempts;          ///< Attempts of the whole fleet from the outage on
+    uint32_t mostNodeAttempts;  ///< Most attempts of one device from the outage on
+    uint32_t elapsedMs;         ///< Time from the outage to the end of the run
+};
+
+class Fleet {
+public:
+    explicit Fleet(bool backoff)
+        : _window(TICKS_PER_SECOND, 0), _slot(0), _offered(0), _loadModel(false), _random(0x2545F491) {
+        for (size_t i = 0; i < NODES; i++) {
+            _nodes.push_back(std::unique_ptr<Node>(new Node(i, backoff)));
+        }
+    }
+
+    FleetResult run() {
+        FleetResult result = {};
+
+        // Devices booted over time and are all connected when the AP fails
+        while (connected() < NODES) {
+            tick();
+        }
+
+        std::vector<uint32_t> before;
+        for (const std::unique_ptr<Node>& node : _nodes) {
+            before.push_back(node->sim.beginCalls());
+        }
+        const uint32_t outageAt = now();
+        setAP(false);
+        while (now() - outageAt < OUTAGE_MS) {
+            tick();
+        }
+
+        // The AP is back and is now offered whatever the fleet sends
+        setAP(true);
+        _loadModel = true;
+        const uint32_t upAt = now();
+        result.recovered50Ms = result.recovered95Ms = result.recovered100Ms = RECOVERY_LIMIT_MS;
+        while (now() - upAt < RECOVERY_LIMIT_MS) {
+            tick();
+            result.peakOffered = (_offered > result.peakOffered) ? _offered : result.peakOffered;
+            const size_t up = connected();
+            if (up * 2 >= NODES && result.recovered50Ms == RECOVERY_LIMIT_MS) {
+                result.recovered50Ms = now() - upAt;
+            }
+            if (up * 100 >= NODES * 95 && result.recovered95Ms == RECOVERY_LIMIT_MS) {
+                result.recovered95Ms = now() - upAt;
+            }
+            if (up == NODES) {
+                result.recovered100Ms = now() - upAt;
+                break;
+            }
+        }
+
+        result.connectedAtEnd = connected();
+        result.elapsedMs = now() - outageAt;
+        for (size_t i = 0; i < NODES; i++) {
+            const uint32_t attempts = _nodes[i]->sim.beginCalls() - before[i];
+            result.attempts += attempts;
+            result.mostNodeAttempts = (attempts > result.mostNodeAttempts) ? attempts : result.mostNodeAttempts;
+        }
+        return result;
+    }
+
+private:
+    std::vector<std::unique_ptr<Node>> _nodes;
+    std::vector<uint32_t> _window;  ///< Attempts per tick over the last second
+    size_t _slot;
+    uint32_t _offered;              ///< Attempts in the last second
+    bool _loadModel;                ///< Admissions depend on the load (not while the fleet first connects)
+    uint32_t _random;
+    std::vector<Node*> _arrivals;   ///< Devices that started an attempt in this step
+
+    uint32_t now() { return _nodes[0]->sim.now(); }
+
+    size_t connected() const {
+        size_t count = 0;
+        for (const std::unique_ptr<Node>& node : _nodes) {
+            count += node->connection.isConnected() ? 1 : 0;
+        }
+        return count;
+    }
+
+    void setAP(bool up) {
+        for (const std::unique_ptr<Node>& node : _nodes) {
+            node->sim.ap(0)->up = up;
+        }
+    }
+
+    /**
+     * @brief Share of attempts in permille the AP admits at a load
+     *
+     * Up to AP_CAPACITY attempts per second all get in. Above it the AP admits
+     * AP_CAPACITY * AP_CAPACITY / offered of them, so a storm slows everyone down.
+     */
+    uint32_t admitPermille(uint32_t offered) const {
+        if (!_loadModel || offered <= AP_CAPACITY) {
+            return 1000;
+        }
+        return 1000 * AP_CAPACITY * AP_CAPACITY / (offered * offered);
+    }
+
+    void tick() {
+        for (const std::unique_ptr<Node>& node : _nodes) {
+            if (node->tick() > 0) {
+                _arrivals.push_back(node.get());
+            }
+        }
+        const uint32_t started = static_cast<uint32_t>(_arrivals.size());
+        _offered += started - _window[_slot];
+        _window[_slot] = started;
+        _slot = (_slot + 1) % _window.size();
+
+        // The AP judges every attempt of this step by the load including all of them
+        const uint32_t admit = admitPermille(_offered);
+        for (Node* node : _arrivals) {
+            if (nextRandom() % 1000 >= admit) {
+                node->sim.rejectAttempt();
+            }
+        }
+        _arrivals.clear();
+
+        for (const std::unique_ptr<Node>& node : _nodes) {
+            node->sim.advance(TICK_MS);
+        }
+    }
+
+    /// xorshift32 of the AP's admission decisions
+    uint32_t nextRandom() {
+        _random ^= _random << 13;
+        _random ^= _random >> 17;
+        _random ^= _random << 5;
+        return _random;
+    }
+};
+
+void print(const char* name, const FleetResult& result) {
+    printf("test_reconnect_fleet: %-8s back 50%% %5.1f s, 95%% %5.1f s, 100%% %5.1f s; "
+           "%zu back at the end; peak %u attempts/s, %u attempts (at most %u per device)\n",
+           name, result.recovered50Ms / 1000.0, result.recovered95Ms / 1000.0, result.recovered100Ms / 1000.0,
+           result.connectedAtEnd, result.peakOffered, result.attempts, result.mostNodeAttempts);
+}
+
+void testOutage() {
+    FleetResult fixed;
+    {
+        Fleet fleet(false);
+        fixed = fleet.run();
+    }
+    FleetResult backoff;
+    {
+        Fleet fleet(true);
+        backoff = fleet.run();
+    }
+    print("fixed", fixed);
+    print("backoff", backoff);
+
+    // The fixed retry storms the AP, which then admits next to nobody
+    CHECK(fixed.peakOffered > 10 * AP_CAPACITY);
+    CHECK(fixed.connectedAtEnd == NODES);
+
+    // With backoff the whole fleet is back within a minute, never far above what the AP admits
+    CHECK(backoff.connectedAtEnd == NODES);
+    CHECK(backoff.recovered100Ms < 60000);
+    CHECK(backoff.recovered50Ms * 3 < fixed.recovered50Ms);
+    CHECK(backoff.recovered100Ms * 2 < fixed.recovered100Ms);
+    CHECK(backoff.peakOffered < 2 * AP_CAPACITY);
+    CHECK(backoff.attempts * 5 < fixed.attempts);
+
+    // No device exceeded its token bucket
+    const uint32_t budget = WIFICREDS_RECONNECT_BUDGET + backoff.elapsedMs / WIFICREDS_RECONNECT_BUDGET_REFILL;
+    CHECK(backoff.mostNodeAttempts <= budget);
+}
+
+void testNextAttemptInWithDueToken() {
+    WiFiCredsSimDriver sim; // no AP, so every attempt fails
+    sim.setNoSsidLatency(100);
+    WiFiCredsConnection connection(sim);
+    WiFiCredsReconnect reconnect(sim, connection, 42);
+    reconnect.setBudget(1, 5000);
+    reconnect.setDelays(1000, 2000);
+    CHECK(reconnect.add("home"));
+
+    // Spend the only token and let the attempt fail
+    while (reconnect.poll() != WiFiCredsConnectionState::Idle || reconnect.attempts() == 0) {
+        sim.advance(10);
+    }
+    CHECK(reconnect.waiting());
+    CHECK(reconnect.budget() == 0);
+    CHECK(reconnect.nextAttemptIn() > 0 && reconnect.nextAttemptIn() <= 5000);
+
+    // The token is due, but only the next poll() credits it
+    sim.advance(6000);
+    CHECK(reconnect.budget() == 0);
+    CHECK(reconnect.nextAttemptIn() == 0);
+    reconnect.poll();
+    CHECK(reconnect.attempts() == 2);
+}
+
+} // namespace
+
+int main() {
+    testNextAttemptInWithDueToken();
+    testOutage();
+    return WiFiCredsTest::result("test_reconnect_fleet");
+}
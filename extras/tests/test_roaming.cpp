@@ -0,0 +1,244 @@
+/**
+ * @file test_roaming.cpp
+ * @brief Host simulation of a device moving along a row of access points
+ * @author Rithik Krisna M
+ * @version 1.0.4
+ * @date 2025
+ *
+ * Twelve APs of one network hang 40 m apart along a warehouse aisle, and a
+ * device drives up and down the aisle for an hour. The RSSI of every AP
+ * follows a log-distance path loss model with a little seeded noise, and
+ * the link is lost below LINK_LOSS_RSSI. The loop is the one of the Roaming
+ * example, which "sends" a packet every 100 ms, so the packet loss and the
+ * longest loss window can be compared with and without WiFiCredsRoaming.
+ * A device parked midway between two APs must not roam at all.
+ *
+ * Runs against src/credentials.h; every AP belongs to the home set.
+ */
+
+#include "WiFiCredsTest.h"
+#include <WiFiCredsConnection.h>
+#include <WiFiCredsRoaming.h>
+#include <WiFiCredsScanScheduler.h>
+#include <WiFiCredsSimDriver.h>
+#include <math.h>
+#include <stdio.h>
+
+namespace {
+
+const uint32_t TICK_MS = 10;
+const uint32_t SAMPLE_MS = 100;          ///< RSSI update and packet period
+const uint32_t RETRY_DELAY_MS = 2000;    ///< Pause before reconnecting after a lost link
+const uint32_t HOUR_MS = 3600000UL;
+const int APS = 12;
+const double AP_SPACING_M = 40.0;
+const double AISLE_OFFSET_M = 3.0;       ///< Distance between the aisle and the row of APs
+const int8_t LINK_LOSS_RSSI = -85;
+
+/**
+ * @brief What one run measured
+ */
+struct AisleResult {
+    uint32_t sent;
+    uint32_t lost;
+    uint32_t longestGapMs;    ///< Longest time between two delivered packets
+    uint32_t linkLosses;      ///< Disconnected events
+    uint32_t boundaries;      ///< Times the nearest AP changed
+    uint32_t roams;
+    uint32_t failedRoams;
+    int8_t weakestRoamRssi;   ///< Lowest link RSSI at which a roam was started
+};
+
+class Aisle {
+public:
+    /**
+     * @param roam Run WiFiCredsScanScheduler and WiFiCredsRoaming, or only reconnect after a loss
+     * @param speed Metres per second; 0 parks the device at @p start
+     * @param start Position along the aisle in metres
+     */
+    Aisle(bool roam, double speed, double start)
+        : _connection(_sim), _scanner(_sim), _roaming(_sim, _connection, _scanner), _roam(roam),
+          _speed(speed), _position(start), _direction(1), _random(0x2545F491), _idleSince(0), _result() {
+        _sim.setScanDwell(120);
+        _sim.setDhcpLatency(500);
+        _sim.setLinkLossRssi(LINK_LOSS_RSSI);
+        for (int i = 0; i < APS; i++) {
+            const uint8_t channels[3] = {1, 6, 11};
+            WiFiCredsSimAP ap = {"MyHomeWiFi", "HomePassword123",
+                                 {0x02, 0, 0, 0, 0, static_cast<uint8_t>(i + 1)},
+                                 channels[i % 3], 0, 300, 0, true};
+            _sim.addAP(ap);
+        }
+        updateSignals();
+        _connection.onEvent(handler, this);
+        _result.weakestRoamRssi = 0;
+    }
+
+    AisleResult run(uint32_t durationMs) {
+        _connection.connect("home");
+        while (!_connection.isConnected()) {
+            tick();
+        }
+
+        // Measure from the first link on, so both runs start alike
+        const uint32_t start = _sim.now();
+        uint32_t lastDelivered = start;
+        int nearest = nearestAP();
+        while (_sim.now() - start < durationMs) {
+            tick();
+            if (_sim.now() % SAMPLE_MS != 0) {
+                continue;
+            }
+            move();
+            updateSignals();
+            if (nearestAP() != nearest) {
+                nearest = nearestAP();
+                _result.boundaries++;
+            }
+
+            uint8_t bssid[6];
+            _result.sent++;
+            if (_sim.bssid(bssid)) {
+                const uint32_t gap = _sim.now() - lastDelivered;
+                _result.longestGapMs = (gap > _result.longestGapMs) ? gap : _result.longestGapMs;
+                lastDelivered = _sim.now();
+            } else {
+                _result.lost++;
+            }
+        }
+        _result.roams = _roaming.roamCount();
+        _result.failedRoams = _roaming.failedRoams();
+        return _result;
+    }
+
+    /// Link RSSI the roaming engine expects, see WiFiCredsRoaming::predictedRssi()
+    int8_t predictedRssi() const { return _roaming.predictedRssi(); }
+
+private:
+    WiFiCredsSimDriver _sim;
+    WiFiCredsConnection _connection;
+    WiFiCredsScanScheduler _scanner;
+    WiFiCredsRoaming _roaming;
+    bool _roam;
+    double _speed;
+    double _position;
+    int _direction;
+    uint32_t _random;
+    uint32_t _idleSince;
+    AisleResult _result;
+
+    static void handler(WiFiCredsEvent event, const CredentialView&, void* context) {
+        Aisle* aisle = static_cast<Aisle*>(context);
+        if (event == WiFiCredsEvent::Disconnected) {
+            aisle->_result.linkLosses++;
+        }
+        if (event == WiFiCredsEvent::Failed || event == WiFiCredsEvent::Timeout ||
+            event == WiFiCredsEvent::Disconnected) {
+            aisle->_idleSince = aisle->_sim.now();
+        }
+    }
+
+    /// One pass of the Roaming example's loop(), then one tick of other work
+    void tick() {
+        _connection.poll();
+        if (_roam) {
+            _scanner.poll();
+            const int current = _sim.currentAP();
+            const int8_t rssi = (current >= 0) ? _sim.ap(static_cast<size_t>(current))->rssi : 0;
+            if (_roaming.poll() && rssi < _result.weakestRoamRssi) {
+                _result.weakestRoamRssi = rssi;
+            }
+        }
+        if (_connection.state() == WiFiCredsConnectionState::Idle && !_roaming.roaming() &&
+            _sim.now() - _idleSince >= RETRY_DELAY_MS) {
+            _connection.connect("home");
+        }
+        _sim.advance(TICK_MS);
+    }
+
+    /// Drive back and forth between the first and the last AP
+    void move() {
+        const double end = (APS - 1) * AP_SPACING_M;
+        _position += _direction * _speed * SAMPLE_MS / 1000.0;
+        if (_position >= end || _position <= 0) {
+            _position = (_position >= end) ? end : 0;
+            _direction = -_direction;
+        }
+    }
+
+    int nearestAP() const {
+        return static_cast<int>(floor(_position / AP_SPACING_M + 0.5));
+    }
+
+    /// Log-distance path loss, exponent 3, -40 dBm at 1 m, plus up to 2 dB of noise
+    void updateSignals() {
+        for (int i = 0; i < APS; i++) {
+            const double distance = hypot(_position - i * AP_SPACING_M, AISLE_OFFSET_M);
+            const int noise = static_cast<int>(nextRandom() % 5) - 2;
+            _sim.ap(static_cast<size_t>(i))->rssi = static_cast<int8_t>(lround(-40 - 30 * log10(distance)) + noise);
+        }
+    }
+
+    /// xorshift32, so every run sees the same noise
+    uint32_t nextRandom() {
+        _random ^= _random << 13;
+        _random ^= _random >> 17;
+        _random ^= _random << 5;
+        return _random;
+    }
+};
+
+double lossPercent(const AisleResult& result) {
+    return result.sent ? 100.0 * result.lost / result.sent : 0;
+}
+
+void print(const char* name, const AisleResult& result) {
+    printf("test_roaming: %-10s %u packets, %.1f%% lost, longest gap %u ms, %u link losses, "
+           "%u roams (%u failed) over %u AP boundaries, weakest roam at %d dBm\n",
+           name, result.sent, lossPercent(result), result.longestGapMs, result.linkLosses, result.roams,
+           result.failedRoams, result.boundaries, result.weakestRoamRssi);
+}
+
+void testMovingDevice() {
+    Aisle reconnecting(false, 2.0, 0);
+    const AisleResult without = reconnecting.run(HOUR_MS);
+    Aisle roaming(true, 2.0, 0);
+    const AisleResult with = roaming.run(HOUR_MS);
+    print("reconnect", without);
+    print("roaming", with);
+
+    // Without roaming the device holds on to each AP until the link is lost, then waits RETRY_DELAY_MS
+    CHECK(without.boundaries > 100);
+    CHECK(without.linkLosses > without.boundaries * 3 / 4);
+    CHECK(without.longestGapMs > RETRY_DELAY_MS);
+
+    // With roaming the link moves once per boundary, before the old AP is lost
+    CHECK(with.boundaries == without.boundaries);
+    CHECK(with.linkLosses == 0);
+    CHECK(with.failedRoams == 0);
+    CHECK(with.roams >= with.boundaries - 1 && with.roams <= with.boundaries + 1);
+    CHECK(with.weakestRoamRssi > LINK_LOSS_RSSI);
+
+    // What is left is the pinned reassociation with DHCP
+    CHECK(with.longestGapMs < 1500);
+    CHECK(lossPercent(with) * 3 < lossPercent(without));
+}
+
+void testParkedBetweenAPs() {
+    // Both neighbours are equally strong and below the trigger: the margin keeps the device put
+    Aisle parked(true, 0, 5.5 * AP_SPACING_M);
+    const AisleResult result = parked.run(HOUR_MS / 6);
+    print("parked", result);
+    CHECK(parked.predictedRssi() < WIFICREDS_ROAM_TRIGGER);
+    CHECK(result.roams == 0);
+    CHECK(result.linkLosses == 0);
+    CHECK(result.lost == 0);
+}
+
+} // namespace
+
+int main() {
+    testMovingDevice();
+    testParkedBetweenAPs();
+    return WiFiCredsTest::result("test_roaming");
+}
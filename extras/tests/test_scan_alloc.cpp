@@ -0,0 +1,172 @@
+/**
+ * @file test_scan_alloc.cpp
+ * @brief Host test that a scan cycle makes no heap allocation
+ * @author Rithik Krisna M
+ * @version 1.0.4
+ * @date 2025
+ *
+ * Counts every malloc(), calloc(), realloc() and operator new while 1000
+ * scan cycles run against WiFiCredsSimDriver. A cycle does what the ESP32
+ * and ESP8266 examples do every SCAN_INTERVAL: scan, format every result
+ * and BSSID, rank the results against the credential table, find the
+ * default network and name the link status. With the Arduino String API
+ * each of those steps allocated; here the count must stay at zero.
+ *
+ * Under AddressSanitizer the allocator reports every allocation through
+ * its malloc hook; otherwise the malloc family is interposed (glibc).
+ *
+ * Runs against src/credentials.h (home, office, guest, mobile).
+ */
+
+#include "WiFiCredsTest.h"
+#include <WiFiCreds.h>
+#include <WiFiCredsFormat.h>
+#include <WiFiCredsScan.h>
+#include <WiFiCredsSimDriver.h>
+#include <stddef.h>
+#include <string.h>
+
+namespace {
+
+volatile unsigned long allocations = 0;
+
+} // namespace
+
+#if defined(__SANITIZE_ADDRESS__)
+
+// From <sanitizer/allocator_interface.h>, which not every compiler installs
+extern "C" int __sanitizer_install_malloc_and_free_hooks(void (*malloc_hook)(const volatile void*, size_t),
+                                                         void (*free_hook)(const volatile void*));
+
+namespace {
+
+void countAllocation(const volatile void*, size_t) {
+    allocations = allocations + 1;
+}
+
+void ignoreFree(const volatile void*) {}
+
+bool installCounter() {
+    return __sanitizer_install_malloc_and_free_hooks(countAllocation, ignoreFree) != 0;
+}
+
+} // namespace
+
+#elif defined(__GLIBC__)
+
+// operator new of libstdc++ ends up in malloc() as well
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* pointer, size_t size);
+
+void* malloc(size_t size) {
+    allocations = allocations + 1;
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size) {
+    allocations = allocations + 1;
+    return __libc_calloc(count, size);
+}
+
+void* realloc(void* pointer, size_t size) {
+    allocations = allocations + 1;
+    return __libc_realloc(pointer, size);
+}
+}
+
+namespace {
+
+bool installCounter() {
+    return true;
+}
+
+} // namespace
+
+#else
+#error "test_scan_alloc needs AddressSanitizer or glibc to count allocations"
+#endif
+
+namespace {
+
+const int CYCLES = 1000;
+
+void addAPs(WiFiCredsSimDriver& sim) {
+    const WiFiCredsSimAP aps[] = {
+        {"MyHomeWiFi", "HomePassword123", {0x02, 0, 0, 0, 0, 1}, 1, -48, 900, 0, true},
+        {"MyHomeWiFi", "HomePassword123", {0x02, 0, 0, 0, 0, 2}, 6, -71, 900, 0, true},
+        {"OfficeNetwork", "OfficePassword456", {0x02, 0, 0, 0, 0, 3}, 11, -63, 900, 0, true},
+        {"GuestWiFi", "GuestPassword789", {0x02, 0, 0, 0, 0, 4}, 6, -80, 900, 0, true},
+        {"NeighbourNet", "NeighbourPassword", {0x02, 0, 0, 0, 0, 5}, 3, -55, 900, 0, true},
+        {"", "", {0x02, 0, 0, 0, 0, 6}, 9, -90, 900, 0, true}, // hidden network
+    };
+    for (const WiFiCredsSimAP& ap : aps) {
+        sim.addAP(ap);
+    }
+}
+
+/**
+ * @brief One scan cycle of the examples
+ * @return size_t Bytes of text produced, so the work cannot be optimised away
+ */
+size_t scanCycle(WiFiCredsSimDriver& sim) {
+    char line[WIFICREDS_SCAN_ENTRY_STRING_SIZE];
+    char bssid[WIFICREDS_BSSID_STRING_SIZE];
+    size_t produced = 0;
+
+    const int found = sim.scanNetworks();
+    for (int i = 0; i < found; i++) {
+        WiFiCredsScanEntry entry;
+        if (sim.scanResult(i, entry) && WiFiCredsFormat::scanEntry(entry, line, sizeof(line)) &&
+            WiFiCredsFormat::bssid(entry.bssid, bssid, sizeof(bssid))) {
+            produced += strlen(line) + strlen(bssid);
+        }
+    }
+
+    WiFiCredsCandidate candidates[4];
+    const size_t ranked = WiFiCredsScan::rank(sim, found, candidates, 4);
+
+    WiFiCredsScanEntry best;
+    if (WiFiCredsScan::find(sim, found, WiFiCreds::getSSID(), best) >= 0) {
+        produced += strlen(best.ssid);
+    }
+    return produced + ranked + strlen(WiFiCredsFormat::linkStatus(sim.status()));
+}
+
+void testCounterWorks() {
+    const unsigned long before = allocations;
+    int* volatile probe = new int(1);
+    delete probe;
+    CHECK(allocations > before);
+}
+
+void testScanCyclesDoNotAllocate() {
+    WiFiCredsSimDriver sim;
+    addAPs(sim);
+
+    // The first cycle may set up lazily initialised state outside the library
+    const size_t expected = scanCycle(sim);
+    CHECK(expected > 0);
+
+    const unsigned long before = allocations;
+    bool sameOutput = true;
+    for (int cycle = 0; cycle < CYCLES; cycle++) {
+        sameOutput = scanCycle(sim) == expected && sameOutput;
+    }
+    const unsigned long during = allocations - before;
+
+    CHECK(sameOutput);
+    CHECK(sim.scanCalls() == CYCLES + 1);
+    CHECK(during == 0);
+    printf("test_scan_alloc: %d scan cycles, %lu heap allocations\n", CYCLES, during);
+}
+
+} // namespace
+
+int main() {
+    CHECK(installCounter());
+    testCounterWorks();
+    testScanCyclesDoNotAllocate();
+    return WiFiCredsTest::result("test_scan_alloc");
+}
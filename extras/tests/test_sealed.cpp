@@ -0,0 +1,114 @@
+/**
+ * @file test_sealed.cpp
+ * @brief Host test of connecting with sealed passwords, with and without the key
+ * @author Rithik Krisna M
+ * @version 1.0.4
+ * @date 2025
+ *
+ * Built with fixtures/credentials_sealed.h, written by credgen --key with
+ * the key below. Without the key a sealed set must not start a connect at
+ * all: an empty password would join an open AP that copies the SSID.
+ */
+
+#include "WiFiCredsTest.h"
+#include <WiFiCreds.h>
+#include <WiFiCredsCipher.h>
+#include <WiFiCredsConnection.h>
+#include <WiFiCredsFastReconnect.h>
+#include <WiFiCredsSimDriver.h>
+#include <string.h>
+
+namespace {
+
+const uint8_t KEY[WIFICREDS_CIPHER_KEY_LENGTH] = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+    0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f
+};
+
+const uint8_t OFFICE_BSSID[6] = {0x02, 0, 0, 0, 0, 1};
+
+/**
+ * @brief The real office AP and an open one with the same SSID
+ */
+void addAPs(WiFiCredsSimDriver& sim) {
+    WiFiCredsSimAP office = {"OfficeNetwork", "OfficePassword456", {0x02, 0, 0, 0, 0, 1}, 6, -70, 800, 0, true};
+    WiFiCredsSimAP twin = {"OfficeNetwork", "", {0x02, 0, 0, 0, 0, 9}, 6, -80, 800, 0, true};
+    sim.addAP(office);
+    sim.addAP(twin);
+}
+
+WiFiCredsConnectionState settle(WiFiCredsSimDriver& sim, WiFiCredsConnection& connection) {
+    while (connection.poll() == WiFiCredsConnectionState::Connecting) {
+        sim.advance(100);
+    }
+    return connection.state();
+}
+
+void testConnectionWithoutKey() {
+    WiFiCredsCipher::clearKey();
+    const CredentialView office = WiFiCreds::resolve("office");
+    CHECK(office.sealed);
+
+    char key[WIFICREDS_PSK_HEX_SIZE];
+    CHECK(WiFiCreds::getConnectKey(office, key) == nullptr);
+
+    WiFiCredsSimDriver sim;
+    addAPs(sim);
+    WiFiCredsConnection connection(sim);
+    CHECK(!connection.connect("office"));
+    CHECK(!connection.connectIndex(office.index));
+    CHECK(sim.beginCalls() == 0);
+    CHECK(connection.state() == WiFiCredsConnectionState::Idle);
+
+    // Open sets still connect
+    WiFiCredsSimAP cafe = {"CafeOpen", "", {0x02, 0, 0, 0, 0, 3}, 1, -60, 800, 0, true};
+    sim.addAP(cafe);
+    CHECK(connection.connect("cafe"));
+    CHECK(settle(sim, connection) == WiFiCredsConnectionState::Connected);
+}
+
+void testConnectionWithKey() {
+    WiFiCredsCipher::setKey(KEY);
+    const CredentialView office = WiFiCreds::resolve("office");
+
+    char key[WIFICREDS_PSK_HEX_SIZE];
+    const char* password = WiFiCreds::getConnectKey(office, key);
+    CHECK(password != nullptr && strcmp(password, "OfficePassword456") == 0);
+
+    WiFiCredsSimDriver sim;
+    addAPs(sim);
+    WiFiCredsConnection connection(sim);
+    CHECK(connection.connect("office"));
+    CHECK(settle(sim, connection) == WiFiCredsConnectionState::Connected);
+
+    // Joined the real AP, not the open twin
+    uint8_t bssid[6];
+    CHECK(sim.bssid(bssid) && memcmp(bssid, OFFICE_BSSID, sizeof(bssid)) == 0);
+    WiFiCredsCipher::clearKey();
+}
+
+void testFastReconnect() {
+    const CredentialView office = WiFiCreds::resolve("office");
+    CHECK(WiFiCredsFastReconnect::save(office.index, OFFICE_BSSID, 6, 0, 0, 0, 0));
+
+    WiFiCredsSimDriver sim;
+    addAPs(sim);
+    WiFiCredsCipher::clearKey();
+    CHECK(!WiFiCredsFastReconnect::begin(sim));
+    CHECK(sim.beginCalls() == 0);
+
+    WiFiCredsCipher::setKey(KEY);
+    CHECK(WiFiCredsFastReconnect::begin(sim));
+    CHECK(sim.beginCalls() == 1);
+    WiFiCredsCipher::clearKey();
+    WiFiCredsFastReconnect::invalidate();
+}
+
+} // namespace
+
+int main() {
+    testConnectionWithoutKey();
+    testConnectionWithKey();
+    testFastReconnect();
+    return WiFiCredsTest::result("test_sealed");
+}
@@ -0,0 +1,114 @@
+/**
+ * @file test_sim_driver.cpp
+ * @brief Host test of WiFiCredsSimDriver against a credgen-generated table
+ * @author Rithik Krisna M
+ * @version 1.0.4
+ * @date 2025
+ *
+ * Built with fixtures/credentials_pmk.h, in which every WPA2 set carries a
+ * precomputed PMK, so WiFiCredsConnection hands the driver a 64-hex PSK
+ * instead of the passphrase.
+ */
+
+#include "WiFiCredsTest.h"
+#include <WiFiCreds.h>
+#include <WiFiCredsConnection.h>
+#include <WiFiCredsSimDriver.h>
+#include <ctype.h>
+#include <string.h>
+
+namespace {
+
+WiFiCredsSimAP makeAP(const char* ssid, const char* password, uint8_t id) {
+    WiFiCredsSimAP ap = {ssid, password, {0x02, 0, 0, 0, 0, id}, 6, -60, 800, 0, true};
+    return ap;
+}
+
+/**
+ * @brief Start a connect on the driver and run the virtual clock until it settles
+ */
+WiFiCredsLinkStatus connectRaw(WiFiCredsSimDriver& sim, const char* ssid, const char* password) {
+    sim.begin(ssid, password);
+    for (int i = 0; i < 100 && sim.status() == WiFiCredsLinkStatus::Connecting; i++) {
+        sim.advance(100);
+    }
+    return sim.status();
+}
+
+/**
+ * @brief Connect through WiFiCredsConnection and poll until the attempt finishes
+ */
+WiFiCredsConnectionState connectNamed(WiFiCredsSimDriver& sim, const char* name) {
+    WiFiCredsConnection connection(sim);
+    connection.connect(name, 10000);
+    while (connection.poll() == WiFiCredsConnectionState::Connecting) {
+        sim.advance(100);
+    }
+    return connection.state();
+}
+
+void testPassphraseAndPsk() {
+    WiFiCredsSimDriver sim;
+    sim.addAP(makeAP("OfficeNetwork", "OfficePassword456", 1));
+
+    CHECK(connectRaw(sim, "OfficeNetwork", "OfficePassword456") == WiFiCredsLinkStatus::Connected);
+    CHECK(connectRaw(sim, "OfficeNetwork", "WrongPassword") == WiFiCredsLinkStatus::ConnectFailed);
+    CHECK(connectRaw(sim, "OfficeNetwork", "") == WiFiCredsLinkStatus::ConnectFailed);
+
+    char psk[WIFICREDS_PSK_HEX_SIZE];
+    CHECK(WiFiCreds::getPSKHex("office", psk));
+    CHECK(connectRaw(sim, "OfficeNetwork", psk) == WiFiCredsLinkStatus::Connected);
+
+    // Hex digits are case-insensitive, any other PSK is wrong
+    for (char* c = psk; *c != '\0'; ++c) {
+        *c = static_cast<char>(toupper(*c));
+    }
+    CHECK(connectRaw(sim, "OfficeNetwork", psk) == WiFiCredsLinkStatus::Connected);
+    psk[0] = (psk[0] == '0') ? '1' : '0';
+    CHECK(connectRaw(sim, "OfficeNetwork", psk) == WiFiCredsLinkStatus::ConnectFailed);
+}
+
+void testApConfiguredWithPsk() {
+    char psk[WIFICREDS_PSK_HEX_SIZE];
+    CHECK(WiFiCreds::getPSKHex("mobile", psk));
+
+    WiFiCredsSimDriver sim;
+    sim.addAP(makeAP("MyPhoneHotspot", psk, 2));
+    CHECK(connectRaw(sim, "MyPhoneHotspot", "MobilePassword") == WiFiCredsLinkStatus::Connected);
+    CHECK(connectRaw(sim, "MyPhoneHotspot", "OtherPassword") == WiFiCredsLinkStatus::ConnectFailed);
+}
+
+void testOpenNetwork() {
+    WiFiCredsSimDriver sim;
+    sim.addAP(makeAP("CafeOpen", "", 3));
+    CHECK(connectRaw(sim, "CafeOpen", nullptr) == WiFiCredsLinkStatus::Connected);
+    CHECK(connectRaw(sim, "CafeOpen", "SomePassword") == WiFiCredsLinkStatus::ConnectFailed);
+}
+
+void testConnectionWithGeneratedTable() {
+    const CredentialView office = WiFiCreds::resolve("office");
+    CHECK(office.pmk != nullptr);
+
+    WiFiCredsSimDriver sim;
+    sim.addAP(makeAP("OfficeNetwork", "OfficePassword456", 1));
+    sim.addAP(makeAP("MyPhoneHotspot", "MobilePassword", 2));
+    sim.addAP(makeAP("CafeOpen", "", 3));
+
+    CHECK(connectNamed(sim, "office") == WiFiCredsConnectionState::Connected);
+    CHECK(connectNamed(sim, "mobile") == WiFiCredsConnectionState::Connected);
+    CHECK(connectNamed(sim, "cafe") == WiFiCredsConnectionState::Connected);
+
+    // A changed password on the AP is noticed, although its PSK was cached
+    sim.ap(0)->password = "NewOfficePassword";
+    CHECK(connectNamed(sim, "office") == WiFiCredsConnectionState::Idle);
+}
+
+} // namespace
+
+int main() {
+    testPassphraseAndPsk();
+    testApConfiguredWithPsk();
+    testOpenNetwork();
+    testConnectionWithGeneratedTable();
+    return WiFiCredsTest::result("test_sim_driver");
+}
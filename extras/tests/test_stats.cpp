@@ -0,0 +1,64 @@
+/**
+ * @file test_stats.cpp
+ * @brief Host test of the learned connect timeouts in WiFiCredsStats
+ * @author Rithik Krisna M
+ * @version 1.0.4
+ * @date 2025
+ *
+ * Runs against src/credentials.h (home, office, guest, mobile).
+ */
+
+#include "WiFiCredsTest.h"
+#include <WiFiCredsStats.h>
+
+namespace {
+
+void testLearnedTimeout() {
+    WiFiCredsStats::reset();
+    CHECK(WiFiCredsStats::timeout(0) == WIFICREDS_CONNECT_TIMEOUT);
+
+    for (int i = 0; i < 10; i++) {
+        WiFiCredsStats::recordSuccess(0, 800);
+    }
+    CHECK(WiFiCredsStats::timeout(0) == WIFICREDS_STATS_MIN_TIMEOUT);
+
+    // A slower network raises its own timeout through the timeouts it causes
+    const uint32_t before = WiFiCredsStats::timeout(0);
+    WiFiCredsStats::recordTimeout(0, 15000);
+    CHECK(WiFiCredsStats::timeout(0) > before);
+    CHECK(WiFiCredsStats::timeout(0) <= WIFICREDS_CONNECT_TIMEOUT);
+
+    // Out of range indexes keep the default
+    CHECK(WiFiCredsStats::timeout(WiFiCreds::getCredentialCount()) == WIFICREDS_CONNECT_TIMEOUT);
+}
+
+void testFailingSetWithoutSamples() {
+    WiFiCredsStats::reset();
+
+    uint32_t previous = WiFiCredsStats::timeout(1);
+    bool shrinking = true;
+    for (int i = 0; i < 50; i++) {
+        WiFiCredsStats::recordFailure(1);
+        const uint32_t current = WiFiCredsStats::timeout(1);
+        shrinking = shrinking && current <= previous;
+        previous = current;
+    }
+    CHECK(shrinking);
+    CHECK(previous < WIFICREDS_STATS_FAILING_TIMEOUT + 500);
+    CHECK(previous >= WIFICREDS_STATS_FAILING_TIMEOUT);
+
+    // Other sets are unaffected
+    CHECK(WiFiCredsStats::timeout(2) == WIFICREDS_CONNECT_TIMEOUT);
+
+    // One success switches to the learned latency
+    WiFiCredsStats::recordSuccess(1, 3000);
+    CHECK(WiFiCredsStats::timeout(1) == 3000 * 2 + WIFICREDS_STATS_TIMEOUT_MARGIN);
+}
+
+} // namespace
+
+int main() {
+    testLearnedTimeout();
+    testFailingSetWithoutSamples();
+    return WiFiCredsTest::result("test_stats");
+}
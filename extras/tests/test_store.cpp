@@ -0,0 +1,154 @@
+/**
+ * @file test_store.cpp
+ * @brief Host test of WiFiCredsStore on a RAM-backed storage region
+ * @author Rithik Krisna M
+ * @version 1.0.4
+ * @date 2025
+ *
+ * Runs against src/credentials.h (home, office, guest, mobile).
+ */
+
+#include "WiFiCredsTest.h"
+#include <WiFiCredsFileStorage.h>
+#include <WiFiCredsStore.h>
+#include <stdio.h>
+#include <string.h>
+
+namespace {
+
+/**
+ * @brief Storage region in RAM that counts its reads
+ */
+class RamStorage : public WiFiCredsStorage {
+public:
+    RamStorage() : reads(0) { memset(_data, 0xFF, sizeof(_data)); }
+
+    size_t size() override { return sizeof(_data); }
+
+    bool read(size_t offset, void* data, size_t length) override {
+        if (offset > sizeof(_data) || length > sizeof(_data) - offset) {
+            return false;
+        }
+        reads++;
+        memcpy(data, _data + offset, length);
+        return true;
+    }
+
+    bool write(size_t offset, const void* data, size_t length) override {
+        if (offset > sizeof(_data) || length > sizeof(_data) - offset) {
+            return false;
+        }
+        memcpy(_data + offset, data, length);
+        return true;
+    }
+
+    bool commit() override { return true; }
+
+    size_t reads;
+
+private:
+    uint8_t _data[2048];
+};
+
+void testPutResolveRemove() {
+    RamStorage storage;
+    WiFiCredsStore store(storage);
+    CHECK(store.begin());
+
+    CHECK(store.put("office", "OfficeNetwork", "NewOfficePassword"));
+    CHECK(store.put("lab", "LabNetwork", "LabPassword1"));
+    CHECK(store.getCredentialCount() == 2);
+
+    CredentialView office = store.resolve("office");
+    CHECK(office.resolution == CredentialResolution::Found);
+    CHECK(strcmp(office.password, "NewOfficePassword") == 0);
+
+    WiFiCredsCopy copy;
+    CHECK(store.resolveInto("lab", copy));
+    CHECK(strcmp(copy.ssid, "LabNetwork") == 0);
+
+    CHECK(store.remove("office"));
+    CHECK(strcmp(store.resolve("office").password, "OfficePassword456") == 0);
+    CHECK(!store.remove("office"));
+}
+
+/**
+ * @brief Names longer than any stored name are "not found" without a record read
+ *
+ * Used to read the record header plus strlen(name) bytes into a buffer sized
+ * for the longest storable name whenever the name's 8-bit tag matched an
+ * occupied slot: a stack overflow reachable with any name from serial input.
+ */
+void testOverlongNames() {
+    RamStorage storage;
+    WiFiCredsStore store(storage);
+    CHECK(store.begin());
+
+    // Occupy half of the index, so most probes pass occupied slots
+    char name[WIFICREDS_NAME_BUFFER_SIZE];
+    for (int i = 0; i < WIFICREDS_STORE_MAX_ENTRIES; i++) {
+        snprintf(name, sizeof(name), "stored-%02d", i);
+        CHECK(store.put(name, "StoredNetwork", "StoredPassword"));
+    }
+
+    char longName[201];
+    bool noReads = true;
+    bool notFound = true;
+    for (int variant = 0; variant < 1000; variant++) {
+        memset(longName, 'n', 200);
+        longName[200] = '\0';
+        snprintf(longName, sizeof(longName), "%04d", variant);
+        longName[4] = 'n';
+
+        const size_t readsBefore = storage.reads;
+        notFound = notFound && !store.isStored(longName) && !store.remove(longName);
+        noReads = noReads && storage.reads == readsBefore;
+
+        // The static tier falls back to the default set, which the store does not replace
+        CredentialView view = store.resolve(longName);
+        notFound = notFound && view.resolution == CredentialResolution::Fallback && strcmp(view.name, "home") == 0;
+        notFound = notFound && !store.hasCredential(longName);
+
+        WiFiCredsCopy copy;
+        notFound = notFound && store.resolveInto(longName, copy) && copy.resolution == CredentialResolution::Fallback;
+    }
+    CHECK(notFound);
+    CHECK(noReads);
+    CHECK(!store.put(longName, "LongNetwork", "LongPassword"));
+    CHECK(store.getCredentialCount() == WIFICREDS_STORE_MAX_ENTRIES);
+}
+
+/**
+ * @brief The file is opened by begin() only, never lazily from a reading task
+ */
+void testFileStorage() {
+    char path[] = "build/test_store.log";
+    ::remove(path);
+
+    WiFiCredsFileStorage storage(path, 1024);
+    uint8_t byte = 0;
+    CHECK(storage.size() == 0);
+    CHECK(!storage.read(0, &byte, 1));
+
+    WiFiCredsStore store(storage);
+    CHECK(store.begin());
+    CHECK(storage.size() == 1024);
+    CHECK(store.put("lab", "LabNetwork", "LabPassword1"));
+
+    // A second store over the same file replays the log
+    WiFiCredsFileStorage reopened(path, 1024);
+    WiFiCredsStore again(reopened);
+    CHECK(again.begin());
+    WiFiCredsCopy copy;
+    CHECK(again.resolveInto("lab", copy) && strcmp(copy.password, "LabPassword1") == 0);
+    ::remove(path);
+}
+
+} // namespace
+
+int main() {
+    testPutResolveRemove();
+    testOverlongNames();
+    testFileStorage();
+    return WiFiCredsTest::result("test_store");
+}
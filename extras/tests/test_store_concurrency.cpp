@@ -0,0 +1,193 @@
+/**
+ * @file test_store_concurrency.cpp
+ * @brief Host test of lock-free WiFiCredsStore reads against a concurrent writer
+ * @author Rithik Krisna M
+ * @version 1.0.4
+ * @date 2025
+ *
+ * One writer thread keeps replacing a few sets, which also compacts the log
+ * over and over, while several reader threads copy them out with
+ * resolveInto(). Every copy must be one whole version of a set: SSID and
+ * password are written with the same version number, so a torn read shows
+ * up as a mismatch. The read latency is reported as a percentile summary.
+ *
+ * Run it under ThreadSanitizer with "make tsan".
+ */
+
+#include "WiFiCredsTest.h"
+#include <WiFiCredsStore.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const int READERS = 4;
+const int NAMES = 4;
+const int RUN_MS = 500;
+
+/**
+ * @brief Storage region in RAM that may be read while it is written
+ *
+ * WiFiCredsStorage requires read() to be safe concurrently with write();
+ * relaxed atomic bytes are the RAM equivalent of a file read with pread().
+ */
+class SharedRamStorage : public WiFiCredsStorage {
+public:
+    SharedRamStorage() {
+        for (size_t i = 0; i < sizeof(_data) / sizeof(_data[0]); i++) {
+            _data[i].store(0xFF, std::memory_order_relaxed);
+        }
+    }
+
+    size_t size() override { return sizeof(_data) / sizeof(_data[0]); }
+
+    bool read(size_t offset, void* data, size_t length) override {
+        if (offset > size() || length > size() - offset) {
+            return false;
+        }
+        uint8_t* bytes = static_cast<uint8_t*>(data);
+        for (size_t i = 0; i < length; i++) {
+            bytes[i] = _data[offset + i].load(std::memory_order_relaxed);
+        }
+        return true;
+    }
+
+    bool write(size_t offset, const void* data, size_t length) override {
+        if (offset > size() || length > size() - offset) {
+            return false;
+        }
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < length; i++) {
+            _data[offset + i].store(bytes[i], std::memory_order_relaxed);
+        }
+        return true;
+    }
+
+    bool commit() override { return true; }
+
+private:
+    std::atomic<uint8_t> _data[1024];
+};
+
+void nameOf(int n, char (&name)[WIFICREDS_NAME_BUFFER_SIZE]) {
+    snprintf(name, sizeof(name), "lab-%d", n);
+}
+
+bool putVersion(WiFiCredsStore& store, int n, unsigned version) {
+    char name[WIFICREDS_NAME_BUFFER_SIZE];
+    char ssid[WIFICREDS_SSID_BUFFER_SIZE];
+    char password[WIFICREDS_PASSWORD_BUFFER_SIZE];
+    nameOf(n, name);
+    snprintf(ssid, sizeof(ssid), "LabNetwork-%d-%u", n, version);
+    snprintf(password, sizeof(password), "LabPassword-%d-%u", n, version);
+    return store.put(name, ssid, password);
+}
+
+/**
+ * @brief A copy is consistent if SSID and password carry the same set and version
+ */
+bool consistent(const WiFiCredsCopy& copy, int n) {
+    int ssidSet = -1;
+    int passwordSet = -2;
+    unsigned ssidVersion = 0;
+    unsigned passwordVersion = 1;
+    char expectedName[WIFICREDS_NAME_BUFFER_SIZE];
+    nameOf(n, expectedName);
+    return copy.resolution == CredentialResolution::Found && strcmp(copy.name, expectedName) == 0 &&
+           sscanf(copy.ssid, "LabNetwork-%d-%u", &ssidSet, &ssidVersion) == 2 &&
+           sscanf(copy.password, "LabPassword-%d-%u", &passwordSet, &passwordVersion) == 2 &&
+           ssidSet == n && passwordSet == n && ssidVersion == passwordVersion;
+}
+
+void testReadersAgainstWriter() {
+    SharedRamStorage storage;
+    WiFiCredsStore store(storage);
+    CHECK(store.begin());
+    for (int n = 0; n < NAMES; n++) {
+        CHECK(putVersion(store, n, 0));
+    }
+    const uint32_t firstGeneration = store.generation();
+
+    std::atomic<bool> running(true);
+    std::atomic<bool> writesOk(true);
+    std::atomic<unsigned> writes(0);
+    std::atomic<unsigned> tornReads(0);
+    std::vector<std::vector<uint32_t>> latencies(READERS);
+
+    std::thread writer([&] {
+        unsigned version = 1;
+        const auto stop = std::chrono::steady_clock::now() + std::chrono::milliseconds(RUN_MS);
+        while (std::chrono::steady_clock::now() < stop) {
+            if (!putVersion(store, static_cast<int>(version % NAMES), version)) {
+                writesOk = false;
+            }
+            version++;
+            writes++;
+        }
+        running = false;
+    });
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < READERS; r++) {
+        readers.emplace_back([&, r] {
+            std::vector<uint32_t>& samples = latencies[r];
+            WiFiCredsCopy copy;
+            char name[WIFICREDS_NAME_BUFFER_SIZE];
+            for (int i = 0; running; i++) {
+                const int n = (i + r) % NAMES;
+                nameOf(n, name);
+                const auto start = std::chrono::steady_clock::now();
+                const bool found = store.resolveInto(name, copy);
+                const auto end = std::chrono::steady_clock::now();
+                samples.push_back(static_cast<uint32_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()));
+                if (!found || !consistent(copy, n)) {
+                    tornReads++;
+                }
+            }
+        });
+    }
+
+    writer.join();
+    for (std::thread& reader : readers) {
+        reader.join();
+    }
+
+    std::vector<uint32_t> all;
+    for (const std::vector<uint32_t>& samples : latencies) {
+        all.insert(all.end(), samples.begin(), samples.end());
+    }
+    std::sort(all.begin(), all.end());
+    const uint32_t compactions = store.generation() - firstGeneration;
+
+    CHECK(writesOk);
+    CHECK(tornReads == 0);
+    CHECK(compactions > 0);
+    CHECK(all.size() > 0);
+    if (!all.empty()) {
+        printf("test_store_concurrency: %zu reads by %d readers, %u writes, %u compactions\n",
+               all.size(), READERS, writes.load(), compactions);
+        printf("test_store_concurrency: read latency ns p50 %u, p99 %u, p99.9 %u, max %u\n",
+               all[all.size() / 2], all[all.size() * 99 / 100], all[all.size() * 999 / 1000], all.back());
+    }
+
+    // Every set ends at its last version
+    for (int n = 0; n < NAMES; n++) {
+        WiFiCredsCopy copy;
+        char name[WIFICREDS_NAME_BUFFER_SIZE];
+        nameOf(n, name);
+        CHECK(store.resolveInto(name, copy) && consistent(copy, n));
+    }
+}
+
+} // namespace
+
+int main() {
+    testReadersAgainstWriter();
+    return WiFiCredsTest::result("test_store_concurrency");
+}
@@ -7,78 +7,408 @@
  */
 
 #include "WiFiCreds.h"
-#include "credentials.h" // Contains actual SSID and password definitions
-#include <string.h>     // Required for strcmp and strlen
+#include "WiFiCredsTable.h" // credentials.h, or WIFICREDS_CREDENTIALS_HEADER
+#include "WiFiCredsCipher.h"
+#include "WiFiCredsIndex.h"
+#include "WiFiCredsPMK.h"
+#include <string.h>     // Required for strcmp and memcpy
+
+// credentials.h defines WIFICREDS_USE_PROGMEM to keep the table and its strings in flash
+#if defined(WIFICREDS_USE_PROGMEM) && WIFICREDS_USE_PROGMEM
+#define WIFICREDS_TABLE_IN_FLASH 1
+#else
+#define WIFICREDS_TABLE_IN_FLASH 0
+#endif
+
+// Lookups in flash are linear, or a binary search if the names are sorted; the hash
+// indexes would otherwise be copied to SRAM on AVR/ESP8266
+#define WIFICREDS_USE_INDEX (WIFICREDS_HAS_NAME_INDEX && !WIFICREDS_TABLE_IN_FLASH)
+
+// credgen sorts every set after the default by name, which turns the linear scan into a binary search
+#if defined(WIFICREDS_SORTED_NAMES) && WIFICREDS_SORTED_NAMES
+#define WIFICREDS_NAMES_SORTED 1
+#else
+#define WIFICREDS_NAMES_SORTED 0
+#endif
+
+// credgen also writes the hash indexes, which large tables could not afford to build with constexpr
+#if WIFICREDS_USE_INDEX && defined(WIFICREDS_PRECOMPUTED_INDEX) && WIFICREDS_PRECOMPUTED_INDEX
+#define WIFICREDS_INDEX_IN_HEADER 1
+#else
+#define WIFICREDS_INDEX_IN_HEADER 0
+#endif
+
+#if !defined(ARDUINO)
+// Host builds have a single address space
+#define memcpy_P memcpy
+#define strcmp_P strcmp
+#define strlen_P strlen
+#endif
+
+namespace {
+
+// Divide and conquer keeps the constexpr recursion depth logarithmic (C++11 friendly)
+template <size_t N>
+constexpr bool allNamed(const CredentialSet (&sets)[N], size_t first, size_t last) {
+    return (last - first == 0) ? true
+         : (last - first == 1) ? sets[first].name != nullptr
+         : allNamed(sets, first, first + (last - first) / 2) && allNamed(sets, first + (last - first) / 2, last);
+}
+
+// Stored lengths must match the strings, which catches entries not declared with WIFICREDS_SET
+// (a sealed password is binary and its length comes from the array size instead)
+template <size_t N>
+constexpr bool lengthsMatch(const CredentialSet (&sets)[N], size_t first, size_t last) {
+    return (last - first == 0) ? true
+         : (last - first == 1) ? (sets[first].ssidLength == WiFiCredsStrLen(sets[first].ssid) &&
+                                  (sets[first].sealed ||
+                                   sets[first].passwordLength == WiFiCredsStrLen(sets[first].password)))
+         : lengthsMatch(sets, first, first + (last - first) / 2) && lengthsMatch(sets, first + (last - first) / 2, last);
+}
+
+#if WIFICREDS_NAMES_SORTED
+// Byte-wise like strcmp; the recursion depth is bounded by the name length
+constexpr int compareNames(const char* a, const char* b) {
+    return (*a != *b || *a == '\0') ? static_cast<int>(static_cast<uint8_t>(*a)) - static_cast<uint8_t>(*b)
+                                    : compareNames(a + 1, b + 1);
+}
+
+// Each name from index @p first + 1 on must be greater than its predecessor, which also rules out duplicates
+template <size_t N>
+constexpr bool namesAscending(const CredentialSet (&sets)[N], size_t first, size_t last) {
+    return (last - first <= 1) ? true
+         : (last - first == 2) ? compareNames(sets[first].name, sets[first + 1].name) < 0
+         : namesAscending(sets, first, first + (last - first) / 2 + 1) &&
+           namesAscending(sets, first + (last - first) / 2, last);
+}
+#endif
+
+// Everything before the terminator entry, known at compile time
+constexpr size_t CREDENTIAL_COUNT = WiFiCredsSetCount(CREDENTIAL_SETS);
+
+static_assert(CREDENTIAL_SETS[CREDENTIAL_COUNT].name == nullptr,
+              "CREDENTIAL_SETS must end with a terminator entry whose name is nullptr");
+static_assert(allNamed(CREDENTIAL_SETS, 0, CREDENTIAL_COUNT),
+              "CREDENTIAL_SETS has an entry with a nullptr name before the terminator");
+static_assert(lengthsMatch(CREDENTIAL_SETS, 0, CREDENTIAL_COUNT),
+              "CREDENTIAL_SETS entry lengths do not match its strings; declare entries with WIFICREDS_SET()");
+static_assert(CREDENTIAL_COUNT <= WIFICREDS_MAX_CREDENTIALS,
+              "CREDENTIAL_SETS has more entries than WIFICREDS_MAX_CREDENTIALS");
+
+// Small tables are scanned; the hash costs more than a few compares there
+constexpr bool INDEXED = WIFICREDS_USE_INDEX && CREDENTIAL_COUNT >= WIFICREDS_INDEX_MIN_SETS;
+
+#if WIFICREDS_NAMES_SORTED
+// Entry 0 is the default set and keeps its place
+static_assert(CREDENTIAL_COUNT < 2 || namesAscending(CREDENTIAL_SETS, 1, CREDENTIAL_COUNT),
+              "WIFICREDS_SORTED_NAMES is set but CREDENTIAL_SETS names after the first are not sorted and unique");
+#endif
+
+#if WIFICREDS_INDEX_IN_HEADER
+// Tables written by credgen. Every name is checked for tables up to
+// INDEX_CHECK_SAMPLES entries; larger ones are sampled at an even stride so
+// the check stays within the compiler's constexpr budget. Any entry added,
+// removed or moved by hand shifts the sampled indices and fails the check,
+// and lookups compare the name anyway, so a name the sample misses can only
+// go unfound, never resolve to the wrong set.
+constexpr size_t INDEX_CHECK_SAMPLES = 4096;
+
+template <size_t M, size_t N>
+constexpr bool indexFindsNames(const WiFiCredsIndex::NameIndex<M>& index, const CredentialSet (&sets)[N],
+                               size_t stride, size_t first, size_t last) {
+    return (last - first == 0) ? true
+         : (last - first == 1) ? index.candidate(sets[first * stride].name) == first * stride
+         : indexFindsNames(index, sets, stride, first, first + (last - first) / 2) &&
+           indexFindsNames(index, sets, stride, first + (last - first) / 2, last);
+}
+
+constexpr size_t NAME_TABLE_SIZE = sizeof(CREDENTIAL_NAME_INDEX.slots) / sizeof(CREDENTIAL_NAME_INDEX.slots[0]);
+constexpr size_t SSID_TABLE_SIZE = sizeof(CREDENTIAL_SSID_INDEX.slots) / sizeof(CREDENTIAL_SSID_INDEX.slots[0]);
+constexpr size_t INDEX_CHECK_STRIDE = (CREDENTIAL_COUNT + INDEX_CHECK_SAMPLES - 1) / INDEX_CHECK_SAMPLES;
+
+static_assert(CREDENTIAL_COUNT < WiFiCredsIndex::EMPTY_SLOT, "Too many credential sets for the name index");
+static_assert(NAME_TABLE_SIZE == WiFiCredsIndex::tableSizeFor(CREDENTIAL_COUNT) &&
+              SSID_TABLE_SIZE == WiFiCredsIndex::tableSizeFor(CREDENTIAL_COUNT * 2) &&
+              (CREDENTIAL_COUNT == 0 ||
+               (indexFindsNames(CREDENTIAL_NAME_INDEX, CREDENTIAL_SETS, INDEX_CHECK_STRIDE, 0,
+                                (CREDENTIAL_COUNT - 1) / INDEX_CHECK_STRIDE + 1) &&
+                CREDENTIAL_NAME_INDEX.candidate(CREDENTIAL_SETS[CREDENTIAL_COUNT - 1].name) == CREDENTIAL_COUNT - 1)),
+              "The index in credentials.h does not match CREDENTIAL_SETS; regenerate the file with credgen");
+
+constexpr const WiFiCredsIndex::NameIndex<NAME_TABLE_SIZE>& NAME_INDEX = CREDENTIAL_NAME_INDEX;
+constexpr const WiFiCredsIndex::SsidIndex<SSID_TABLE_SIZE>& SSID_INDEX = CREDENTIAL_SSID_INDEX;
+#elif WIFICREDS_USE_INDEX
+// Perfect-hash index over CREDENTIAL_SETS names, built entirely at compile time
+// (over no sets, one slot each, when the table is scanned instead)
+constexpr size_t INDEXED_COUNT = INDEXED ? CREDENTIAL_COUNT : 0;
+constexpr size_t NAME_TABLE_SIZE = WiFiCredsIndex::tableSizeFor(INDEXED_COUNT);
+
+static_assert(CREDENTIAL_COUNT < WiFiCredsIndex::EMPTY_SLOT, "Too many credential sets for the name index");
+
+constexpr WiFiCredsIndex::NameIndex<NAME_TABLE_SIZE> NAME_INDEX =
+    WiFiCredsIndex::buildNameIndex<NAME_TABLE_SIZE>(CREDENTIAL_SETS, INDEXED_COUNT);
+
+// SSID table kept at most half full so probe sequences stay short
+constexpr size_t SSID_TABLE_SIZE = WiFiCredsIndex::tableSizeFor(INDEXED_COUNT * 2);
+
+constexpr WiFiCredsIndex::SsidIndex<SSID_TABLE_SIZE> SSID_INDEX =
+    WiFiCredsIndex::buildSsidIndex<SSID_TABLE_SIZE>(CREDENTIAL_SETS, INDEXED_COUNT);
+#endif
+
+#if WIFICREDS_TABLE_IN_FLASH
+// Strings must fit the RAM buffers that accessors copy them into
+template <size_t N>
+constexpr bool fitsBuffers(const CredentialSet (&sets)[N], size_t first, size_t last) {
+    return (last - first == 0) ? true
+         : (last - first == 1) ? (WiFiCredsStrLen(sets[first].name) < WIFICREDS_NAME_BUFFER_SIZE &&
+                                  sets[first].ssidLength < WIFICREDS_SSID_BUFFER_SIZE &&
+                                  sets[first].passwordLength < WIFICREDS_PASSWORD_BUFFER_SIZE)
+         : fitsBuffers(sets, first, first + (last - first) / 2) && fitsBuffers(sets, first + (last - first) / 2, last);
+}
+
+static_assert(fitsBuffers(CREDENTIAL_SETS, 0, CREDENTIAL_COUNT),
+              "A name, SSID or password is too long for PROGMEM mode; raise WIFICREDS_NAME_BUFFER_SIZE for long names");
+
+// Shared RAM copies handed out by the accessors; one set replaces a copy of the whole table
+char nameBuffer[WIFICREDS_NAME_BUFFER_SIZE];
+char ssidBuffer[WIFICREDS_SSID_BUFFER_SIZE];
+char passwordBuffer[WIFICREDS_PASSWORD_BUFFER_SIZE];
+uint8_t pmkBuffer[WIFICREDS_PMK_LENGTH];
+
+CredentialSet loadSet(const CredentialSet* cred) {
+    CredentialSet set;
+    memcpy_P(&set, cred, sizeof(set));
+    return set;
+}
+
+const char* copyOut(const char* stored, size_t length, char* buffer) {
+    if (stored == nullptr) {
+        return nullptr;
+    }
+    memcpy_P(buffer, stored, length);
+    buffer[length] = '\0';
+    return buffer;
+}
+
+const char* nameOf(const CredentialSet& set) {
+    return copyOut(set.name, (set.name != nullptr) ? strlen_P(set.name) : 0, nameBuffer);
+}
+
+const char* ssidOf(const CredentialSet& set) {
+    return copyOut(set.ssid, set.ssidLength, ssidBuffer);
+}
+
+const char* passwordOf(const CredentialSet& set) {
+    return set.sealed ? nullptr : copyOut(set.password, set.passwordLength, passwordBuffer);
+}
+
+const uint8_t* pmkOf(const CredentialSet& set) {
+    if (set.pmk == nullptr) {
+        return nullptr;
+    }
+    memcpy_P(pmkBuffer, set.pmk, WIFICREDS_PMK_LENGTH);
+    return pmkBuffer;
+}
+#else
+const CredentialSet& loadSet(const CredentialSet* cred) {
+    return *cred;
+}
+
+const char* nameOf(const CredentialSet& set) {
+    return set.name;
+}
+
+const char* ssidOf(const CredentialSet& set) {
+    return set.ssid;
+}
+
+const char* passwordOf(const CredentialSet& set) {
+    return set.sealed ? nullptr : set.password;
+}
+
+const uint8_t* pmkOf(const CredentialSet& set) {
+    return set.pmk;
+}
+#endif
+
+/**
+ * @brief Compare a RAM string with a string stored in the credential table
+ */
+int compareStored(const char* value, const char* stored) {
+#if WIFICREDS_TABLE_IN_FLASH
+    return strcmp_P(value, stored);
+#else
+    return strcmp(value, stored);
+#endif
+}
+
+/**
+ * @brief Copy the SSID of a set into @p buffer
+ */
+bool copySSIDOf(const CredentialSet& set, char* buffer, size_t size) {
+    if (set.ssid == nullptr || size <= set.ssidLength) {
+        return false;
+    }
+    memcpy_P(buffer, set.ssid, set.ssidLength);
+    buffer[set.ssidLength] = '\0';
+    return true;
+}
+
+/**
+ * @brief Decrypt the password of a sealed set into @p buffer
+ */
+bool unsealPassword(const CredentialSet& set, char* buffer, size_t size) {
+    if (set.password == nullptr || set.passwordLength > WIFICREDS_PASSWORD_BUFFER_SIZE - 1) {
+        return false;
+    }
+    // Nonce and ciphertext are copied out of flash first (a no-op copy where flash is mapped)
+    uint8_t sealed[WIFICREDS_SEALED_NONCE_LENGTH + WIFICREDS_PASSWORD_BUFFER_SIZE - 1];
+    memcpy_P(sealed, set.password, WIFICREDS_SEALED_NONCE_LENGTH + set.passwordLength);
+    const bool unsealed = WiFiCredsCipher::unseal(sealed, set.passwordLength, buffer, size);
+    WiFiCredsCipher::wipe(sealed, sizeof(sealed));
+    return unsealed;
+}
+
+#if WIFICREDS_PMK_CACHE_SIZE > 0
+// PMKs derived on the device, so each set pays for PBKDF2 at most once per boot.
+// Not synchronised: getPMK() may only be called from one task at a time.
+struct PMKCacheEntry {
+    const CredentialSet* cred;
+    uint8_t pmk[WIFICREDS_PMK_LENGTH];
+};
+
+PMKCacheEntry pmkCache[WIFICREDS_PMK_CACHE_SIZE];
+size_t pmkCacheNext = 0;
+#endif
+
+} // namespace
 
 // ===== CORE CREDENTIAL METHODS =====
 
 const char* WiFiCreds::getSSID(const char* name) {
-    const CredentialSet* cred = (name != nullptr) ? findCredential(name) : getDefaultCredential();
-    
-    // If named credential not found, fall back to default
-    if (cred == nullptr && name != nullptr) {
-        cred = getDefaultCredential();
-    }
-    
-    return (cred != nullptr) ? cred->ssid : nullptr;
+    CredentialResolution resolution;
+    const CredentialSet* cred = resolveCredential(name, resolution);
+    return (cred != nullptr) ? ssidOf(loadSet(cred)) : nullptr;
 }
 
 const char* WiFiCreds::getPassword(const char* name) {
-    const CredentialSet* cred = (name != nullptr) ? findCredential(name) : getDefaultCredential();
+    CredentialResolution resolution;
+    const CredentialSet* cred = resolveCredential(name, resolution);
+    return (cred != nullptr) ? passwordOf(loadSet(cred)) : nullptr;
+}
+
+bool WiFiCreds::isValid(const char* name) {
+    CredentialResolution resolution;
+    const CredentialSet* cred = resolveCredential(name, resolution);
     
-    // If named credential not found, fall back to default
-    if (cred == nullptr && name != nullptr) {
-        cred = getDefaultCredential();
+    if (cred == nullptr) {
+        return false;
     }
     
-    return (cred != nullptr) ? cred->password : nullptr;
+    // A zero length also covers nullptr strings
+    const CredentialSet& set = loadSet(cred);
+    return set.ssidLength > 0 && set.passwordLength > 0;
 }
 
-bool WiFiCreds::isValid(const char* name) {
-    const char* ssid = getSSID(name);
-    const char* password = getPassword(name);
+size_t WiFiCreds::getSSIDLength(const char* name) {
+    CredentialResolution resolution;
+    const CredentialSet* cred = resolveCredential(name, resolution);
+    return (cred != nullptr) ? loadSet(cred).ssidLength : 0;
+}
+
+size_t WiFiCreds::getPasswordLength(const char* name) {
+    CredentialResolution resolution;
+    const CredentialSet* cred = resolveCredential(name, resolution);
+    return (cred != nullptr) ? loadSet(cred).passwordLength : 0;
+}
+
+CredentialView WiFiCreds::resolve(const char* name) {
+    CredentialResolution resolution;
+    const CredentialSet* cred = resolveCredential(name, resolution);
+    return makeView(cred, resolution);
+}
+
+CredentialView WiFiCreds::resolveIndex(size_t index) {
+    if (index < CREDENTIAL_COUNT) {
+        return makeView(&CREDENTIAL_SETS[index], CredentialResolution::Found);
+    }
+    return makeView(nullptr, CredentialResolution::None);
+}
+
+bool WiFiCreds::getPMK(const char* name, uint8_t pmk[WIFICREDS_PMK_LENGTH]) {
+    CredentialResolution resolution;
+    const CredentialSet* cred = resolveCredential(name, resolution);
     
-    // Check if pointers are valid and strings are not empty
-    if (ssid == nullptr || password == nullptr) {
+    if (cred == nullptr || pmk == nullptr) {
         return false;
     }
     
-    // Check if strings have content (not just null terminators)
-    if (strlen(ssid) == 0 || strlen(password) == 0) {
+    const CredentialSet& set = loadSet(cred);
+    
+    // Precomputed at build time
+    if (set.pmk != nullptr) {
+        memcpy_P(pmk, set.pmk, WIFICREDS_PMK_LENGTH);
+        return true;
+    }
+    
+#if WIFICREDS_PMK_CACHE_SIZE > 0
+    for (size_t i = 0; i < WIFICREDS_PMK_CACHE_SIZE; i++) {
+        if (pmkCache[i].cred == cred) {
+            memcpy(pmk, pmkCache[i].pmk, WIFICREDS_PMK_LENGTH);
+            return true;
+        }
+    }
+#endif
+    
+    char unsealed[WIFICREDS_PASSWORD_BUFFER_SIZE];
+    const char* password = passwordOf(set);
+    if (set.sealed) {
+        password = unsealPassword(set, unsealed, sizeof(unsealed)) ? unsealed : nullptr;
+    }
+    const bool derived = password != nullptr &&
+                         WiFiCredsPMK::derive(ssidOf(set), set.ssidLength, password, set.passwordLength, pmk);
+    WiFiCredsCipher::wipe(unsealed, sizeof(unsealed));
+#if WIFICREDS_TABLE_IN_FLASH
+    memset(passwordBuffer, 0, sizeof(passwordBuffer));
+#endif
+    if (!derived) {
         return false;
     }
     
+#if WIFICREDS_PMK_CACHE_SIZE > 0
+    // Round-robin replacement; plain stores, so the cache is for one task only, like the PROGMEM buffers
+    PMKCacheEntry& entry = pmkCache[pmkCacheNext];
+    pmkCacheNext = (pmkCacheNext + 1) % WIFICREDS_PMK_CACHE_SIZE;
+    entry.cred = nullptr;
+    memcpy(entry.pmk, pmk, WIFICREDS_PMK_LENGTH);
+    entry.cred = cred;
+#endif
+    
     return true;
 }
 
-size_t WiFiCreds::getSSIDLength(const char* name) {
-    const char* ssid = getSSID(name);
-    return (ssid != nullptr) ? strlen(ssid) : 0;
-}
-
-size_t WiFiCreds::getPasswordLength(const char* name) {
-    const char* password = getPassword(name);
-    return (password != nullptr) ? strlen(password) : 0;
+bool WiFiCreds::getPSKHex(const char* name, char hex[WIFICREDS_PSK_HEX_SIZE]) {
+    uint8_t pmk[WIFICREDS_PMK_LENGTH];
+    
+    if (hex == nullptr || !getPMK(name, pmk)) {
+        return false;
+    }
+    
+    WiFiCredsPMK::toHex(pmk, hex);
+    memset(pmk, 0, sizeof(pmk));
+    return true;
 }
 
 // ===== CREDENTIAL MANAGEMENT METHODS =====
 
 size_t WiFiCreds::getCredentialCount() {
-    size_t count = 0;
-    
-    // Count entries until we hit the terminator (where name is nullptr)
-    while (count < 1000 && CREDENTIAL_SETS[count].name != nullptr) { // Safety limit to prevent infinite loops
-        count++;
-    }
-    
-    return count;
+    // Validated against the terminator entry at compile time
+    return CREDENTIAL_COUNT;
 }
 
 const char* WiFiCreds::getCredentialName(size_t index) {
-    size_t totalCount = getCredentialCount();
-    
-    if (index < totalCount) {
-        return CREDENTIAL_SETS[index].name;
+    if (index < CREDENTIAL_COUNT) {
+        return nameOf(loadSet(&CREDENTIAL_SETS[index]));
     }
     
     return nullptr;
@@ -95,6 +425,127 @@ const char* WiFiCreds::getDefaultName() {
     return getCredentialName(0);
 }
 
+size_t WiFiCreds::findSSID(const char* ssid, uint16_t* indices, size_t maxIndices) {
+    size_t found = 0;
+    
+    if (ssid == nullptr || *ssid == '\0' || indices == nullptr) {
+        return 0;
+    }
+    
+#if WIFICREDS_USE_INDEX
+    if (INDEXED) {
+        const uint32_t hash = WiFiCredsIndex::hashName(ssid, 0);
+        const uint16_t tag = WiFiCredsIndex::hashTag(hash);
+        
+        // Probe from the home slot; the tag rejects most other SSIDs without a strcmp
+        for (size_t slot = hash & (SSID_TABLE_SIZE - 1);
+             SSID_INDEX.slots[slot] != WiFiCredsIndex::EMPTY_SLOT && found < maxIndices;
+             slot = (slot + 1) & (SSID_TABLE_SIZE - 1)) {
+            const uint16_t index = SSID_INDEX.slots[slot];
+            if (SSID_INDEX.tags[slot] == tag && strcmp(CREDENTIAL_SETS[index].ssid, ssid) == 0) {
+                indices[found++] = index;
+            }
+        }
+        return found;
+    }
+#endif
+    
+    for (size_t i = 0; i < CREDENTIAL_COUNT && found < maxIndices; i++) {
+        const CredentialSet& set = loadSet(&CREDENTIAL_SETS[i]);
+        if (set.ssidLength > 0 && compareStored(ssid, set.ssid) == 0) {
+            indices[found++] = static_cast<uint16_t>(i);
+        }
+    }
+    
+    return found;
+}
+
+// ===== FLASH-FRIENDLY ACCESSORS =====
+
+bool WiFiCreds::copySSID(const char* name, char* buffer, size_t size) {
+    CredentialResolution resolution;
+    const CredentialSet* cred = resolveCredential(name, resolution);
+    
+    if (cred == nullptr || buffer == nullptr) {
+        return false;
+    }
+    
+    return copySSIDOf(loadSet(cred), buffer, size);
+}
+
+bool WiFiCreds::copySSIDAt(size_t index, char* buffer, size_t size) {
+    if (index >= CREDENTIAL_COUNT || buffer == nullptr) {
+        return false;
+    }
+    return copySSIDOf(loadSet(&CREDENTIAL_SETS[index]), buffer, size);
+}
+
+size_t WiFiCreds::getPasswordLengthAt(size_t index) {
+    return (index < CREDENTIAL_COUNT) ? loadSet(&CREDENTIAL_SETS[index]).passwordLength : 0;
+}
+
+bool WiFiCreds::copyPassword(const char* name, char* buffer, size_t size) {
+    CredentialResolution resolution;
+    const CredentialSet* cred = resolveCredential(name, resolution);
+    
+    if (cred == nullptr || buffer == nullptr) {
+        return false;
+    }
+    
+    const CredentialSet& set = loadSet(cred);
+    if (set.sealed) {
+        return unsealPassword(set, buffer, size);
+    }
+    if (set.password == nullptr || size <= set.passwordLength) {
+        return false;
+    }
+    memcpy_P(buffer, set.password, set.passwordLength);
+    buffer[set.passwordLength] = '\0';
+    return true;
+}
+
+const char* WiFiCreds::getConnectKey(const CredentialView& creds, char buffer[WIFICREDS_PSK_HEX_SIZE]) {
+    if (creds.resolution == CredentialResolution::None || buffer == nullptr) {
+        return nullptr;
+    }
+    
+    // A stored PMK skips PBKDF2 on the device as well; deriving one here would defeat the purpose
+    if (creds.pmk != nullptr) {
+        WiFiCredsPMK::toHex(creds.pmk, buffer);
+        return buffer;
+    }
+    if (creds.sealed) {
+        return copyPassword(creds.name, buffer, WIFICREDS_PSK_HEX_SIZE) ? buffer : nullptr;
+    }
+    return creds.password;
+}
+
+bool WiFiCreds::usesProgmem() {
+    return WIFICREDS_TABLE_IN_FLASH;
+}
+
+#if defined(ARDUINO)
+// On AVR a RAM pointer is not a valid flash address, everywhere else the address spaces overlap
+#if WIFICREDS_TABLE_IN_FLASH || !defined(__AVR__)
+#define WIFICREDS_FLASH_STRING(s) reinterpret_cast<const __FlashStringHelper*>(s)
+#else
+#define WIFICREDS_FLASH_STRING(s) static_cast<const __FlashStringHelper*>(nullptr)
+#endif
+
+const __FlashStringHelper* WiFiCreds::getSSID_F(const char* name) {
+    CredentialResolution resolution;
+    const CredentialSet* cred = resolveCredential(name, resolution);
+    return (cred != nullptr) ? WIFICREDS_FLASH_STRING(loadSet(cred).ssid) : nullptr;
+}
+
+const __FlashStringHelper* WiFiCreds::getCredentialName_F(size_t index) {
+    if (index < CREDENTIAL_COUNT) {
+        return WIFICREDS_FLASH_STRING(loadSet(&CREDENTIAL_SETS[index]).name);
+    }
+    return nullptr;
+}
+#endif
+
 // ===== PRIVATE HELPER METHODS =====
 
 const CredentialSet* WiFiCreds::findCredential(const char* name) {
@@ -102,19 +553,92 @@ const CredentialSet* WiFiCreds::findCredential(const char* name) {
         return nullptr;
     }
     
-    size_t count = getCredentialCount();
-    for (size_t i = 0; i < count; i++) {
-        if (strcmp(CREDENTIAL_SETS[i].name, name) == 0) {
+#if WIFICREDS_USE_INDEX
+    if (INDEXED) {
+        // One hash probe, then a single compare to reject names that are not in the table
+        size_t index = NAME_INDEX.candidate(name);
+        if (index != WiFiCredsIndex::EMPTY_SLOT && strcmp(CREDENTIAL_SETS[index].name, name) == 0) {
+            return &CREDENTIAL_SETS[index];
+        }
+        return nullptr;
+    }
+#endif
+    
+#if WIFICREDS_NAMES_SORTED
+    if (CREDENTIAL_COUNT == 0) {
+        return nullptr;
+    }
+    if (compareStored(name, loadSet(&CREDENTIAL_SETS[0]).name) == 0) {
+        return &CREDENTIAL_SETS[0];
+    }
+    
+    // Binary search over the sorted sets after the default
+    size_t low = 1;
+    size_t high = CREDENTIAL_COUNT;
+    while (low < high) {
+        const size_t middle = low + (high - low) / 2;
+        const int order = compareStored(name, loadSet(&CREDENTIAL_SETS[middle]).name);
+        if (order == 0) {
+            return &CREDENTIAL_SETS[middle];
+        }
+        if (order < 0) {
+            high = middle;
+        } else {
+            low = middle + 1;
+        }
+    }
+    
+    return nullptr;
+#else
+    for (size_t i = 0; i < CREDENTIAL_COUNT; i++) {
+        if (compareStored(name, loadSet(&CREDENTIAL_SETS[i]).name) == 0) {
             return &CREDENTIAL_SETS[i];
         }
     }
     
     return nullptr;
+#endif
 }
 
 const CredentialSet* WiFiCreds::getDefaultCredential() {
-    if (getCredentialCount() > 0) {
+    if (CREDENTIAL_COUNT > 0) {
         return &CREDENTIAL_SETS[0];
     }
     return nullptr;
+}
+
+const CredentialSet* WiFiCreds::resolveCredential(const char* name, CredentialResolution& resolution) {
+    const CredentialSet* cred = findCredential(name);
+    
+    if (cred != nullptr) {
+        resolution = CredentialResolution::Found;
+        return cred;
+    }
+    
+    // Unknown or missing names fall back to the default set
+    cred = getDefaultCredential();
+    if (cred == nullptr) {
+        resolution = CredentialResolution::None;
+    } else {
+        resolution = (name != nullptr) ? CredentialResolution::Fallback : CredentialResolution::Default;
+    }
+    return cred;
+}
+
+CredentialView WiFiCreds::makeView(const CredentialSet* cred, CredentialResolution resolution) {
+    CredentialView view = {nullptr, nullptr, nullptr, 0, 0, nullptr, 0, resolution, false};
+    
+    if (cred != nullptr) {
+        const CredentialSet& set = loadSet(cred);
+        view.name = nameOf(set);
+        view.ssid = ssidOf(set);
+        view.password = passwordOf(set);
+        view.ssidLength = set.ssidLength;
+        view.passwordLength = set.passwordLength;
+        view.pmk = pmkOf(set);
+        view.index = static_cast<size_t>(cred - CREDENTIAL_SETS);
+        view.sealed = set.sealed;
+    }
+    
+    return view;
 }
\ No newline at end of file
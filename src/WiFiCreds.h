@@ -15,19 +15,247 @@
 #ifndef WIFICREDS_H
 #define WIFICREDS_H
 
+#if defined(ARDUINO)
 #include <Arduino.h>
+#else
+// Host (non-Arduino) builds only need the fixed-width and size types
+#include <stddef.h>
+#include <stdint.h>
+#endif
+
+/**
+ * @def WIFICREDS_MAX_CREDENTIALS
+ * @brief Maximum number of credential sets accepted in CREDENTIAL_SETS
+ *
+ * Exceeding it fails the build. Define it before including the library
+ * (e.g. with a -D build flag) to raise the limit.
+ */
+#ifndef WIFICREDS_MAX_CREDENTIALS
+#define WIFICREDS_MAX_CREDENTIALS 1000
+#endif
+
+/**
+ * @def WIFICREDS_INDEX_MIN_SETS
+ * @brief Smallest table that is looked up through the compile-time hash index
+ *
+ * Below it, a scan of the names is faster than hashing the name and needs no
+ * index arrays, which ESP8266 would keep in RAM. Set to 0 to always use the
+ * index (C++14 toolchains, outside PROGMEM mode).
+ */
+#ifndef WIFICREDS_INDEX_MIN_SETS
+#define WIFICREDS_INDEX_MIN_SETS 16
+#endif
+
+/// Length of a WPA2 pairwise master key in bytes
+#define WIFICREDS_PMK_LENGTH 32
+
+/// Buffer size for a PMK formatted as hex PSK (64 characters plus null terminator)
+#define WIFICREDS_PSK_HEX_SIZE (WIFICREDS_PMK_LENGTH * 2 + 1)
+
+/**
+ * @def WIFICREDS_PMK_CACHE_SIZE
+ * @brief Number of PMKs derived on the device that are kept in RAM
+ *
+ * Each cached entry uses 34 bytes of RAM. Set to 0 to disable the cache.
+ */
+#ifndef WIFICREDS_PMK_CACHE_SIZE
+#define WIFICREDS_PMK_CACHE_SIZE 2
+#endif
+
+/**
+ * @def WIFICREDS_FLASH
+ * @brief Places a constant in flash on targets where constants are otherwise copied to SRAM
+ *
+ * Expands to PROGMEM on AVR and ESP8266 and to nothing elsewhere (ESP32,
+ * RP2040 and Renesas boards read constants from flash directly).
+ */
+#if defined(__AVR__) || defined(ESP8266)
+#define WIFICREDS_FLASH PROGMEM
+#else
+#define WIFICREDS_FLASH
+#endif
+
+/// Buffer size for a credential set name copied out of flash in PROGMEM mode
+#ifndef WIFICREDS_NAME_BUFFER_SIZE
+#define WIFICREDS_NAME_BUFFER_SIZE 33
+#endif
+
+/// Buffer size for an SSID (32 characters plus null terminator)
+#define WIFICREDS_SSID_BUFFER_SIZE 33
+
+/// Buffer size for a password (a 64-character hex PSK plus null terminator)
+#define WIFICREDS_PASSWORD_BUFFER_SIZE 65
+
+/// Bytes in front of the ciphertext of a sealed password (the ChaCha20 nonce)
+#define WIFICREDS_SEALED_NONCE_LENGTH 12
 
 /**
  * @struct CredentialSet
  * @brief Structure to hold a named set of Wi-Fi credentials
  * 
  * This structure contains a name identifier and the corresponding
- * SSID and password for a Wi-Fi network.
+ * SSID and password for a Wi-Fi network, together with the string
+ * lengths computed at compile time.
+ * 
+ * @note Declare entries with WIFICREDS_SET() so the lengths are filled in
+ * @note The lengths are checked against the strings at compile time
+ * @note For sealed entries (WIFICREDS_SET_SEALED()) password points to the nonce and
+ *       ciphertext, and passwordLength is the length of the decrypted password
  */
 struct CredentialSet {
     const char* name;    ///< Name identifier for the credential set (e.g., "home", "office")
     const char* ssid;    ///< Wi-Fi SSID
     const char* password; ///< Wi-Fi password
+    uint8_t ssidLength;  ///< Length of ssid (excluding null terminator)
+    uint8_t passwordLength; ///< Length of password (excluding null terminator)
+    bool sealed;         ///< true if password is encrypted (see WiFiCredsCipher.h)
+    const uint8_t* pmk;  ///< Precomputed 32-byte WPA2 PMK, or nullptr to derive it on the device
+};
+
+/**
+ * @brief Compile-time string length
+ * 
+ * @param s Null-terminated string, or nullptr
+ * @return size_t Length of the string (excluding null terminator), or 0 for nullptr
+ */
+constexpr size_t WiFiCredsStrLen(const char* s) {
+    return (s == nullptr || *s == '\0') ? 0 : 1 + WiFiCredsStrLen(s + 1);
+}
+
+/**
+ * @brief Compile-time number of credential sets in a table such as CREDENTIAL_SETS
+ * 
+ * @return size_t Number of entries before the terminator entry
+ */
+template <size_t N>
+constexpr size_t WiFiCredsSetCount(const CredentialSet (&)[N]) {
+    return N - 1;
+}
+
+/**
+ * @def WIFICREDS_SET
+ * @brief Declare a CREDENTIAL_SETS entry with its lengths computed at compile time
+ * 
+ * @param setName Name identifier for the credential set
+ * @param setSsid Wi-Fi SSID
+ * @param setPassword Wi-Fi password
+ */
+#define WIFICREDS_SET(setName, setSsid, setPassword) \
+    WIFICREDS_SET_PMK(setName, setSsid, setPassword, nullptr)
+
+/**
+ * @def WIFICREDS_SET_PMK
+ * @brief Declare a CREDENTIAL_SETS entry with a precomputed WPA2 PMK
+ * 
+ * @param setName Name identifier for the credential set
+ * @param setSsid Wi-Fi SSID
+ * @param setPassword Wi-Fi password
+ * @param setPmk Pointer to the 32-byte PMK derived from setSsid and setPassword
+ */
+#define WIFICREDS_SET_PMK(setName, setSsid, setPassword, setPmk) \
+    { \
+        .name = setName, \
+        .ssid = setSsid, \
+        .password = setPassword, \
+        .ssidLength = static_cast<uint8_t>(WiFiCredsStrLen(setSsid)), \
+        .passwordLength = static_cast<uint8_t>(WiFiCredsStrLen(setPassword)), \
+        .sealed = false, \
+        .pmk = setPmk \
+    }
+
+/**
+ * @def WIFICREDS_SET_SEALED
+ * @brief Declare a CREDENTIAL_SETS entry whose password is encrypted at rest
+ * 
+ * credgen --key writes these entries. The password is only readable through
+ * WiFiCreds::copyPassword() after WiFiCredsCipher::setKey().
+ * 
+ * @param setName Name identifier for the credential set
+ * @param setSsid Wi-Fi SSID
+ * @param setSealed char array holding the nonce followed by the ChaCha20 ciphertext
+ *                  (a string literal, so one null terminator follows the ciphertext)
+ */
+#define WIFICREDS_SET_SEALED(setName, setSsid, setSealed) \
+    { \
+        .name = setName, \
+        .ssid = setSsid, \
+        .password = setSealed, \
+        .ssidLength = static_cast<uint8_t>(WiFiCredsStrLen(setSsid)), \
+        .passwordLength = static_cast<uint8_t>(sizeof(setSealed) - 1 - WIFICREDS_SEALED_NONCE_LENGTH), \
+        .sealed = true, \
+        .pmk = nullptr \
+    }
+
+/**
+ * @def WIFICREDS_TERMINATOR
+ * @brief Terminator entry that must close the CREDENTIAL_SETS array
+ */
+#define WIFICREDS_TERMINATOR WIFICREDS_SET(nullptr, nullptr, nullptr)
+
+/**
+ * @def WIFICREDS_FLASH_ENTRY
+ * @brief Define the flash-resident strings of one credential set (PROGMEM mode)
+ *
+ * Use at namespace scope in credentials.h, once per set, before CREDENTIAL_SETS.
+ * The set name is the identifier itself.
+ *
+ * @param id Identifier used as the set name (e.g. home)
+ * @param setSsid Wi-Fi SSID
+ * @param setPassword Wi-Fi password
+ */
+#define WIFICREDS_FLASH_ENTRY(id, setSsid, setPassword) \
+    constexpr char WiFiCredsName_##id[] WIFICREDS_FLASH = #id; \
+    constexpr char WiFiCredsSsid_##id[] WIFICREDS_FLASH = setSsid; \
+    constexpr char WiFiCredsPassword_##id[] WIFICREDS_FLASH = setPassword
+
+/**
+ * @def WIFICREDS_FLASH_SET
+ * @brief CREDENTIAL_SETS entry for strings defined with WIFICREDS_FLASH_ENTRY()
+ * @param id Identifier passed to WIFICREDS_FLASH_ENTRY()
+ */
+#define WIFICREDS_FLASH_SET(id) \
+    WIFICREDS_SET(WiFiCredsName_##id, WiFiCredsSsid_##id, WiFiCredsPassword_##id)
+
+/**
+ * @enum CredentialResolution
+ * @brief Describes how a requested name was resolved to a credential set
+ */
+enum class CredentialResolution : uint8_t {
+    Found,    ///< A credential set with the requested name exists
+    Default,  ///< nullptr was requested, so the default (first) set was used
+    Fallback, ///< The requested name was not found, so the default (first) set was used
+    None      ///< No credential sets are defined
+};
+
+/**
+ * @struct CredentialView
+ * @brief Result of a single credential lookup
+ * 
+ * Holds everything needed to connect to a network, so a sketch can resolve a
+ * name once and feed WiFi.begin() without repeating the lookup.
+ * 
+ * @note The strings point into the credential table and stay valid for the program lifetime,
+ *       except in PROGMEM mode, where they are RAM copies valid until the next lookup
+ * @note When resolution is CredentialResolution::None, all pointers are nullptr and lengths are 0
+ */
+struct CredentialView {
+    const char* name;                ///< Name of the resolved credential set
+    const char* ssid;                ///< Wi-Fi SSID
+    const char* password;            ///< Wi-Fi password
+    size_t ssidLength;               ///< Length of ssid (excluding null terminator)
+    size_t passwordLength;           ///< Length of password (excluding null terminator)
+    const uint8_t* pmk;              ///< Precomputed PMK from credentials.h, or nullptr (see WiFiCreds::getPMK())
+    size_t index;                    ///< Index of the resolved set (0 for the default set)
+    CredentialResolution resolution; ///< How the requested name was resolved
+    bool sealed;                     ///< Password is encrypted; password is nullptr, use WiFiCreds::copyPassword()
+
+    /**
+     * @brief Check that both SSID and password are non-empty
+     * @return true if the view can be used to connect, false otherwise
+     */
+    bool isValid() const {
+        return ssidLength > 0 && passwordLength > 0;
+    }
 };
 
 /**
@@ -56,7 +284,9 @@ public:
      * @param name The name of the credential set (e.g., "home", "office"), or nullptr for default
      * @return const char* Pointer to the SSID string, or nullptr if no credentials available
      * @note The returned string is null-terminated
-     * @note This method is thread-safe
+     * @note In PROGMEM mode this is a RAM copy that the next lookup overwrites
+     * @note Thread-safe because CREDENTIAL_SETS is immutable (not in PROGMEM mode, which shares
+     *       one buffer); for sets changed at runtime, read with WiFiCredsStore::resolveInto()
      * @note Names are case-sensitive
      * @note Passing nullptr or invalid name uses the default (first) credential set
      */
@@ -70,8 +300,11 @@ public:
      * 
      * @param name The name of the credential set (e.g., "home", "office"), or nullptr for default
      * @return const char* Pointer to the password string, or nullptr if no credentials available
+     *         or the password is sealed (use copyPassword())
      * @note The returned string is null-terminated
-     * @note This method is thread-safe
+     * @note In PROGMEM mode this is a RAM copy that the next lookup overwrites
+     * @note Thread-safe because CREDENTIAL_SETS is immutable (not in PROGMEM mode, which shares
+     *       one buffer); for sets changed at runtime, read with WiFiCredsStore::resolveInto()
      * @warning Handle the password securely and avoid logging it
      * @note Names are case-sensitive
      * @note Passing nullptr or invalid name uses the default (first) credential set
@@ -86,6 +319,7 @@ public:
      * 
      * @param name The name of the credential set to validate, or nullptr for default
      * @return true if credentials are valid, false otherwise
+     * @note Uses the precomputed lengths, the strings themselves are not read
      * @note Names are case-sensitive
      * @note Passing nullptr or invalid name validates the default (first) credential set
      */
@@ -96,6 +330,7 @@ public:
      * 
      * @param name The name of the credential set, or nullptr for default
      * @return size_t Length of the SSID string (excluding null terminator), or 0 if not found
+     * @note The length is precomputed, the string itself is not read
      * @note Names are case-sensitive
      * @note Passing nullptr or invalid name uses the default (first) credential set
      */
@@ -106,10 +341,74 @@ public:
      * 
      * @param name The name of the credential set, or nullptr for default
      * @return size_t Length of the password string (excluding null terminator), or 0 if not found
+     * @note The length is precomputed, the string itself is not read
      * @note Names are case-sensitive
      * @note Passing nullptr or invalid name uses the default (first) credential set
      */
     static size_t getPasswordLength(const char* name = nullptr);
+    
+    /**
+     * @brief Resolve a credential set once and return all of its data
+     * 
+     * Performs a single lookup and returns the SSID, password, both lengths and
+     * how the name was resolved. Use this instead of calling getSSID(),
+     * getPassword(), getSSIDLength() and getPasswordLength() one after another.
+     * 
+     * @param name The name of the credential set, or nullptr for default
+     * @return CredentialView The resolved credential data
+     * @note Names are case-sensitive
+     * @note Passing nullptr or invalid name uses the default (first) credential set
+     * @warning Handle the password securely and avoid logging it
+     */
+    static CredentialView resolve(const char* name = nullptr);
+    
+    /**
+     * @brief Resolve a credential set by index and return all of its data
+     * 
+     * @param index The index of the credential set (0-based)
+     * @return CredentialView The credential data; resolution is CredentialResolution::None
+     *         if the index is out of range
+     * @note Unlike resolve(), an invalid index does not fall back to the default set
+     */
+    static CredentialView resolveIndex(size_t index);
+    
+    /**
+     * @brief Get the WPA2 PMK for a specific credential set
+     * 
+     * Returns the PMK stored in credentials.h when available. Otherwise the PMK
+     * is derived from the SSID and password once (PBKDF2-HMAC-SHA1) and kept
+     * in a small RAM cache, so later connects skip the derivation.
+     * 
+     * @param name The name of the credential set, or nullptr for default
+     * @param pmk Receives the 32-byte PMK
+     * @return true on success, false if no credentials are available or the
+     *         password is not a WPA2 passphrase (8-63 characters)
+     * @note The first call for a set without a stored PMK can take hundreds of milliseconds
+     * @note Not thread-safe: the RAM cache is shared without a lock, so call this (and
+     *       getPSKHex()) from one task only, or set WIFICREDS_PMK_CACHE_SIZE to 0
+     * @note Passing nullptr or invalid name uses the default (first) credential set
+     * @warning The PMK is as sensitive as the password
+     */
+    static bool getPMK(const char* name, uint8_t pmk[WIFICREDS_PMK_LENGTH]);
+    
+    /**
+     * @brief Get the PMK of a credential set as a 64-character hex PSK
+     * 
+     * The ESP32 and ESP8266 cores accept this string in place of the passphrase
+     * and then use the key directly:
+     * @code
+     * char psk[WIFICREDS_PSK_HEX_SIZE];
+     * if (WiFiCreds::getPSKHex("home", psk)) {
+     *     WiFi.begin(WiFiCreds::getSSID("home"), psk);
+     * }
+     * @endcode
+     * 
+     * @param name The name of the credential set, or nullptr for default
+     * @param hex Receives 64 hex characters and a null terminator
+     * @return true on success, false under the same conditions as getPMK()
+     * @warning The PSK is as sensitive as the password
+     */
+    static bool getPSKHex(const char* name, char hex[WIFICREDS_PSK_HEX_SIZE]);
 
     // ===== CREDENTIAL MANAGEMENT METHODS =====
     
@@ -118,6 +417,7 @@ public:
      * 
      * @return size_t Number of credential sets defined in credentials.h
      * @note Returns 0 if no credentials are defined
+     * @note The count is fixed at compile time, so this runs in constant time
      */
     static size_t getCredentialCount();
     
@@ -128,6 +428,7 @@ public:
      * @return const char* Pointer to the name string, or nullptr if index is invalid
      * @note Use getCredentialCount() to determine valid index range
      * @note Index 0 is always the default credential set
+     * @note In PROGMEM mode this is a RAM copy that the next lookup overwrites
      */
     static const char* getCredentialName(size_t index);
     
@@ -148,6 +449,112 @@ public:
      * @note The default is always the first credential set (index 0)
      */
     static const char* getDefaultName();
+    
+    /**
+     * @brief Find all credential sets for a network SSID
+     * 
+     * Several sets may share one SSID (e.g. different names for the same network).
+     * 
+     * @param ssid The SSID to look up (e.g. from a scan result)
+     * @param indices Receives the indexes of matching credential sets
+     * @param maxIndices Capacity of @p indices
+     * @return size_t Number of indexes written
+     * @note Uses a compile-time hash table on C++14 toolchains from WIFICREDS_INDEX_MIN_SETS
+     *       sets on, a linear scan otherwise
+     * @note SSIDs are compared exactly (case-sensitive)
+     */
+    static size_t findSSID(const char* ssid, uint16_t* indices, size_t maxIndices);
+    
+    // ===== FLASH-FRIENDLY ACCESSORS =====
+    
+    /**
+     * @brief Copy the SSID of a credential set into a caller buffer
+     * 
+     * Works in both storage modes and never keeps a pointer into the table.
+     * 
+     * @param name The name of the credential set, or nullptr for default
+     * @param buffer Receives the null-terminated SSID (WIFICREDS_SSID_BUFFER_SIZE always fits)
+     * @param size Size of @p buffer in bytes
+     * @return true if the whole SSID was copied, false if there is no credential set or it does not fit
+     */
+    static bool copySSID(const char* name, char* buffer, size_t size);
+    
+    /**
+     * @brief Copy the SSID of a credential set by index into a caller buffer
+     * 
+     * Only the SSID is read, so unlike resolveIndex() no name or password is copied
+     * into the shared RAM buffers of PROGMEM mode.
+     * 
+     * @param index The index of the credential set (0-based)
+     * @param buffer Receives the null-terminated SSID (WIFICREDS_SSID_BUFFER_SIZE always fits)
+     * @param size Size of @p buffer in bytes
+     * @return true if the whole SSID was copied, false if the index is invalid or it does not fit
+     */
+    static bool copySSIDAt(size_t index, char* buffer, size_t size);
+    
+    /**
+     * @brief Get the password length of a credential set by index
+     * 
+     * Reads the table entry only, none of its strings.
+     * 
+     * @param index The index of the credential set (0-based)
+     * @return size_t Length of the password (the decrypted length if it is sealed), 0 for an
+     *         open network or an invalid index
+     */
+    static size_t getPasswordLengthAt(size_t index);
+    
+    /**
+     * @brief Copy the password of a credential set into a caller buffer
+     * 
+     * @param name The name of the credential set, or nullptr for default
+     * @param buffer Receives the null-terminated password (WIFICREDS_PASSWORD_BUFFER_SIZE always fits)
+     * @param size Size of @p buffer in bytes
+     * @return true if the whole password was copied, false if there is no credential set, it does not
+     *         fit, or it is sealed and no key is set
+     * @note Sealed passwords are decrypted into @p buffer (one ChaCha20 block, a few microseconds)
+     * @note Clear the buffer after use, e.g. with WiFiCredsCipher::wipe()
+     */
+    static bool copyPassword(const char* name, char* buffer, size_t size);
+    
+    /**
+     * @brief Key to pass to the Wi-Fi driver for a resolved credential set
+     * 
+     * The stored PMK as a 64-hex-digit PSK if the set has one, the decrypted
+     * password if it is sealed, the plaintext password otherwise.
+     * 
+     * @param creds View returned by resolve() or resolveIndex()
+     * @param buffer Holds the PSK or the decrypted password; wipe it once the driver has it
+     * @return const char* The key, or nullptr if there is no credential set or a sealed
+     *         password cannot be decrypted because no key is set
+     * @warning Never connect with an empty password in place of nullptr: that joins an open
+     *          network of the same SSID, which anyone can set up
+     */
+    static const char* getConnectKey(const CredentialView& creds, char buffer[WIFICREDS_PSK_HEX_SIZE]);
+    
+    /**
+     * @brief true if credentials.h keeps the table in flash (WIFICREDS_USE_PROGMEM)
+     */
+    static bool usesProgmem();
+    
+#if defined(ARDUINO)
+    /**
+     * @brief SSID as a flash string for Serial.print() and other F()-aware APIs
+     * 
+     * @param name The name of the credential set, or nullptr for default
+     * @return const __FlashStringHelper* The SSID, or nullptr if there is no credential set
+     *         or the table is in SRAM on AVR (use getSSID() there)
+     */
+    static const __FlashStringHelper* getSSID_F(const char* name = nullptr);
+    
+    /**
+     * @brief Name of a credential set as a flash string
+     * 
+     * @param index Index of the credential set
+     * @return const __FlashStringHelper* The name, or nullptr if the index is invalid
+     *         or the table is in SRAM on AVR (use getCredentialName() there)
+     */
+    static const __FlashStringHelper* getCredentialName_F(size_t index);
+#endif
 
 private:
     // Prevent instantiation of this class
@@ -170,6 +577,24 @@ private:
      * @return const CredentialSet* Pointer to the default credential set, or nullptr if none available
      */
     static const CredentialSet* getDefaultCredential();
+    
+    /**
+     * @brief Find a credential set by name, falling back to the default set
+     * 
+     * @param name The name of the credential set, or nullptr for default
+     * @param resolution Receives how the name was resolved
+     * @return const CredentialSet* Pointer to the credential set, or nullptr if none available
+     */
+    static const CredentialSet* resolveCredential(const char* name, CredentialResolution& resolution);
+    
+    /**
+     * @brief Build a CredentialView for a credential set
+     * 
+     * @param cred The credential set, or nullptr
+     * @param resolution How the set was resolved
+     * @return CredentialView The view (empty if cred is nullptr)
+     */
+    static CredentialView makeView(const CredentialSet* cred, CredentialResolution resolution);
 };
 
 #endif // WIFICREDS_H 
\ No newline at end of file
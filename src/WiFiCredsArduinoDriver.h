@@ -0,0 +1,229 @@
+/**
+ * @file WiFiCredsArduinoDriver.h
+ * @brief WiFiCredsDriver implementation for the Arduino WiFi libraries
+ * @author Rithik Krisna M
+ * @version 1.0.4
+ * @date 2025
+ *
+ * Adapts the global WiFi object of the board's Wi-Fi library to the
+ * WiFiCredsDriver interface, so components such as WiFiCredsConnection run
+ * unchanged on hardware and against WiFiCredsSimDriver on a host machine.
+ *
+ * Supported libraries:
+ * - ESP32 and ESP8266 cores: channel/BSSID-locked connects, static IP, background scans
+ *   of the whole band or a single channel, scans without String copies
+ * - Other cores with the WiFiNINA-style API (Arduino UNO R4 WiFi, Raspberry Pi Pico W):
+ *   connects by SSID only
+ *
+ * @note Header-only; include it after the board's WiFi header (WiFi.h or ESP8266WiFi.h)
+ */
+
+#ifndef WIFICREDS_ARDUINO_DRIVER_H
+#define WIFICREDS_ARDUINO_DRIVER_H
+
+#if defined(ARDUINO)
+
+#include "WiFiCredsDriver.h"
+#include <string.h>
+
+/**
+ * @class WiFiCredsArduinoDriver
+ * @brief Driver backed by the global WiFi object
+ *
+ * The Arduino libraries report the same status (WL_DISCONNECTED or
+ * WL_IDLE_STATUS) for "attempt in progress" and "not connected", so the
+ * driver remembers whether it started an attempt to tell them apart.
+ */
+class WiFiCredsArduinoDriver : public WiFiCredsDriver {
+public:
+    WiFiCredsArduinoDriver() : _connecting(false), _established(false), _scanCount(0) {}
+
+    void begin(const char* ssid, const char* password, uint8_t channel = 0, const uint8_t* bssid = nullptr) override {
+        _connecting = true;
+        _established = false;
+#if defined(ESP32) || defined(ESP8266)
+        WiFi.begin(ssid, password, channel, bssid);
+#else
+        (void)channel;
+        (void)bssid;
+        WiFi.begin(ssid, password);
+#endif
+    }
+
+    WiFiCredsLinkStatus status() override {
+        const int raw = WiFi.status();
+
+        if (raw == WL_CONNECTED) {
+            _connecting = false;
+            _established = true;
+            return WiFiCredsLinkStatus::Connected;
+        }
+        if (_established) {
+            _established = false;
+            return WiFiCredsLinkStatus::Disconnected;
+        }
+        if (!_connecting) {
+            return WiFiCredsLinkStatus::Idle;
+        }
+
+        switch (raw) {
+            case WL_NO_SSID_AVAIL:
+                _connecting = false;
+                return WiFiCredsLinkStatus::NoSsid;
+            case WL_CONNECT_FAILED:
+#if defined(ESP8266)
+            case WL_WRONG_PASSWORD:
+#endif
+                _connecting = false;
+                return WiFiCredsLinkStatus::ConnectFailed;
+            default:
+                return WiFiCredsLinkStatus::Connecting;
+        }
+    }
+
+    void disconnect() override {
+        _connecting = false;
+        _established = false;
+        WiFi.disconnect();
+    }
+
+    int scanNetworks() override {
+        _scanCount = WiFi.scanNetworks();
+        return _scanCount;
+    }
+
+#if defined(ESP32) || defined(ESP8266)
+    bool startScan(uint8_t channel = 0) override {
+        // Returns WIFI_SCAN_RUNNING once the scan is under way
+#if defined(ESP32)
+        return WiFi.scanNetworks(true, false, false, 300, channel) != WIFI_SCAN_FAILED;
+#else
+        return WiFi.scanNetworks(true, false, channel) != WIFI_SCAN_FAILED;
+#endif
+    }
+
+    int scanComplete() override {
+        const int result = WiFi.scanComplete();
+        if (result >= 0) {
+            _scanCount = result;
+        }
+        return (result >= 0 || result == WIFI_SCAN_RUNNING) ? result : WIFICREDS_SCAN_FAILED;
+    }
+#endif
+
+    bool scanResult(int index, WiFiCredsScanEntry& entry) override {
+#if defined(ESP32)
+        const wifi_ap_record_t* record = static_cast<const wifi_ap_record_t*>(WiFi.getScanInfoByIndex(index));
+        if (record == nullptr) {
+            return false;
+        }
+        strncpy(entry.ssid, reinterpret_cast<const char*>(record->ssid), WIFICREDS_SSID_MAX_LENGTH);
+        entry.ssid[WIFICREDS_SSID_MAX_LENGTH] = '\0';
+        memcpy(entry.bssid, record->bssid, sizeof(entry.bssid));
+        entry.channel = record->primary;
+        entry.rssi = record->rssi;
+        entry.open = record->authmode == WIFI_AUTH_OPEN;
+#elif defined(ESP8266)
+        const bss_info* record = WiFi.getScanInfoByIndex(index);
+        if (record == nullptr) {
+            return false;
+        }
+        // The SDK does not null-terminate a 32-byte SSID
+        const size_t length = (record->ssid_len < WIFICREDS_SSID_MAX_LENGTH) ? record->ssid_len : WIFICREDS_SSID_MAX_LENGTH;
+        memcpy(entry.ssid, record->ssid, length);
+        entry.ssid[length] = '\0';
+        memcpy(entry.bssid, record->bssid, sizeof(entry.bssid));
+        entry.channel = record->channel;
+        entry.rssi = record->rssi;
+        entry.open = record->authmode == AUTH_OPEN;
+#else
+        if (index < 0 || index >= _scanCount) {
+            return false;
+        }
+        const char* ssid = WiFi.SSID(index);
+        strncpy(entry.ssid, (ssid != nullptr) ? ssid : "", WIFICREDS_SSID_MAX_LENGTH);
+        entry.ssid[WIFICREDS_SSID_MAX_LENGTH] = '\0';
+        WiFi.BSSID(index, entry.bssid);
+        entry.channel = static_cast<uint8_t>(WiFi.channel(index));
+        entry.rssi = static_cast<int8_t>(WiFi.RSSI(index));
+        entry.open = WiFi.encryptionType(index) == ENC_TYPE_NONE;
+#endif
+        return true;
+    }
+
+    int8_t rssi() override {
+        return (WiFi.status() == WL_CONNECTED) ? static_cast<int8_t>(WiFi.RSSI()) : 0;
+    }
+
+    bool bssid(uint8_t bssid[6]) override {
+        if (WiFi.status() != WL_CONNECTED) {
+            return false;
+        }
+#if defined(ESP32) || defined(ESP8266)
+        const uint8_t* current = WiFi.BSSID();
+        if (current == nullptr) {
+            return false;
+        }
+        memcpy(bssid, current, 6);
+#else
+        WiFi.BSSID(bssid);
+#endif
+        return true;
+    }
+
+    uint32_t now() override {
+        return millis();
+    }
+
+    /**
+     * @brief Name of a raw WiFi.status() code, without building a String
+     *
+     * The numeric WL_* values differ between cores (the ESP8266 inserts
+     * WL_WRONG_PASSWORD), so the names are mapped here, where the board's
+     * constants are visible.
+     *
+     * @param raw Value returned by WiFi.status()
+     * @return const char* Constant string such as "Connected"; never nullptr
+     */
+    static const char* statusName(int raw) {
+        switch (raw) {
+            case WL_IDLE_STATUS:
+                return "Idle";
+            case WL_NO_SSID_AVAIL:
+                return "SSID Not Available";
+            case WL_SCAN_COMPLETED:
+                return "Scan Completed";
+            case WL_CONNECTED:
+                return "Connected";
+            case WL_CONNECT_FAILED:
+                return "Connection Failed";
+            case WL_CONNECTION_LOST:
+                return "Connection Lost";
+#if defined(ESP8266)
+            case WL_WRONG_PASSWORD:
+                return "Wrong Password";
+#endif
+            case WL_DISCONNECTED:
+                return "Disconnected";
+            case WL_NO_SHIELD:
+                return "No Wi-Fi Hardware";
+            default:
+                return "Unknown";
+        }
+    }
+
+#if defined(ESP32) || defined(ESP8266)
+    bool config(uint32_t localIP, uint32_t gateway, uint32_t subnet, uint32_t dns) override {
+        return WiFi.config(IPAddress(localIP), IPAddress(gateway), IPAddress(subnet), IPAddress(dns));
+    }
+#endif
+
+private:
+    bool _connecting;  ///< begin() was called and no final status was reported yet
+    bool _established; ///< The last reported status was Connected
+    int _scanCount;    ///< Result count of the last scan
+};
+
+#endif // ARDUINO
+
+#endif // WIFICREDS_ARDUINO_DRIVER_H
@@ -0,0 +1,227 @@
+/**
+ * @file WiFiCredsBlob.cpp
+ * @brief Implementation of the credential blob reader
+ * @author Rithik Krisna M
+ * @version 1.0.4
+ * @date 2025
+ */
+
+#include "WiFiCredsBlob.h"
+#include <string.h>     // Required for strcmp and memcmp
+
+namespace {
+
+const uint8_t BLOB_MAGIC[4] = {'W', 'C', 'B', '1'};
+const size_t RECORD_HEADER_SIZE = 4;
+
+// Little-endian reads work on any alignment and host byte order
+uint16_t readU16(const uint8_t* p) {
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+uint32_t readU32(const uint8_t* p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+/**
+ * @brief Total size of a record starting at @p p, from its length prefix
+ */
+size_t recordSize(const uint8_t* p) {
+    size_t size = RECORD_HEADER_SIZE + p[0] + 1 + p[1] + 1 + p[2] + 1;
+    if (p[3] & WIFICREDS_BLOB_RECORD_PMK) {
+        size += WIFICREDS_PMK_LENGTH;
+    }
+    return size;
+}
+
+/**
+ * @brief Record at @p offset, or nullptr if it does not lie within the blob
+ *
+ * Checks the offset, the length prefix and the three terminators, so the
+ * strings of a returned record can be read with strcmp() and friends.
+ */
+const uint8_t* checkedRecord(const uint8_t* data, size_t blobSize, size_t count, size_t offset) {
+    if (offset < WIFICREDS_BLOB_HEADER_SIZE + count * 2 || offset + RECORD_HEADER_SIZE > blobSize) {
+        return nullptr;
+    }
+    const uint8_t* p = data + offset;
+    if (offset + recordSize(p) > blobSize) {
+        return nullptr;
+    }
+    const uint8_t* name = p + RECORD_HEADER_SIZE;
+    if (name[p[0]] != '\0' || name[p[0] + 1 + p[1]] != '\0' || name[p[0] + 1 + p[1] + 1 + p[2]] != '\0') {
+        return nullptr;
+    }
+    return p;
+}
+
+} // namespace
+
+WiFiCredsBlob::WiFiCredsBlob() : _data(nullptr), _size(0), _count(0), _defaultIndex(0) {}
+
+bool WiFiCredsBlob::begin(const uint8_t* data, size_t size, bool verify) {
+    end();
+
+    if (data == nullptr || size < WIFICREDS_BLOB_HEADER_SIZE || memcmp(data, BLOB_MAGIC, sizeof(BLOB_MAGIC)) != 0 ||
+        readU16(data + 4) != WIFICREDS_BLOB_VERSION) {
+        return false;
+    }
+
+    const size_t count = readU16(data + 6);
+    const size_t defaultIndex = readU16(data + 8);
+    const uint32_t blobSize = readU32(data + 12);
+    if (blobSize > size || blobSize < WIFICREDS_BLOB_HEADER_SIZE + count * 2 ||
+        (count > 0 && defaultIndex >= count)) {
+        return false;
+    }
+
+    if (verify) {
+        if (crc32(data + WIFICREDS_BLOB_HEADER_SIZE, blobSize - WIFICREDS_BLOB_HEADER_SIZE) != readU32(data + 16)) {
+            return false;
+        }
+
+        // Every record must lie inside the blob, be null-terminated where the lengths say and be in name order
+        const char* previousName = nullptr;
+        for (size_t i = 0; i < count; i++) {
+            const size_t offset = static_cast<size_t>(readU16(data + WIFICREDS_BLOB_HEADER_SIZE + i * 2)) *
+                                  WIFICREDS_BLOB_ALIGNMENT;
+            const uint8_t* p = checkedRecord(data, blobSize, count, offset);
+            if (p == nullptr) {
+                return false;
+            }
+            const char* name = reinterpret_cast<const char*>(p + RECORD_HEADER_SIZE);
+            if (strlen(name) != p[0] || (previousName != nullptr && strcmp(previousName, name) >= 0)) {
+                return false;
+            }
+            previousName = name;
+        }
+    }
+
+    _data = data;
+    _size = blobSize;
+    _count = count;
+    _defaultIndex = defaultIndex;
+    return true;
+}
+
+void WiFiCredsBlob::end() {
+    _data = nullptr;
+    _size = 0;
+    _count = 0;
+    _defaultIndex = 0;
+}
+
+CredentialView WiFiCredsBlob::resolve(const char* name) const {
+    if (_count == 0) {
+        return makeView(0, CredentialResolution::None);
+    }
+
+    const size_t index = find(name);
+    if (index < _count) {
+        return makeView(index, CredentialResolution::Found);
+    }
+
+    // Unknown or missing names fall back to the default set
+    return makeView(_defaultIndex, (name != nullptr) ? CredentialResolution::Fallback : CredentialResolution::Default);
+}
+
+CredentialView WiFiCredsBlob::resolveIndex(size_t index) const {
+    return makeView(index, (index < _count) ? CredentialResolution::Found : CredentialResolution::None);
+}
+
+bool WiFiCredsBlob::hasCredential(const char* name) const {
+    return find(name) < _count;
+}
+
+size_t WiFiCredsBlob::findSSID(const char* ssid, uint16_t* indices, size_t maxIndices) const {
+    size_t found = 0;
+
+    if (ssid == nullptr || *ssid == '\0' || indices == nullptr) {
+        return 0;
+    }
+
+    const size_t length = strlen(ssid);
+    for (size_t i = 0; i < _count && found < maxIndices; i++) {
+        const uint8_t* p = record(i);
+        // The length prefix rejects most records without touching the strings
+        if (p != nullptr && p[1] == length && memcmp(p + RECORD_HEADER_SIZE + p[0] + 1, ssid, length) == 0) {
+            indices[found++] = static_cast<uint16_t>(i);
+        }
+    }
+
+    return found;
+}
+
+uint32_t WiFiCredsBlob::crc32(const uint8_t* data, size_t length) {
+    // Half-byte table: 64 bytes instead of 1 KB, about 4x faster than bitwise
+    static const uint32_t TABLE[16] = {
+        0x00000000UL, 0x1DB71064UL, 0x3B6E20C8UL, 0x26D930ACUL, 0x76DC4190UL, 0x6B6B51F4UL, 0x4DB26158UL, 0x5005713CUL,
+        0xEDB88320UL, 0xF00F9344UL, 0xD6D6A3E8UL, 0xCB61B38CUL, 0x9B64C2B0UL, 0x86D3D2D4UL, 0xA00AE278UL, 0xBDBDF21CUL
+    };
+
+    uint32_t crc = 0xFFFFFFFFUL;
+    for (size_t i = 0; i < length; i++) {
+        crc ^= data[i];
+        crc = (crc >> 4) ^ TABLE[crc & 0x0F];
+        crc = (crc >> 4) ^ TABLE[crc & 0x0F];
+    }
+    return ~crc;
+}
+
+// ===== PRIVATE HELPER METHODS =====
+
+const uint8_t* WiFiCredsBlob::record(size_t index) const {
+    // begin() without verify only checked the header, so each record is checked as it is read
+    return checkedRecord(_data, _size, _count,
+                         static_cast<size_t>(readU16(_data + WIFICREDS_BLOB_HEADER_SIZE + index * 2)) *
+                             WIFICREDS_BLOB_ALIGNMENT);
+}
+
+size_t WiFiCredsBlob::find(const char* name) const {
+    if (name == nullptr) {
+        return _count;
+    }
+
+    size_t low = 0;
+    size_t high = _count;
+    while (low < high) {
+        const size_t middle = low + (high - low) / 2;
+        const uint8_t* p = record(middle);
+        if (p == nullptr) {
+            return _count;
+        }
+        const int order = strcmp(reinterpret_cast<const char*>(p + RECORD_HEADER_SIZE), name);
+        if (order == 0) {
+            return middle;
+        }
+        if (order < 0) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return _count;
+}
+
+CredentialView WiFiCredsBlob::makeView(size_t index, CredentialResolution resolution) const {
+    CredentialView view = {nullptr, nullptr, nullptr, 0, 0, nullptr, 0, CredentialResolution::None, false};
+
+    const uint8_t* p = (resolution != CredentialResolution::None && index < _count) ? record(index) : nullptr;
+    if (p == nullptr) {
+        return view;
+    }
+
+    view.name = reinterpret_cast<const char*>(p + RECORD_HEADER_SIZE);
+    view.ssid = view.name + p[0] + 1;
+    view.password = view.ssid + p[1] + 1;
+    view.ssidLength = p[1];
+    view.passwordLength = p[2];
+    if (p[3] & WIFICREDS_BLOB_RECORD_PMK) {
+        view.pmk = reinterpret_cast<const uint8_t*>(view.password + p[2] + 1);
+    }
+    view.index = index;
+    view.resolution = resolution;
+
+    return view;
+}
\ No newline at end of file
@@ -0,0 +1,184 @@
+/**
+ * @file WiFiCredsBlob.h
+ * @brief Reader for packed binary credential blobs
+ * @author Rithik Krisna M
+ * @version 1.0.4
+ * @date 2025
+ *
+ * A credential blob stores many credential sets in one contiguous block,
+ * without a pointer per string: a header, a 16-bit offset table and
+ * length-prefixed, null-terminated records sorted by name. Strings are
+ * returned as pointers into the blob, so reading costs no copies, and a
+ * name lookup is a binary search over the offset table.
+ *
+ * Blobs are generated on the host by extras/credgen (--format blob or
+ * --format blob-header) and can be compiled into the firmware, read from a
+ * file or mapped into memory.
+ *
+ * Layout (all integers little-endian):
+ * @verbatim
+ *   0  magic        "WCB1"
+ *   4  version      uint16, WIFICREDS_BLOB_VERSION
+ *   6  count        uint16, number of records
+ *   8  defaultIndex uint16, record of the default (first listed) set
+ *  10  flags        uint16, reserved (0)
+ *  12  size         uint32, total blob size in bytes
+ *  16  crc          uint32, CRC-32 of bytes 20..size-1
+ *  20  offsets      uint16[count], record offset / 4, in name order
+ *      records      4-byte aligned, each:
+ *                   nameLength, ssidLength, passwordLength, recordFlags (uint8 each)
+ *                   name '\0' ssid '\0' password '\0'
+ *                   pmk[32] if recordFlags & WIFICREDS_BLOB_RECORD_PMK
+ * @endverbatim
+ *
+ * @note The blob must be readable as ordinary memory (not PROGMEM on AVR)
+ */
+
+#ifndef WIFICREDS_BLOB_H
+#define WIFICREDS_BLOB_H
+
+#include "WiFiCreds.h"
+
+/// Format version written by credgen and accepted by WiFiCredsBlob
+#define WIFICREDS_BLOB_VERSION 1
+
+/// Size of the fixed blob header in bytes
+#define WIFICREDS_BLOB_HEADER_SIZE 20
+
+/// Record offsets are stored in units of this many bytes
+#define WIFICREDS_BLOB_ALIGNMENT 4
+
+/// recordFlags bit: a 32-byte PMK follows the strings
+#define WIFICREDS_BLOB_RECORD_PMK 0x01
+
+/**
+ * @class WiFiCredsBlob
+ * @brief Read-only view of a credential blob
+ *
+ * Lookups follow the same rules as WiFiCreds: nullptr selects the default
+ * set and unknown names fall back to it. The blob memory must stay valid
+ * while the WiFiCredsBlob and any returned views are in use.
+ *
+ * @code
+ * #include "credentials_blob.h" // generated by credgen --format blob-header
+ *
+ * WiFiCredsBlob blob;
+ * if (blob.begin(CREDENTIAL_BLOB, sizeof(CREDENTIAL_BLOB))) {
+ *     CredentialView creds = blob.resolve("site-0042");
+ *     WiFi.begin(creds.ssid, creds.password);
+ * }
+ * @endcode
+ */
+class WiFiCredsBlob {
+public:
+    WiFiCredsBlob();
+
+    /**
+     * @brief Attach to a blob
+     *
+     * @param data First byte of the blob
+     * @param size Number of readable bytes at @p data
+     * @param verify true to check the CRC and every record (O(n)); false to
+     *               check only the header, for O(1) startup. Records are then
+     *               bounds-checked when a lookup reads them, and one that does
+     *               not lie within the blob is treated as missing
+     * @return true if the blob is usable, false if it is malformed
+     */
+    bool begin(const uint8_t* data, size_t size, bool verify = true);
+
+    /**
+     * @brief Detach from the blob
+     */
+    void end();
+
+    /// true after a successful begin()
+    bool isValid() const { return _data != nullptr; }
+
+    /// Number of credential sets in the blob
+    size_t getCredentialCount() const { return _count; }
+
+    /**
+     * @brief Resolve a credential set by name
+     * @param name The name of the credential set, or nullptr for default
+     * @return CredentialView Strings point into the blob
+     */
+    CredentialView resolve(const char* name = nullptr) const;
+
+    /**
+     * @brief Resolve a credential set by record index (name order)
+     * @param index Record index
+     * @return CredentialView The set, or a view with CredentialResolution::None if index is invalid
+     */
+    CredentialView resolveIndex(size_t index) const;
+
+    /**
+     * @brief Get the Wi-Fi SSID for a credential set, as WiFiCreds::getSSID()
+     * @param name The name of the credential set, or nullptr for default
+     * @return const char* Pointer into the blob, or nullptr if the blob is empty
+     */
+    const char* getSSID(const char* name = nullptr) const { return resolve(name).ssid; }
+
+    /**
+     * @brief Get the Wi-Fi password for a credential set, as WiFiCreds::getPassword()
+     * @param name The name of the credential set, or nullptr for default
+     * @return const char* Pointer into the blob, or nullptr if the blob is empty
+     */
+    const char* getPassword(const char* name = nullptr) const { return resolve(name).password; }
+
+    /**
+     * @brief Get the name of a credential set by record index
+     * @param index Record index (name order)
+     * @return const char* The name, or nullptr if index is invalid
+     */
+    const char* getCredentialName(size_t index) const { return resolveIndex(index).name; }
+
+    /**
+     * @brief Get the name of the default credential set
+     * @return const char* The name, or nullptr if the blob is empty
+     */
+    const char* getDefaultName() const { return resolve().name; }
+
+    /**
+     * @brief Check if a credential set with the given name exists
+     * @param name The name to check
+     * @return true if found, false otherwise
+     */
+    bool hasCredential(const char* name) const;
+
+    /**
+     * @brief Find all credential sets for a network SSID
+     * @param ssid The SSID to look up
+     * @param indices Receives the record indexes of matching sets
+     * @param maxIndices Capacity of @p indices
+     * @return size_t Number of indexes written
+     * @note Scans the records in storage order
+     */
+    size_t findSSID(const char* ssid, uint16_t* indices, size_t maxIndices) const;
+
+    /**
+     * @brief CRC-32 (IEEE) as used for the blob checksum
+     * @param data Bytes to checksum
+     * @param length Number of bytes
+     * @return uint32_t The CRC
+     */
+    static uint32_t crc32(const uint8_t* data, size_t length);
+
+private:
+    const uint8_t* _data;
+    size_t _size;              ///< Blob size from the header, at most the size passed to begin()
+    size_t _count;
+    size_t _defaultIndex;
+
+    /// First byte of a record, or nullptr if its offset or lengths point outside the blob
+    const uint8_t* record(size_t index) const;
+
+    /**
+     * @brief Binary search for a name
+     * @return size_t Record index, or the record count if not found
+     */
+    size_t find(const char* name) const;
+
+    CredentialView makeView(size_t index, CredentialResolution resolution) const;
+};
+
+#endif // WIFICREDS_BLOB_H
@@ -0,0 +1,205 @@
+/**
+ * @file WiFiCredsChannelMap.cpp
+ * @brief Implementation of the learned channel map
+ * @author Rithik Krisna M
+ * @version 1.0.4
+ * @date 2025
+ */
+
+#include "WiFiCredsChannelMap.h"
+#include "WiFiCredsBlob.h"
+#include "WiFiCredsIndex.h"
+
+namespace {
+
+const uint32_t MAP_MAGIC = 0x314D4357UL; // "WCM1" in little-endian byte order
+const size_t HEADER_SIZE = 8;
+const size_t ENTRY_SIZE = 8;
+const size_t CRC_SIZE = 4;
+
+// Bits 1 to WIFICREDS_MAX_CHANNEL; bit 0 and the bits above never hold a channel
+const uint16_t CHANNEL_BITS = static_cast<uint16_t>(((1U << (WIFICREDS_MAX_CHANNEL + 1)) - 1) & ~1U);
+
+static_assert(WIFICREDS_CHANNEL_MAP_SIZE > 0 && WIFICREDS_CHANNEL_MAP_SIZE <= 255,
+              "WIFICREDS_CHANNEL_MAP_SIZE out of range");
+
+uint32_t readU32(const uint8_t* p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+void writeU32(uint8_t* p, uint32_t value) {
+    p[0] = static_cast<uint8_t>(value);
+    p[1] = static_cast<uint8_t>(value >> 8);
+    p[2] = static_cast<uint8_t>(value >> 16);
+    p[3] = static_cast<uint8_t>(value >> 24);
+}
+
+} // namespace
+
+WiFiCredsChannelMap::WiFiCredsChannelMap(WiFiCredsStorage& storage)
+    : _storage(storage), _count(0), _sweeping(false), _dirty(false) {}
+
+bool WiFiCredsChannelMap::begin() {
+    uint8_t buffer[WIFICREDS_CHANNEL_MAP_STORAGE_SIZE];
+    
+    _count = 0;
+    _sweeping = false;
+    _dirty = false;
+    
+    if (!_storage.begin() || !_storage.read(0, buffer, HEADER_SIZE) || readU32(buffer) != MAP_MAGIC) {
+        return false;
+    }
+    const size_t count = readU32(buffer + 4);
+    if (count > WIFICREDS_CHANNEL_MAP_SIZE) {
+        return false;
+    }
+    
+    const size_t size = HEADER_SIZE + count * ENTRY_SIZE;
+    if (!_storage.read(HEADER_SIZE, buffer + HEADER_SIZE, size + CRC_SIZE - HEADER_SIZE) ||
+        readU32(buffer + size) != WiFiCredsBlob::crc32(buffer, size)) {
+        return false;
+    }
+    
+    for (size_t i = 0; i < count; i++) {
+        const uint8_t* p = buffer + HEADER_SIZE + i * ENTRY_SIZE;
+        const uint32_t masks = readU32(p + 4);
+        _entries[i].ssidHash = readU32(p);
+        _entries[i].channels = static_cast<uint16_t>(masks) & CHANNEL_BITS;
+        _entries[i].stale = static_cast<uint16_t>(masks >> 16) & CHANNEL_BITS;
+    }
+    _count = count;
+    return true;
+}
+
+bool WiFiCredsChannelMap::save() {
+    uint8_t buffer[WIFICREDS_CHANNEL_MAP_STORAGE_SIZE];
+    
+    if (!_dirty) {
+        return true;
+    }
+    
+    writeU32(buffer, MAP_MAGIC);
+    writeU32(buffer + 4, static_cast<uint32_t>(_count));
+    for (size_t i = 0; i < _count; i++) {
+        uint8_t* p = buffer + HEADER_SIZE + i * ENTRY_SIZE;
+        writeU32(p, _entries[i].ssidHash);
+        writeU32(p + 4, _entries[i].channels | (static_cast<uint32_t>(_entries[i].stale) << 16));
+    }
+    const size_t size = HEADER_SIZE + _count * ENTRY_SIZE;
+    writeU32(buffer + size, WiFiCredsBlob::crc32(buffer, size));
+    
+    if (!_storage.write(0, buffer, size + CRC_SIZE) || !_storage.commit()) {
+        return false;
+    }
+    _dirty = false;
+    return true;
+}
+
+void WiFiCredsChannelMap::learn(const char* ssid, uint8_t channel) {
+    if (ssid == nullptr || ssid[0] == '\0' || channel == 0 || channel > WIFICREDS_MAX_CHANNEL) {
+        return;
+    }
+    
+    const uint32_t hash = WiFiCredsIndex::hashName(ssid, 0);
+    const uint16_t bit = static_cast<uint16_t>(1U << channel);
+    int index = indexOf(hash);
+    
+    Entry entry;
+    uint16_t sweep = 0;
+    if (index >= 0) {
+        entry = _entries[index];
+        sweep = _sweep[index];
+    } else {
+        // A new SSID takes the place of the one seen least recently
+        entry.ssidHash = hash;
+        entry.channels = 0;
+        entry.stale = 0;
+        index = static_cast<int>((_count < WIFICREDS_CHANNEL_MAP_SIZE) ? _count++ : _count - 1);
+    }
+    
+    if ((entry.channels & bit) == 0) {
+        entry.channels |= bit;
+        _dirty = true;
+    }
+    entry.stale &= static_cast<uint16_t>(~bit);
+    if (_sweeping) {
+        sweep |= bit;
+    }
+    
+    // Most recently seen first; eviction takes the last entry
+    for (; index > 0; index--) {
+        _entries[index] = _entries[index - 1];
+        _sweep[index] = _sweep[index - 1];
+    }
+    _entries[0] = entry;
+    _sweep[0] = sweep;
+}
+
+void WiFiCredsChannelMap::beginSweep() {
+    for (size_t i = 0; i < _count; i++) {
+        _sweep[i] = 0;
+    }
+    _sweeping = true;
+}
+
+void WiFiCredsChannelMap::endSweep() {
+    if (!_sweeping) {
+        return;
+    }
+    _sweeping = false;
+    
+    // SSIDs the sweep did not see at all keep their channels; they may just be out of range
+    for (size_t i = 0; i < _count; i++) {
+        if (_sweep[i] == 0) {
+            continue;
+        }
+        const uint16_t missing = _entries[i].channels & static_cast<uint16_t>(~_sweep[i]);
+        const uint16_t drop = missing & _entries[i].stale;
+        if (drop != 0) {
+            _entries[i].channels &= static_cast<uint16_t>(~drop);
+            _dirty = true;
+        }
+        _entries[i].stale = missing & static_cast<uint16_t>(~drop);
+    }
+}
+
+uint16_t WiFiCredsChannelMap::channels(const char* ssid) const {
+    if (ssid == nullptr) {
+        return 0;
+    }
+    const int index = indexOf(WiFiCredsIndex::hashName(ssid, 0));
+    return (index >= 0) ? _entries[index].channels : 0;
+}
+
+uint16_t WiFiCredsChannelMap::knownChannels() const {
+    uint16_t mask = 0;
+    for (size_t i = 0; i < _count; i++) {
+        mask |= _entries[i].channels;
+    }
+    return mask;
+}
+
+void WiFiCredsChannelMap::clear() {
+    _dirty = _dirty || _count > 0;
+    _count = 0;
+}
+
+uint8_t WiFiCredsChannelMap::channelCount(uint16_t mask) {
+    uint8_t count = 0;
+    for (; mask != 0; mask &= static_cast<uint16_t>(mask - 1)) {
+        count++;
+    }
+    return count;
+}
+
+// ===== PRIVATE HELPER METHODS =====
+
+int WiFiCredsChannelMap::indexOf(uint32_t ssidHash) const {
+    for (size_t i = 0; i < _count; i++) {
+        if (_entries[i].ssidHash == ssidHash) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
\ No newline at end of file
@@ -0,0 +1,160 @@
+/**
+ * @file WiFiCredsChannelMap.h
+ * @brief Learned and persisted channel sets of known SSIDs
+ * @author Rithik Krisna M
+ * @version 1.0.4
+ * @date 2025
+ *
+ * A scan of the whole 2.4 GHz band visits 13 channels, although the
+ * networks in CREDENTIAL_SETS are usually found on one or two of them.
+ * WiFiCredsChannelMap remembers on which channels each known SSID has been
+ * seen, so WiFiCredsScanScheduler can scan only those channels and run a
+ * full sweep only now and then. Scan time then grows with the number of
+ * known channels instead of the width of the band.
+ *
+ * The map is a small table (WIFICREDS_CHANNEL_MAP_SIZE entries of 8 bytes)
+ * keyed by a hash of the SSID, so it stays valid when credgen reorders the
+ * credential table. The least recently seen SSID is replaced when it is
+ * full. Scans only ever add channels; a full sweep drops a
+ * channel once two sweeps in a row saw the SSID elsewhere but not there,
+ * so a network near the edge of range does not flip the map back and forth.
+ *
+ * Storage layout: magic "WCM1", entry count, entries, CRC-32. save() only
+ * writes after a channel set changed, which after the first few scans is
+ * rare, so the map can live in EEPROM or flash.
+ */
+
+#ifndef WIFICREDS_CHANNEL_MAP_H
+#define WIFICREDS_CHANNEL_MAP_H
+
+#include "WiFiCreds.h"
+#include "WiFiCredsStorage.h"
+
+/**
+ * @def WIFICREDS_CHANNEL_MAP_SIZE
+ * @brief Maximum number of SSIDs whose channels are remembered
+ */
+#ifndef WIFICREDS_CHANNEL_MAP_SIZE
+#define WIFICREDS_CHANNEL_MAP_SIZE 16
+#endif
+
+/// Highest 2.4 GHz channel number
+#define WIFICREDS_MAX_CHANNEL 14
+
+/// Storage bytes needed by WiFiCredsChannelMap::save() for a full map
+#define WIFICREDS_CHANNEL_MAP_STORAGE_SIZE (8 + WIFICREDS_CHANNEL_MAP_SIZE * 8 + 4)
+
+/**
+ * @class WiFiCredsChannelMap
+ * @brief Channels each known SSID has been seen on, as bit masks
+ *
+ * Bit n of a mask stands for channel n (1 to WIFICREDS_MAX_CHANNEL).
+ *
+ * @code
+ * WiFiCredsEepromStorage channelStorage(0, WIFICREDS_CHANNEL_MAP_STORAGE_SIZE);
+ * WiFiCredsChannelMap channels(channelStorage);
+ * WiFiCredsScanScheduler scanner(driver, channels);
+ *
+ * void setup() {
+ *     channels.begin(); // an empty map makes the first scan a full sweep
+ * }
+ * @endcode
+ */
+class WiFiCredsChannelMap {
+public:
+    /**
+     * @brief Create an empty map
+     * @param storage Region the map is loaded from and saved to
+     */
+    explicit WiFiCredsChannelMap(WiFiCredsStorage& storage);
+
+    /**
+     * @brief Load the map saved last
+     * @return true if a valid map was loaded, false if the map starts empty
+     */
+    bool begin();
+
+    /**
+     * @brief Save the map if a channel set changed since it was loaded or saved
+     * @return true if the stored map is up to date, false if writing failed
+     */
+    bool save();
+
+    /**
+     * @brief Record that an SSID was seen on a channel
+     *
+     * Call it for networks in CREDENTIAL_SETS only; the scheduler does so
+     * for every scan result that matches a credential set. Also useful
+     * after connecting, with the channel the link ended up on.
+     *
+     * @param ssid Network SSID
+     * @param channel Channel it was seen on (1 to WIFICREDS_MAX_CHANNEL; others are ignored)
+     */
+    void learn(const char* ssid, uint8_t channel);
+
+    /**
+     * @brief Start a full sweep; learn() calls until endSweep() belong to it
+     */
+    void beginSweep();
+
+    /**
+     * @brief Finish a full sweep and drop channels the sweep contradicted twice in a row
+     */
+    void endSweep();
+
+    /**
+     * @brief Channels an SSID has been seen on
+     * @param ssid Network SSID
+     * @return uint16_t Channel mask, 0 if the SSID is not in the map
+     */
+    uint16_t channels(const char* ssid) const;
+
+    /**
+     * @brief Channels any known SSID has been seen on
+     * @return uint16_t Channel mask, 0 if the map is empty
+     */
+    uint16_t knownChannels() const;
+
+    /// Number of SSIDs in the map
+    size_t count() const { return _count; }
+
+    /// true if a channel set changed since the map was loaded or saved
+    bool dirty() const { return _dirty; }
+
+    /**
+     * @brief Forget all SSIDs; the next save() stores an empty map
+     */
+    void clear();
+
+    /**
+     * @brief Number of channels in a mask
+     * @param mask Channel mask
+     * @return uint8_t Number of set bits
+     */
+    static uint8_t channelCount(uint16_t mask);
+
+private:
+    /**
+     * @brief One SSID and its channels, as stored
+     */
+    struct Entry {
+        uint32_t ssidHash;
+        uint16_t channels; ///< Channels the SSID has been seen on
+        uint16_t stale;    ///< Channels the last full sweep did not confirm
+    };
+
+    WiFiCredsStorage& _storage;
+    Entry _entries[WIFICREDS_CHANNEL_MAP_SIZE]; ///< Most recently seen first
+    uint16_t _sweep[WIFICREDS_CHANNEL_MAP_SIZE]; ///< Channels seen by the running sweep
+    size_t _count;
+    bool _sweeping;
+    bool _dirty;
+
+    /**
+     * @brief Position of an SSID hash in the table
+     * @return int Index, or -1 if the SSID is not in the map
+     */
+    int indexOf(uint32_t ssidHash) const;
+};
+
+#endif // WIFICREDS_CHANNEL_MAP_H
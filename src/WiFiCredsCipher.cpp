@@ -0,0 +1,186 @@
+/**
+ * @file WiFiCredsCipher.cpp
+ * @brief Implementation of ChaCha20 and the device key for the WiFiCreds library
+ * @author Rithik Krisna M
+ * @version 1.0.4
+ * @date 2025
+ */
+
+#include "WiFiCredsCipher.h"
+
+#if defined(ARDUINO_ARCH_RP2040)
+#include <pico/unique_id.h>
+#endif
+
+namespace {
+
+// Key that sealed passwords are decrypted with, set by setKey()
+uint8_t deviceKey[WIFICREDS_CIPHER_KEY_LENGTH];
+bool keySet = false;
+
+inline uint32_t rotl(uint32_t value, unsigned bits) {
+    return (value << bits) | (value >> (32 - bits));
+}
+
+inline uint32_t load32(const uint8_t* p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+// Takes references so the compiler keeps the whole state in registers where it can
+inline void quarterRound(uint32_t& a, uint32_t& b, uint32_t& c, uint32_t& d) {
+    a += b; d = rotl(d ^ a, 16);
+    c += d; b = rotl(b ^ c, 12);
+    a += b; d = rotl(d ^ a, 8);
+    c += d; b = rotl(b ^ c, 7);
+}
+
+/**
+ * @brief One 64-byte ChaCha20 keystream block (RFC 8439, section 2.3)
+ */
+void chachaBlock(const uint8_t key[WIFICREDS_CIPHER_KEY_LENGTH], const uint8_t nonce[WIFICREDS_SEALED_NONCE_LENGTH],
+                 uint32_t counter, uint8_t out[WIFICREDS_CIPHER_BLOCK_LENGTH]) {
+    uint32_t state[16];
+    state[0] = 0x61707865UL; // "expand 32-byte k"
+    state[1] = 0x3320646eUL;
+    state[2] = 0x79622d32UL;
+    state[3] = 0x6b206574UL;
+    for (size_t i = 0; i < 8; i++) {
+        state[4 + i] = load32(key + i * 4);
+    }
+    state[12] = counter;
+    for (size_t i = 0; i < 3; i++) {
+        state[13 + i] = load32(nonce + i * 4);
+    }
+
+    uint32_t x[16];
+    for (size_t i = 0; i < 16; i++) {
+        x[i] = state[i];
+    }
+    for (size_t i = 0; i < 10; i++) {
+        quarterRound(x[0], x[4], x[8], x[12]);
+        quarterRound(x[1], x[5], x[9], x[13]);
+        quarterRound(x[2], x[6], x[10], x[14]);
+        quarterRound(x[3], x[7], x[11], x[15]);
+        quarterRound(x[0], x[5], x[10], x[15]);
+        quarterRound(x[1], x[6], x[11], x[12]);
+        quarterRound(x[2], x[7], x[8], x[13]);
+        quarterRound(x[3], x[4], x[9], x[14]);
+    }
+
+    for (size_t i = 0; i < 16; i++) {
+        const uint32_t word = x[i] + state[i];
+        out[i * 4] = static_cast<uint8_t>(word);
+        out[i * 4 + 1] = static_cast<uint8_t>(word >> 8);
+        out[i * 4 + 2] = static_cast<uint8_t>(word >> 16);
+        out[i * 4 + 3] = static_cast<uint8_t>(word >> 24);
+    }
+
+    // Both arrays hold key material
+    WiFiCredsCipher::wipe(state, sizeof(state));
+    WiFiCredsCipher::wipe(x, sizeof(x));
+}
+
+} // namespace
+
+void WiFiCredsCipher::setKey(const uint8_t key[WIFICREDS_CIPHER_KEY_LENGTH]) {
+    for (size_t i = 0; i < WIFICREDS_CIPHER_KEY_LENGTH; i++) {
+        deviceKey[i] = key[i];
+    }
+    keySet = true;
+}
+
+bool WiFiCredsCipher::beginDeviceKey(const uint8_t master[WIFICREDS_CIPHER_KEY_LENGTH]) {
+    uint8_t id[WIFICREDS_DEVICE_ID_LENGTH];
+    if (!deviceId(id)) {
+        return false;
+    }
+    uint8_t key[WIFICREDS_CIPHER_KEY_LENGTH];
+    deriveKey(master, id, sizeof(id), key);
+    setKey(key);
+    wipe(key, sizeof(key));
+    return true;
+}
+
+void WiFiCredsCipher::clearKey() {
+    keySet = false;
+    wipe(deviceKey, sizeof(deviceKey));
+}
+
+bool WiFiCredsCipher::hasKey() {
+    return keySet;
+}
+
+bool WiFiCredsCipher::deviceId(uint8_t id[WIFICREDS_DEVICE_ID_LENGTH]) {
+#if defined(ESP32)
+    const uint64_t mac = ESP.getEfuseMac();
+    for (size_t i = 0; i < WIFICREDS_DEVICE_ID_LENGTH; i++) {
+        id[i] = static_cast<uint8_t>(mac >> (i * 8));
+    }
+    return true;
+#elif defined(ESP8266)
+    const uint32_t chip = ESP.getChipId();
+    const uint32_t flash = ESP.getFlashChipId();
+    for (size_t i = 0; i < 4; i++) {
+        id[i] = static_cast<uint8_t>(chip >> (i * 8));
+        id[4 + i] = static_cast<uint8_t>(flash >> (i * 8));
+    }
+    return true;
+#elif defined(ARDUINO_ARCH_RP2040)
+    pico_unique_board_id_t board;
+    pico_get_unique_board_id(&board);
+    for (size_t i = 0; i < WIFICREDS_DEVICE_ID_LENGTH; i++) {
+        id[i] = board.id[i];
+    }
+    return true;
+#else
+    (void)id;
+    return false;
+#endif
+}
+
+void WiFiCredsCipher::deriveKey(const uint8_t master[WIFICREDS_CIPHER_KEY_LENGTH], const uint8_t* id, size_t idLength,
+                                uint8_t key[WIFICREDS_CIPHER_KEY_LENGTH]) {
+    uint8_t nonce[WIFICREDS_SEALED_NONCE_LENGTH] = {0};
+    for (size_t i = 0; i < idLength && i < sizeof(nonce); i++) {
+        nonce[i] = id[i];
+    }
+    uint8_t block[WIFICREDS_CIPHER_BLOCK_LENGTH];
+    chachaBlock(master, nonce, 0, block);
+    for (size_t i = 0; i < WIFICREDS_CIPHER_KEY_LENGTH; i++) {
+        key[i] = block[i];
+    }
+    wipe(block, sizeof(block));
+}
+
+bool WiFiCredsCipher::unseal(const uint8_t* sealed, size_t length, char* buffer, size_t size) {
+    if (!keySet || sealed == nullptr || buffer == nullptr || size <= length) {
+        return false;
+    }
+    crypt(deviceKey, sealed, 0, sealed + WIFICREDS_SEALED_NONCE_LENGTH, reinterpret_cast<uint8_t*>(buffer), length);
+    buffer[length] = '\0';
+    return true;
+}
+
+void WiFiCredsCipher::crypt(const uint8_t key[WIFICREDS_CIPHER_KEY_LENGTH],
+                            const uint8_t nonce[WIFICREDS_SEALED_NONCE_LENGTH], uint32_t counter, const uint8_t* in,
+                            uint8_t* out, size_t length) {
+    uint8_t stream[WIFICREDS_CIPHER_BLOCK_LENGTH];
+    for (size_t offset = 0; offset < length; offset += WIFICREDS_CIPHER_BLOCK_LENGTH) {
+        chachaBlock(key, nonce, counter++, stream);
+        const size_t chunk = (length - offset < WIFICREDS_CIPHER_BLOCK_LENGTH) ? length - offset
+                                                                               : WIFICREDS_CIPHER_BLOCK_LENGTH;
+        for (size_t i = 0; i < chunk; i++) {
+            out[offset + i] = in[offset + i] ^ stream[i];
+        }
+    }
+    wipe(stream, sizeof(stream));
+}
+
+void WiFiCredsCipher::wipe(void* data, size_t length) {
+    // Stores through a volatile pointer are not removed as dead stores
+    volatile uint8_t* bytes = static_cast<volatile uint8_t*>(data);
+    for (size_t i = 0; i < length; i++) {
+        bytes[i] = 0;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,150 @@
+/**
+ * @file WiFiCredsCipher.h
+ * @brief ChaCha20 encryption of passwords at rest for the WiFiCreds library
+ * @author Rithik Krisna M
+ * @version 1.0.4
+ * @date 2025
+ *
+ * Passwords in credentials.h normally sit in flash as plaintext. Entries
+ * declared with WIFICREDS_SET_SEALED() hold the password encrypted with
+ * ChaCha20 instead (credgen --key writes them): a 12-byte nonce followed
+ * by the ciphertext. The library decrypts a sealed password only into a
+ * buffer the caller owns (WiFiCreds::copyPassword()) or into a stack
+ * buffer it wipes before returning (getPMK(), WiFiCredsConnection).
+ *
+ * The key is device-unique: deriveKey() mixes a master key with an ID read
+ * from the chip (deviceId()), so a header generated for one board does not
+ * decrypt on another. Where the master key comes from is up to the sketch.
+ * Keep it out of the firmware image (ESP32 eFuse key block, encrypted NVS,
+ * a secure element, EEPROM written at provisioning); a key compiled into
+ * the same image only obfuscates the passwords.
+ *
+ * A password is at most 64 bytes, which is one ChaCha20 block: 20 double
+ * rounds of 32-bit additions, XORs and rotations, constant time and with
+ * no tables.
+ *
+ * @note Portable C++, no hardware crypto or heap required
+ */
+
+#ifndef WIFICREDS_CIPHER_H
+#define WIFICREDS_CIPHER_H
+
+#include "WiFiCreds.h"
+
+/// Length of a ChaCha20 key in bytes
+#define WIFICREDS_CIPHER_KEY_LENGTH 32
+
+/// Bytes produced by one ChaCha20 block
+#define WIFICREDS_CIPHER_BLOCK_LENGTH 64
+
+/// Length of the ID returned by WiFiCredsCipher::deviceId()
+#define WIFICREDS_DEVICE_ID_LENGTH 8
+
+/**
+ * @class WiFiCredsCipher
+ * @brief ChaCha20 (RFC 8439) and the device key used for sealed passwords
+ *
+ * @code
+ * uint8_t master[WIFICREDS_CIPHER_KEY_LENGTH];
+ * loadMasterKey(master);                       // from eFuse, NVS, ...
+ * WiFiCredsCipher::beginDeviceKey(master);     // once in setup()
+ * WiFiCredsCipher::wipe(master, sizeof(master));
+ *
+ * char password[WIFICREDS_PASSWORD_BUFFER_SIZE];
+ * if (WiFiCreds::copyPassword("home", password, sizeof(password))) {
+ *     WiFi.begin(WiFiCreds::getSSID("home"), password);
+ *     WiFiCredsCipher::wipe(password, sizeof(password));
+ * }
+ * @endcode
+ */
+class WiFiCredsCipher {
+public:
+    /**
+     * @brief Set the key used to decrypt sealed passwords
+     * @param key 32-byte key, as passed to credgen --key (after deriveKey() if --device-id was used)
+     */
+    static void setKey(const uint8_t key[WIFICREDS_CIPHER_KEY_LENGTH]);
+
+    /**
+     * @brief Derive the device key from a master key and set it
+     *
+     * Equivalent to deriveKey() with the ID from deviceId(), then setKey().
+     *
+     * @param master 32-byte master key
+     * @return true if the key was set, false if the board has no readable device ID
+     */
+    static bool beginDeviceKey(const uint8_t master[WIFICREDS_CIPHER_KEY_LENGTH]);
+
+    /**
+     * @brief Forget the key; sealed passwords cannot be read until the next setKey()
+     */
+    static void clearKey();
+
+    /// true once a key has been set
+    static bool hasKey();
+
+    /**
+     * @brief Read the unique ID of the chip
+     *
+     * ESP32: factory MAC in eFuse. ESP8266: chip ID and flash chip ID.
+     * Raspberry Pi Pico: unique ID of the flash chip.
+     *
+     * @param id Receives WIFICREDS_DEVICE_ID_LENGTH bytes, as printed for credgen --device-id
+     * @return true on success, false on boards without a readable ID (and in host builds)
+     */
+    static bool deviceId(uint8_t id[WIFICREDS_DEVICE_ID_LENGTH]);
+
+    /**
+     * @brief Derive a per-device key
+     *
+     * The key is the first 32 bytes of the ChaCha20 block for @p master
+     * with the device ID as nonce.
+     *
+     * @param master 32-byte master key
+     * @param id Device ID
+     * @param idLength Length of @p id; at most 12 bytes are used
+     * @param key Receives the 32-byte device key
+     */
+    static void deriveKey(const uint8_t master[WIFICREDS_CIPHER_KEY_LENGTH], const uint8_t* id, size_t idLength,
+                          uint8_t key[WIFICREDS_CIPHER_KEY_LENGTH]);
+
+    /**
+     * @brief Decrypt a sealed password with the key from setKey()
+     *
+     * @param sealed Nonce (WIFICREDS_SEALED_NONCE_LENGTH bytes) followed by the ciphertext, in RAM
+     * @param length Length of the password (the ciphertext)
+     * @param buffer Receives the null-terminated password
+     * @param size Size of @p buffer in bytes
+     * @return true on success, false if no key is set or the password does not fit
+     * @note Decryption cannot detect a wrong key; the result is then an unusable password
+     */
+    static bool unseal(const uint8_t* sealed, size_t length, char* buffer, size_t size);
+
+    /**
+     * @brief ChaCha20 encryption and decryption (the same operation)
+     *
+     * @param key 32-byte key
+     * @param nonce 12-byte nonce, never reused with the same key
+     * @param counter Block counter of the first block
+     * @param in Input bytes
+     * @param out Receives @p length bytes; may be the same as @p in
+     * @param length Number of bytes
+     */
+    static void crypt(const uint8_t key[WIFICREDS_CIPHER_KEY_LENGTH], const uint8_t nonce[WIFICREDS_SEALED_NONCE_LENGTH],
+                      uint32_t counter, const uint8_t* in, uint8_t* out, size_t length);
+
+    /**
+     * @brief Overwrite memory with zeros in a way the compiler does not remove
+     * @param data Memory to clear
+     * @param length Number of bytes
+     */
+    static void wipe(void* data, size_t length);
+
+private:
+    // Prevent instantiation of this class
+    WiFiCredsCipher() = delete;
+    WiFiCredsCipher(const WiFiCredsCipher&) = delete;
+    WiFiCredsCipher& operator=(const WiFiCredsCipher&) = delete;
+};
+
+#endif // WIFICREDS_CIPHER_H
@@ -0,0 +1,138 @@
+/**
+ * @file WiFiCredsConnection.cpp
+ * @brief Implementation of the non-blocking connection manager
+ * @author Rithik Krisna M
+ * @version 1.0.4
+ * @date 2025
+ */
+
+#include "WiFiCredsConnection.h"
+#include "WiFiCredsCipher.h"
+
+namespace {
+
+// Marks "nothing attempted yet"; resolveIndex() reports it as CredentialResolution::None
+const size_t NO_CREDENTIAL = static_cast<size_t>(-1);
+
+} // namespace
+
+WiFiCredsConnection::WiFiCredsConnection(WiFiCredsDriver& driver)
+    : _driver(driver), _handler(nullptr), _context(nullptr),
+      _state(WiFiCredsConnectionState::Idle), _index(NO_CREDENTIAL),
+      _startedAt(0), _timeoutMs(WIFICREDS_CONNECT_TIMEOUT), _lastDurationMs(0) {}
+
+void WiFiCredsConnection::onEvent(WiFiCredsEventHandler handler, void* context) {
+    _handler = handler;
+    _context = context;
+}
+
+bool WiFiCredsConnection::connect(const char* name, uint32_t timeoutMs) {
+    CredentialView creds = WiFiCreds::resolve(name);
+    if (creds.resolution == CredentialResolution::None) {
+        return false;
+    }
+    return connectIndex(creds.index, timeoutMs);
+}
+
+bool WiFiCredsConnection::connectIndex(size_t index, uint32_t timeoutMs, uint8_t channel, const uint8_t* bssid) {
+    CredentialView creds = WiFiCreds::resolveIndex(index);
+    if (creds.resolution == CredentialResolution::None) {
+        return false;
+    }
+
+    // Decrypted or converted into the stack buffer, which is wiped once the driver has it
+    char psk[WIFICREDS_PSK_HEX_SIZE];
+    const char* password = WiFiCreds::getConnectKey(creds, psk);
+    if (password == nullptr) {
+        return false;
+    }
+
+    if (_state != WiFiCredsConnectionState::Idle) {
+        _driver.disconnect();
+    }
+
+    _index = index;
+    _timeoutMs = (timeoutMs == WIFICREDS_TIMEOUT_LEARNED) ? WiFiCredsStats::timeout(index) : timeoutMs;
+    _state = WiFiCredsConnectionState::Connecting;
+    _startedAt = _driver.now();
+    _driver.begin(creds.ssid, password, channel, bssid);
+    WiFiCredsCipher::wipe(psk, sizeof(psk));
+
+    emit(WiFiCredsEvent::Connecting);
+    return true;
+}
+
+void WiFiCredsConnection::disconnect() {
+    if (_state != WiFiCredsConnectionState::Idle) {
+        _driver.disconnect();
+        _state = WiFiCredsConnectionState::Idle;
+    }
+}
+
+WiFiCredsConnectionState WiFiCredsConnection::poll() {
+    if (_state == WiFiCredsConnectionState::Idle) {
+        return _state;
+    }
+
+    const WiFiCredsLinkStatus status = _driver.status();
+
+    if (_state == WiFiCredsConnectionState::Connected) {
+        if (status != WiFiCredsLinkStatus::Connected) {
+            _state = WiFiCredsConnectionState::Idle;
+            emit(WiFiCredsEvent::Disconnected);
+        }
+        return _state;
+    }
+
+    const uint32_t now = _driver.now();
+
+    switch (status) {
+        case WiFiCredsLinkStatus::Connected:
+            finishAttempt(WiFiCredsEvent::Connected, now);
+            break;
+        case WiFiCredsLinkStatus::NoSsid:
+        case WiFiCredsLinkStatus::ConnectFailed:
+            finishAttempt(WiFiCredsEvent::Failed, now);
+            break;
+        default:
+            // Unsigned subtraction keeps working across millis() wrap-around
+            if (now - _startedAt >= _timeoutMs) {
+                finishAttempt(WiFiCredsEvent::Timeout, now);
+            }
+            break;
+    }
+
+    return _state;
+}
+
+CredentialView WiFiCredsConnection::credentials() const {
+    return WiFiCreds::resolveIndex(_index);
+}
+
+// ===== PRIVATE HELPER METHODS =====
+
+void WiFiCredsConnection::finishAttempt(WiFiCredsEvent event, uint32_t now) {
+    _lastDurationMs = now - _startedAt;
+
+    if (event == WiFiCredsEvent::Connected) {
+        WiFiCredsStats::recordSuccess(_index, _lastDurationMs);
+        _state = WiFiCredsConnectionState::Connected;
+    } else {
+        if (event == WiFiCredsEvent::Timeout) {
+            WiFiCredsStats::recordTimeout(_index, _lastDurationMs);
+        } else {
+            WiFiCredsStats::recordFailure(_index);
+        }
+        // Stop the radio from retrying in the background
+        _driver.disconnect();
+        _state = WiFiCredsConnectionState::Idle;
+    }
+
+    emit(event);
+}
+
+void WiFiCredsConnection::emit(WiFiCredsEvent event) {
+    if (_handler != nullptr) {
+        _handler(event, credentials(), _context);
+    }
+}
\ No newline at end of file
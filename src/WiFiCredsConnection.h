@@ -0,0 +1,177 @@
+/**
+ * @file WiFiCredsConnection.h
+ * @brief Non-blocking connection manager for the WiFiCreds library
+ * @author Rithik Krisna M
+ * @version 1.0.4
+ * @date 2025
+ *
+ * WiFiCredsConnection replaces the usual "begin, then delay() until
+ * connected or timed out" loop with a small state machine. connect() starts
+ * an attempt and returns immediately; poll() is called from loop() and only
+ * reads the driver status once, so the sketch keeps running its own work
+ * while the radio connects. Progress is reported through an event callback.
+ */
+
+#ifndef WIFICREDS_CONNECTION_H
+#define WIFICREDS_CONNECTION_H
+
+#include "WiFiCreds.h"
+#include "WiFiCredsDriver.h"
+#include "WiFiCredsStats.h"
+
+/// Timeout value that selects the learned per-network timeout (WiFiCredsStats::timeout())
+#define WIFICREDS_TIMEOUT_LEARNED 0UL
+
+/**
+ * @enum WiFiCredsConnectionState
+ * @brief State of a WiFiCredsConnection
+ */
+enum class WiFiCredsConnectionState : uint8_t {
+    Idle,       ///< No attempt in progress and not connected
+    Connecting, ///< An attempt is in progress
+    Connected   ///< The link is up
+};
+
+/**
+ * @enum WiFiCredsEvent
+ * @brief Events reported to the event handler
+ */
+enum class WiFiCredsEvent : uint8_t {
+    Connecting,  ///< An attempt was started
+    Connected,   ///< The attempt succeeded
+    Failed,      ///< The network was not found or rejected the connection
+    Timeout,     ///< The attempt did not finish within its timeout
+    Disconnected ///< An established link was lost
+};
+
+/**
+ * @brief Event handler type
+ *
+ * @param event What happened
+ * @param creds Credential set of the attempt or link the event belongs to
+ * @param context Pointer passed to WiFiCredsConnection::onEvent()
+ */
+typedef void (*WiFiCredsEventHandler)(WiFiCredsEvent event, const CredentialView& creds, void* context);
+
+/**
+ * @class WiFiCredsConnection
+ * @brief Poll-driven connection state machine
+ *
+ * After Failed, Timeout or Disconnected the state is Idle again and the
+ * sketch decides what to try next; nothing is retried automatically.
+ * Every finished attempt is recorded in WiFiCredsStats, and attempts
+ * without an explicit timeout use the timeout learned from those records.
+ *
+ * @code
+ * WiFiCredsArduinoDriver driver;
+ * WiFiCredsConnection connection(driver);
+ *
+ * void setup() {
+ *     connection.onEvent(onWiFiEvent);
+ *     connection.connect("home");
+ * }
+ *
+ * void loop() {
+ *     if (connection.poll() == WiFiCredsConnectionState::Idle) {
+ *         connection.connect("home");
+ *     }
+ *     readSensors(); // keeps running while Wi-Fi connects
+ * }
+ * @endcode
+ */
+class WiFiCredsConnection {
+public:
+    /**
+     * @brief Create a connection manager
+     * @param driver Driver used for all radio operations
+     */
+    explicit WiFiCredsConnection(WiFiCredsDriver& driver);
+
+    /**
+     * @brief Set the event handler
+     * @param handler Function called for every event, or nullptr for none
+     * @param context Passed through to @p handler
+     */
+    void onEvent(WiFiCredsEventHandler handler, void* context = nullptr);
+
+    /**
+     * @brief Start connecting with a named credential set
+     *
+     * Any attempt or link in progress is dropped first. Follows the usual
+     * name resolution, so nullptr or an unknown name use the default set.
+     *
+     * @param name Name of the credential set (nullptr for default)
+     * @param timeoutMs Time after which poll() abandons the attempt, or WIFICREDS_TIMEOUT_LEARNED
+     * @return true if an attempt was started, false if no credential set is available or a sealed
+     *         password cannot be decrypted (no key set)
+     */
+    bool connect(const char* name = nullptr, uint32_t timeoutMs = WIFICREDS_TIMEOUT_LEARNED);
+
+    /**
+     * @brief Start connecting with a credential set by index
+     *
+     * @param index Index of the credential set in CREDENTIAL_SETS
+     * @param timeoutMs Time after which poll() abandons the attempt, or WIFICREDS_TIMEOUT_LEARNED
+     * @param channel Channel to use, or 0 to let the driver search
+     * @param bssid Access point to associate with, or nullptr for any
+     * @return true if an attempt was started, false if the index is invalid or a sealed password
+     *         cannot be decrypted (no key set)
+     * @note A PMK stored in credentials.h is used as hex PSK; the PMK is never derived
+     *       here, because PBKDF2 would block the caller for seconds
+     */
+    bool connectIndex(size_t index, uint32_t timeoutMs = WIFICREDS_TIMEOUT_LEARNED,
+                      uint8_t channel = 0, const uint8_t* bssid = nullptr);
+
+    /**
+     * @brief Drop the current attempt or link without reporting an event
+     */
+    void disconnect();
+
+    /**
+     * @brief Advance the state machine; call this from loop()
+     *
+     * Reads the driver status once and the clock once, and fires at most
+     * one event. Never waits.
+     *
+     * @return WiFiCredsConnectionState The state after this poll
+     */
+    WiFiCredsConnectionState poll();
+
+    /// Current state, as of the last connect(), disconnect() or poll()
+    WiFiCredsConnectionState state() const { return _state; }
+
+    /// true if the link is up, as of the last poll()
+    bool isConnected() const { return _state == WiFiCredsConnectionState::Connected; }
+
+    /**
+     * @brief Credential set of the current or last attempt
+     * @return CredentialView View with CredentialResolution::None if nothing was attempted yet
+     */
+    CredentialView credentials() const;
+
+    /**
+     * @brief Duration of the last finished attempt
+     * @return uint32_t Milliseconds from connect() to the Connected, Failed or Timeout event
+     */
+    uint32_t lastAttemptDuration() const { return _lastDurationMs; }
+
+private:
+    WiFiCredsDriver& _driver;
+    WiFiCredsEventHandler _handler;
+    void* _context;
+
+    WiFiCredsConnectionState _state;
+    size_t _index;             ///< Credential index of the current or last attempt
+    uint32_t _startedAt;       ///< Driver time when the current attempt started
+    uint32_t _timeoutMs;
+    uint32_t _lastDurationMs;
+
+    /**
+     * @brief Finish the current attempt, record it in WiFiCredsStats and report the outcome
+     */
+    void finishAttempt(WiFiCredsEvent event, uint32_t now);
+
+    void emit(WiFiCredsEvent event);
+};
+
+#endif // WIFICREDS_CONNECTION_H
@@ -0,0 +1,175 @@
+/**
+ * @file WiFiCredsDriver.h
+ * @brief Minimal Wi-Fi driver interface used by WiFiCreds components
+ * @author Rithik Krisna M
+ * @version 1.0.4
+ * @date 2025
+ *
+ * WiFiCreds components that talk to the radio do so through this small
+ * interface instead of a board-specific WiFi object. This keeps the library
+ * independent of any particular core and lets the same logic run on a host
+ * machine against WiFiCredsSimDriver.
+ *
+ * @note The interface mirrors the begin()/status()/scanNetworks() call pattern of the Arduino WiFi libraries
+ */
+
+#ifndef WIFICREDS_DRIVER_H
+#define WIFICREDS_DRIVER_H
+
+#include "WiFiCreds.h"
+
+/// Maximum SSID length defined by IEEE 802.11
+#define WIFICREDS_SSID_MAX_LENGTH 32
+
+/// WiFiCredsDriver::scanComplete(): a background scan is still running
+#define WIFICREDS_SCAN_RUNNING (-1)
+
+/// WiFiCredsDriver::scanComplete(): no background scan was started, or it failed
+#define WIFICREDS_SCAN_FAILED (-2)
+
+/**
+ * @enum WiFiCredsLinkStatus
+ * @brief Core-independent connection status
+ */
+enum class WiFiCredsLinkStatus : uint8_t {
+    Idle,          ///< No connection attempt in progress
+    Connecting,    ///< A connection attempt is in progress
+    Connected,     ///< Associated and an IP address is assigned
+    NoSsid,        ///< The requested network was not found
+    ConnectFailed, ///< The network was found but the connection was rejected
+    Disconnected   ///< A previously established connection was lost
+};
+
+/**
+ * @struct WiFiCredsScanEntry
+ * @brief One network reported by a scan
+ *
+ * @note The SSID is copied into a fixed buffer, so no heap is used per entry
+ */
+struct WiFiCredsScanEntry {
+    char ssid[WIFICREDS_SSID_MAX_LENGTH + 1]; ///< Null-terminated SSID
+    uint8_t bssid[6];                         ///< Access point MAC address
+    uint8_t channel;                          ///< Wi-Fi channel
+    int8_t rssi;                              ///< Signal strength in dBm
+    bool open;                                ///< true if the network has no encryption
+};
+
+/**
+ * @class WiFiCredsDriver
+ * @brief Abstract Wi-Fi driver used by WiFiCreds components
+ *
+ * Implement this interface to connect WiFiCreds components to a Wi-Fi
+ * library, or use WiFiCredsSimDriver on a host machine.
+ */
+class WiFiCredsDriver {
+public:
+    virtual ~WiFiCredsDriver() {}
+
+    /**
+     * @brief Start connecting to a network (non-blocking)
+     *
+     * @param ssid Network SSID
+     * @param password Network password
+     * @param channel Channel to use, or 0 to let the driver search
+     * @param bssid Access point to associate with, or nullptr for any
+     */
+    virtual void begin(const char* ssid, const char* password, uint8_t channel = 0, const uint8_t* bssid = nullptr) = 0;
+
+    /**
+     * @brief Get the current connection status
+     * @return WiFiCredsLinkStatus Current status
+     */
+    virtual WiFiCredsLinkStatus status() = 0;
+
+    /**
+     * @brief Drop the current connection or connection attempt
+     */
+    virtual void disconnect() = 0;
+
+    /**
+     * @brief Run a blocking scan for nearby networks
+     * @return int Number of networks found, or a negative value on failure
+     */
+    virtual int scanNetworks() = 0;
+
+    /**
+     * @brief Start a scan that runs in the background (non-blocking)
+     *
+     * Poll scanComplete() for the result. The default implementation is for
+     * drivers whose library only has blocking scans.
+     *
+     * A scan of one channel actively probes that channel only and takes
+     * about 1/13 of a full sweep, which is what makes WiFiCredsChannelMap
+     * worthwhile.
+     *
+     * @param channel Channel to scan, or 0 for the whole band
+     * @return true if the scan was started, false if background scans are not supported or failed to start
+     */
+    virtual bool startScan(uint8_t channel = 0) {
+        (void)channel;
+        return false;
+    }
+
+    /**
+     * @brief Check on the scan started with startScan()
+     * @return int Number of results once finished (read them with scanResult()),
+     *         WIFICREDS_SCAN_RUNNING while running, WIFICREDS_SCAN_FAILED if it failed or none was started
+     */
+    virtual int scanComplete() {
+        return WIFICREDS_SCAN_FAILED;
+    }
+
+    /**
+     * @brief Read one result of the last scan
+     *
+     * @param index Result index (0 to scanNetworks() - 1)
+     * @param entry Receives the result
+     * @return true if @p index is valid, false otherwise
+     */
+    virtual bool scanResult(int index, WiFiCredsScanEntry& entry) = 0;
+
+    /**
+     * @brief Signal strength of the current connection
+     * @return int8_t RSSI in dBm, or 0 when not connected
+     */
+    virtual int8_t rssi() = 0;
+
+    /**
+     * @brief Access point of the current connection
+     *
+     * @param bssid Receives the 6-byte MAC address
+     * @return true if connected and the driver can tell, false otherwise
+     */
+    virtual bool bssid(uint8_t bssid[6]) {
+        (void)bssid;
+        return false;
+    }
+
+    /**
+     * @brief Monotonic time used for timeouts
+     * @return uint32_t Milliseconds since start (millis() on Arduino), wrapping at 2^32
+     */
+    virtual uint32_t now() = 0;
+
+    /**
+     * @brief Use a static IP configuration for the next connection instead of DHCP
+     *
+     * Addresses are IPv4 in network byte order, as stored by the Arduino
+     * IPAddress class. Passing all zeros switches back to DHCP.
+     *
+     * @param localIP Device address
+     * @param gateway Gateway address
+     * @param subnet Subnet mask
+     * @param dns DNS server address
+     * @return true if applied, false if the driver does not support static configuration
+     */
+    virtual bool config(uint32_t localIP, uint32_t gateway, uint32_t subnet, uint32_t dns) {
+        (void)localIP;
+        (void)gateway;
+        (void)subnet;
+        (void)dns;
+        return false;
+    }
+};
+
+#endif // WIFICREDS_DRIVER_H
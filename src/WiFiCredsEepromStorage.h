@@ -0,0 +1,117 @@
+/**
+ * @file WiFiCredsEepromStorage.h
+ * @brief WiFiCredsStorage implementation for the Arduino EEPROM library
+ * @author Rithik Krisna M
+ * @version 1.0.4
+ * @date 2025
+ *
+ * Stores the WiFiCredsStore log in a range of the board's EEPROM:
+ * - AVR and Arduino UNO R4: real EEPROM, written byte by byte
+ * - ESP32: the EEPROM library keeps its data as an NVS blob
+ * - ESP8266 and Raspberry Pi Pico: a RAM copy of one flash sector, written back by commit()
+ *
+ * @note Header-only; include it after EEPROM.h
+ */
+
+#ifndef WIFICREDS_EEPROM_STORAGE_H
+#define WIFICREDS_EEPROM_STORAGE_H
+
+#if defined(ARDUINO)
+
+#include "WiFiCredsStorage.h"
+
+// Cores whose EEPROM library emulates EEPROM in RAM and needs begin()/commit()
+#if defined(ESP32) || defined(ESP8266) || defined(ARDUINO_ARCH_RP2040)
+#define WIFICREDS_EEPROM_EMULATED 1
+#else
+#define WIFICREDS_EEPROM_EMULATED 0
+#endif
+
+/**
+ * @class WiFiCredsEepromStorage
+ * @brief Storage region inside the EEPROM
+ *
+ * @code
+ * #include <EEPROM.h>
+ * #include <WiFiCredsEepromStorage.h>
+ *
+ * WiFiCredsEepromStorage storage(0, 512); // bytes 0..511
+ * WiFiCredsStore store(storage);
+ * @endcode
+ */
+class WiFiCredsEepromStorage : public WiFiCredsStorage {
+public:
+    /**
+     * @brief Use part of the EEPROM
+     *
+     * @param offset First EEPROM byte of the region
+     * @param size Size of the region in bytes
+     * @note On emulated EEPROM, EEPROM.begin(offset + size) is called by begin() or the first
+     *       access unless the sketch already called EEPROM.begin() with a size at least as large
+     */
+    WiFiCredsEepromStorage(size_t offset, size_t size) : _offset(offset), _size(size), _started(false) {}
+
+    bool begin() override {
+        return start();
+    }
+
+    size_t size() override {
+        return start() ? _size : 0;
+    }
+
+    bool read(size_t offset, void* data, size_t length) override {
+        if (!start() || offset > _size || length > _size - offset) {
+            return false;
+        }
+        uint8_t* bytes = static_cast<uint8_t*>(data);
+        for (size_t i = 0; i < length; i++) {
+            bytes[i] = EEPROM.read(static_cast<int>(_offset + offset + i));
+        }
+        return true;
+    }
+
+    bool write(size_t offset, const void* data, size_t length) override {
+        if (!start() || offset > _size || length > _size - offset) {
+            return false;
+        }
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < length; i++) {
+            // update() skips bytes that already hold the value, saving EEPROM cycles
+#if WIFICREDS_EEPROM_EMULATED
+            EEPROM.write(static_cast<int>(_offset + offset + i), bytes[i]);
+#else
+            EEPROM.update(static_cast<int>(_offset + offset + i), bytes[i]);
+#endif
+        }
+        return true;
+    }
+
+    bool commit() override {
+#if WIFICREDS_EEPROM_EMULATED
+        return start() && EEPROM.commit();
+#else
+        return true;
+#endif
+    }
+
+private:
+    size_t _offset;
+    size_t _size;
+    bool _started;
+
+    bool start() {
+        if (!_started) {
+#if WIFICREDS_EEPROM_EMULATED
+            if (EEPROM.length() < _offset + _size) {
+                EEPROM.begin(_offset + _size);
+            }
+#endif
+            _started = EEPROM.length() >= _offset + _size;
+        }
+        return _started;
+    }
+};
+
+#endif // ARDUINO
+
+#endif // WIFICREDS_EEPROM_STORAGE_H
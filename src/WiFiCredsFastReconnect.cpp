@@ -0,0 +1,135 @@
+/**
+ * @file WiFiCredsFastReconnect.cpp
+ * @brief Implementation of the deep-sleep fast-reconnect cache
+ * @author Rithik Krisna M
+ * @version 1.0.4
+ * @date 2025
+ */
+
+#include "WiFiCredsFastReconnect.h"
+#include "WiFiCredsBlob.h"
+#include "WiFiCredsCipher.h"
+#include <string.h>     // Required for memcpy, memset, memcmp and strlen
+
+namespace {
+
+const uint32_t RECORD_MAGIC = 0x57434652UL; // "WCFR"
+
+/**
+ * @brief Layout stored in RTC memory
+ * @note Kept a multiple of 4 bytes for the ESP8266 RTC user memory API
+ */
+struct RtcRecord {
+    uint32_t magic;
+    uint32_t ssidCrc;          ///< Detects a changed credential table after reflashing
+    WiFiCredsLinkState state;
+    uint32_t crc;              ///< CRC-32 of all preceding bytes
+};
+
+static_assert(sizeof(RtcRecord) % 4 == 0, "RtcRecord must be a whole number of 4-byte blocks");
+
+#if defined(ESP32)
+RTC_DATA_ATTR RtcRecord rtcRecord;
+#elif !defined(ESP8266)
+RtcRecord rtcRecord;
+#endif
+
+// Reads only the SSID: resolveIndex() would also copy the password into the shared PROGMEM buffer
+bool ssidCrc(size_t credentialIndex, uint32_t& crc) {
+    char ssid[WIFICREDS_SSID_BUFFER_SIZE];
+    if (!WiFiCreds::copySSIDAt(credentialIndex, ssid, sizeof(ssid))) {
+        return false;
+    }
+    crc = WiFiCredsBlob::crc32(reinterpret_cast<const uint8_t*>(ssid), strlen(ssid));
+    return true;
+}
+
+void writeRecord(const RtcRecord& record) {
+#if defined(ESP8266)
+    ESP.rtcUserMemoryWrite(WIFICREDS_RTC_BLOCK_OFFSET, reinterpret_cast<uint32_t*>(const_cast<RtcRecord*>(&record)),
+                           sizeof(record));
+#else
+    rtcRecord = record;
+#endif
+}
+
+void readRecord(RtcRecord& record) {
+#if defined(ESP8266)
+    ESP.rtcUserMemoryRead(WIFICREDS_RTC_BLOCK_OFFSET, reinterpret_cast<uint32_t*>(&record), sizeof(record));
+#else
+    record = rtcRecord;
+#endif
+}
+
+} // namespace
+
+bool WiFiCredsFastReconnect::save(size_t credentialIndex, const uint8_t* bssid, uint8_t channel,
+                                  uint32_t localIP, uint32_t gateway, uint32_t subnet, uint32_t dns) {
+    if (bssid == nullptr || channel == 0) {
+        return false;
+    }
+
+    RtcRecord record;
+    memset(&record, 0, sizeof(record));
+    if (!ssidCrc(credentialIndex, record.ssidCrc)) {
+        return false;
+    }
+    record.magic = RECORD_MAGIC;
+    record.state.credentialIndex = static_cast<uint16_t>(credentialIndex);
+    memcpy(record.state.bssid, bssid, sizeof(record.state.bssid));
+    record.state.channel = channel;
+    record.state.localIP = localIP;
+    record.state.gateway = gateway;
+    record.state.subnet = subnet;
+    record.state.dns = dns;
+    record.crc = WiFiCredsBlob::crc32(reinterpret_cast<const uint8_t*>(&record), offsetof(RtcRecord, crc));
+
+    writeRecord(record);
+    return true;
+}
+
+bool WiFiCredsFastReconnect::load(WiFiCredsLinkState& state) {
+    RtcRecord record;
+    readRecord(record);
+
+    // Cold boot leaves random or zeroed memory, both fail here
+    if (record.magic != RECORD_MAGIC ||
+        record.crc != WiFiCredsBlob::crc32(reinterpret_cast<const uint8_t*>(&record), offsetof(RtcRecord, crc))) {
+        return false;
+    }
+
+    uint32_t crc;
+    if (!ssidCrc(record.state.credentialIndex, crc) || record.ssidCrc != crc) {
+        return false;
+    }
+
+    state = record.state;
+    return true;
+}
+
+void WiFiCredsFastReconnect::invalidate() {
+    RtcRecord record;
+    memset(&record, 0, sizeof(record));
+    writeRecord(record);
+}
+
+bool WiFiCredsFastReconnect::begin(WiFiCredsDriver& driver) {
+    WiFiCredsLinkState state;
+    if (!load(state)) {
+        return false;
+    }
+
+    CredentialView creds = WiFiCreds::resolveIndex(state.credentialIndex);
+
+    // Decrypted or converted into the stack buffer, which is wiped once the driver has it
+    char psk[WIFICREDS_PSK_HEX_SIZE];
+    const char* password = WiFiCreds::getConnectKey(creds, psk);
+    if (password == nullptr) {
+        return false;
+    }
+
+    driver.config(state.localIP, state.gateway, state.subnet, state.dns);
+    driver.begin(creds.ssid, password, state.channel, state.bssid);
+    WiFiCredsCipher::wipe(psk, sizeof(psk));
+    return true;
+}
@@ -0,0 +1,132 @@
+/**
+ * @file WiFiCredsFastReconnect.h
+ * @brief Deep-sleep fast-reconnect cache for the WiFiCreds library
+ * @author Rithik Krisna M
+ * @version 1.0.4
+ * @date 2025
+ *
+ * Saves the last successful connection (credential set, BSSID, channel and
+ * IP lease) in memory that survives deep sleep, protected by a CRC. After
+ * waking, a directed, channel-locked connect with a static IP skips the
+ * channel search and DHCP, which is most of the wake-to-connected time.
+ *
+ * Storage by platform:
+ * - ESP32: RTC slow memory (RTC_DATA_ATTR)
+ * - ESP8266: RTC user memory at block WIFICREDS_RTC_BLOCK_OFFSET
+ * - Other platforms and host builds: ordinary RAM (lost on reset)
+ */
+
+#ifndef WIFICREDS_FAST_RECONNECT_H
+#define WIFICREDS_FAST_RECONNECT_H
+
+#include "WiFiCreds.h"
+#include "WiFiCredsDriver.h"
+
+/**
+ * @def WIFICREDS_RTC_BLOCK_OFFSET
+ * @brief First 4-byte block of ESP8266 RTC user memory used for the cache
+ *
+ * The first 32 blocks are left free because OTA updates use them.
+ */
+#ifndef WIFICREDS_RTC_BLOCK_OFFSET
+#define WIFICREDS_RTC_BLOCK_OFFSET 32
+#endif
+
+/**
+ * @struct WiFiCredsLinkState
+ * @brief Everything needed for a directed reconnect
+ *
+ * @note IPv4 addresses are in network byte order, as stored by the Arduino IPAddress class
+ */
+struct WiFiCredsLinkState {
+    uint16_t credentialIndex; ///< Index of the credential set in CREDENTIAL_SETS
+    uint8_t bssid[6];         ///< Access point MAC address
+    uint8_t channel;          ///< Wi-Fi channel
+    uint8_t reserved;         ///< Padding, always 0
+    uint32_t localIP;         ///< Leased device address
+    uint32_t gateway;         ///< Gateway address
+    uint32_t subnet;          ///< Subnet mask
+    uint32_t dns;             ///< DNS server address
+};
+
+/**
+ * @class WiFiCredsFastReconnect
+ * @brief Saves and restores the last connection across deep sleep
+ *
+ * @code
+ * // After a normal connect succeeded:
+ * WiFiCredsFastReconnect::save(creds.index, WiFi.BSSID(), WiFi.channel(),
+ *                              WiFi.localIP(), WiFi.gatewayIP(), WiFi.subnetMask(), WiFi.dnsIP());
+ *
+ * // After waking up:
+ * WiFiCredsLinkState state;
+ * if (WiFiCredsFastReconnect::load(state)) {
+ *     CredentialView creds = WiFiCreds::resolveIndex(state.credentialIndex);
+ *     char psk[WIFICREDS_PSK_HEX_SIZE];
+ *     const char* password = WiFiCreds::getConnectKey(creds, psk); // unsealed or PMK as hex
+ *     if (password != nullptr) {
+ *         WiFi.config(state.localIP, state.gateway, state.subnet, state.dns);
+ *         WiFi.begin(creds.ssid, password, state.channel, state.bssid);
+ *     }
+ *     WiFiCredsCipher::wipe(psk, sizeof(psk));
+ * }
+ * @endcode
+ */
+class WiFiCredsFastReconnect {
+public:
+    /**
+     * @brief Remember a successful connection
+     *
+     * @param credentialIndex Index of the credential set that connected
+     * @param bssid MAC address of the access point
+     * @param channel Wi-Fi channel of the access point
+     * @param localIP Leased device address
+     * @param gateway Gateway address
+     * @param subnet Subnet mask
+     * @param dns DNS server address
+     * @return true if saved, false if the index or channel is invalid
+     */
+    static bool save(size_t credentialIndex, const uint8_t* bssid, uint8_t channel,
+                     uint32_t localIP, uint32_t gateway, uint32_t subnet, uint32_t dns);
+
+    /**
+     * @brief Read the remembered connection
+     *
+     * The state is rejected if the CRC does not match, or if the credential
+     * set at the saved index no longer has the same SSID (e.g. after
+     * credentials.h changed and the device was reflashed).
+     *
+     * @param state Receives the saved state
+     * @return true if a valid state was found, false otherwise
+     */
+    static bool load(WiFiCredsLinkState& state);
+
+    /**
+     * @brief Forget the remembered connection
+     * @note Call this when a directed reconnect fails, so the next wake uses the normal path
+     */
+    static void invalidate();
+
+    /**
+     * @brief Start a directed reconnect through a driver
+     *
+     * Applies the saved static IP configuration and starts a channel- and
+     * BSSID-locked connect. The caller polls driver.status(); if it does not
+     * reach WiFiCredsLinkStatus::Connected quickly, call invalidate(), switch
+     * the driver back to DHCP with config(0, 0, 0, 0) and use the normal path.
+     *
+     * @param driver Driver to connect with
+     * @return true if a reconnect was started, false if no valid state is saved or a sealed
+     *         password cannot be decrypted (no key set)
+     * @note Uses the precomputed PMK when credentials.h provides one, never derives it
+     */
+    static bool begin(WiFiCredsDriver& driver);
+
+private:
+    // Prevent instantiation of this class
+    WiFiCredsFastReconnect() = delete;
+    WiFiCredsFastReconnect(const WiFiCredsFastReconnect&) = delete;
+    WiFiCredsFastReconnect& operator=(const WiFiCredsFastReconnect&) = delete;
+};
+
+#endif // WIFICREDS_FAST_RECONNECT_H
@@ -0,0 +1,79 @@
+/**
+ * @file WiFiCredsFileStorage.cpp
+ * @brief Implementation of the file-backed storage
+ * @author Rithik Krisna M
+ * @version 1.0.4
+ * @date 2025
+ */
+
+#include "WiFiCredsFileStorage.h"
+
+#if !defined(ARDUINO) || defined(ESP32)
+
+#include <fcntl.h>
+#include <string.h>     // Required for memset
+#include <sys/stat.h>
+#include <unistd.h>     // Required for pread, pwrite and fsync
+
+WiFiCredsFileStorage::WiFiCredsFileStorage(const char* path, size_t size)
+    : _path(path), _size(size), _fd(-1) {}
+
+WiFiCredsFileStorage::~WiFiCredsFileStorage() {
+    if (_fd >= 0) {
+        close(_fd);
+    }
+}
+
+bool WiFiCredsFileStorage::begin() {
+    if (_fd >= 0) {
+        return true;
+    }
+
+    const int fd = ::open(_path, O_RDWR | O_CREAT, 0600);
+    if (fd < 0) {
+        return false;
+    }
+
+    // Pad a new or short file with erased bytes
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        close(fd);
+        return false;
+    }
+    uint8_t erased[64];
+    memset(erased, 0xFF, sizeof(erased));
+    for (size_t position = static_cast<size_t>(info.st_size); position < _size; position += sizeof(erased)) {
+        const size_t length = (_size - position < sizeof(erased)) ? _size - position : sizeof(erased);
+        if (pwrite(fd, erased, length, static_cast<off_t>(position)) != static_cast<ssize_t>(length)) {
+            close(fd);
+            return false;
+        }
+    }
+
+    _fd = fd;
+    return true;
+}
+
+size_t WiFiCredsFileStorage::size() {
+    return (_fd >= 0) ? _size : 0;
+}
+
+bool WiFiCredsFileStorage::read(size_t offset, void* data, size_t length) {
+    if (_fd < 0 || offset > _size || length > _size - offset) {
+        return false;
+    }
+    return pread(_fd, data, length, static_cast<off_t>(offset)) == static_cast<ssize_t>(length);
+}
+
+bool WiFiCredsFileStorage::write(size_t offset, const void* data, size_t length) {
+    if (_fd < 0 || offset > _size || length > _size - offset) {
+        return false;
+    }
+    return pwrite(_fd, data, length, static_cast<off_t>(offset)) == static_cast<ssize_t>(length);
+}
+
+bool WiFiCredsFileStorage::commit() {
+    return _fd >= 0 && fsync(_fd) == 0;
+}
+
+#endif // !ARDUINO || ESP32
\ No newline at end of file
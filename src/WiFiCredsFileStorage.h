@@ -0,0 +1,66 @@
+/**
+ * @file WiFiCredsFileStorage.h
+ * @brief WiFiCredsStorage implementation backed by a file
+ * @author Rithik Krisna M
+ * @version 1.0.4
+ * @date 2025
+ *
+ * Keeps the WiFiCredsStore region in a file of fixed size, accessed with
+ * POSIX pread() and pwrite(). Positioned reads share no file offset, so
+ * several tasks can read while another one writes. On a host machine this emulates the EEPROM of a board, so the
+ * store can be developed and tested on Linux. On ESP32 any file system
+ * mounted into the VFS works, for example LittleFS under "/littlefs".
+ *
+ * @note Available in host builds and on ESP32
+ */
+
+#ifndef WIFICREDS_FILE_STORAGE_H
+#define WIFICREDS_FILE_STORAGE_H
+
+#include "WiFiCredsStorage.h"
+
+#if !defined(ARDUINO) || defined(ESP32)
+
+/**
+ * @class WiFiCredsFileStorage
+ * @brief Storage region kept in a file
+ *
+ * begin() opens the file once; a missing file is created, and a short file
+ * is extended, with 0xFF bytes like erased EEPROM. Every other method fails
+ * until begin() has succeeded. WiFiCredsStore::begin() calls it.
+ *
+ * @code
+ * LittleFS.begin(true); // mounts at /littlefs
+ * WiFiCredsFileStorage storage("/littlefs/wificreds.log", 4096);
+ * WiFiCredsStore store(storage);
+ * @endcode
+ */
+class WiFiCredsFileStorage : public WiFiCredsStorage {
+public:
+    /**
+     * @brief Use a file as storage
+     * @param path Path of the file; the string must stay valid
+     * @param size Size of the region in bytes
+     */
+    WiFiCredsFileStorage(const char* path, size_t size);
+    ~WiFiCredsFileStorage() override;
+
+    bool begin() override;
+    size_t size() override;
+    bool read(size_t offset, void* data, size_t length) override;
+    bool write(size_t offset, const void* data, size_t length) override;
+    bool commit() override;
+
+private:
+    const char* _path;
+    size_t _size;
+    int _fd;
+
+    // Owns a file handle
+    WiFiCredsFileStorage(const WiFiCredsFileStorage&) = delete;
+    WiFiCredsFileStorage& operator=(const WiFiCredsFileStorage&) = delete;
+};
+
+#endif // !ARDUINO || ESP32
+
+#endif // WIFICREDS_FILE_STORAGE_H
@@ -0,0 +1,126 @@
+/**
+ * @file WiFiCredsFormat.cpp
+ * @brief Implementation of heap-free status and scan result formatting
+ * @author Rithik Krisna M
+ * @version 1.0.4
+ * @date 2025
+ */
+
+#include "WiFiCredsFormat.h"
+
+namespace {
+
+/**
+ * @brief Appends text to a fixed buffer and remembers whether everything fit
+ *
+ * Hand-written instead of snprintf(), whose implementation in some cores
+ * allocates internally.
+ */
+class Writer {
+public:
+    Writer(char* buffer, size_t size) : _buffer(buffer), _size(size), _length(0), _ok(buffer != nullptr && size > 0) {}
+
+    void put(char c) {
+        if (_ok && _length + 1 < _size) {
+            _buffer[_length++] = c;
+        } else {
+            _ok = false;
+        }
+    }
+
+    void put(const char* text) {
+        while (*text != '\0') {
+            put(*text++);
+        }
+    }
+
+    void putNumber(int value) {
+        char digits[10];
+        size_t count = 0;
+        // Negated as unsigned, which is defined for INT_MIN as well
+        unsigned magnitude = (value < 0) ? 0U - static_cast<unsigned>(value) : static_cast<unsigned>(value);
+        if (value < 0) {
+            put('-');
+        }
+        do {
+            digits[count++] = static_cast<char>('0' + magnitude % 10);
+            magnitude /= 10;
+        } while (magnitude > 0);
+        while (count > 0) {
+            put(digits[--count]);
+        }
+    }
+
+    void putHex(uint8_t value) {
+        static const char HEX_DIGITS[] = "0123456789ABCDEF";
+        put(HEX_DIGITS[value >> 4]);
+        put(HEX_DIGITS[value & 0x0F]);
+    }
+
+    /// Terminate the text; on overflow the buffer is left holding an empty string
+    bool finish() {
+        if (_buffer != nullptr && _size > 0) {
+            _buffer[_ok ? _length : 0] = '\0';
+        }
+        return _ok;
+    }
+
+private:
+    char* _buffer;
+    size_t _size;
+    size_t _length;
+    bool _ok;
+};
+
+} // namespace
+
+const char* WiFiCredsFormat::linkStatus(WiFiCredsLinkStatus status) {
+    switch (status) {
+        case WiFiCredsLinkStatus::Idle:
+            return "Idle";
+        case WiFiCredsLinkStatus::Connecting:
+            return "Connecting";
+        case WiFiCredsLinkStatus::Connected:
+            return "Connected";
+        case WiFiCredsLinkStatus::NoSsid:
+            return "SSID Not Available";
+        case WiFiCredsLinkStatus::ConnectFailed:
+            return "Connection Failed";
+        case WiFiCredsLinkStatus::Disconnected:
+            return "Disconnected";
+    }
+    return "Unknown";
+}
+
+bool WiFiCredsFormat::bssid(const uint8_t bssid[6], char* buffer, size_t size) {
+    Writer out(buffer, size);
+    
+    if (bssid == nullptr) {
+        out.finish();
+        return false;
+    }
+    
+    for (size_t i = 0; i < 6; i++) {
+        if (i > 0) {
+            out.put(':');
+        }
+        out.putHex(bssid[i]);
+    }
+    
+    return out.finish();
+}
+
+bool WiFiCredsFormat::scanEntry(const WiFiCredsScanEntry& entry, char* buffer, size_t size) {
+    Writer out(buffer, size);
+    
+    out.put((entry.ssid[0] != '\0') ? entry.ssid : "<hidden>");
+    out.put(" (");
+    out.putNumber(entry.rssi);
+    out.put(" dBm) ch ");
+    out.putNumber(entry.channel);
+    if (!entry.open) {
+        out.put(" *");
+    }
+    
+    return out.finish();
+}
\ No newline at end of file
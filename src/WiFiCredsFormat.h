@@ -0,0 +1,80 @@
+/**
+ * @file WiFiCredsFormat.h
+ * @brief Status and scan result formatting into caller-provided buffers
+ * @author Rithik Krisna M
+ * @version 1.0.4
+ * @date 2025
+ *
+ * Printing a scan with WiFi.SSID(i) or returning a String from a status
+ * helper allocates on every call. On the ESP8266, a sketch that does this
+ * on every periodic scan fragments the heap within hours. These helpers
+ * return string constants or write into fixed buffers the caller owns, so
+ * formatting never touches the heap.
+ */
+
+#ifndef WIFICREDS_FORMAT_H
+#define WIFICREDS_FORMAT_H
+
+#include "WiFiCreds.h"
+#include "WiFiCredsDriver.h"
+
+/// Buffer size for WiFiCredsFormat::bssid(): "AA:BB:CC:DD:EE:FF" and the terminator
+#define WIFICREDS_BSSID_STRING_SIZE 18
+
+/// Buffer size for WiFiCredsFormat::scanEntry(), enough for a 32-character SSID
+#define WIFICREDS_SCAN_ENTRY_STRING_SIZE 56
+
+/**
+ * @class WiFiCredsFormat
+ * @brief Heap-free text for link status and scan results
+ *
+ * @code
+ * char line[WIFICREDS_SCAN_ENTRY_STRING_SIZE];
+ * WiFiCredsScanEntry entry;
+ * for (int i = 0; i < n; i++) {
+ *     if (driver.scanResult(i, entry) && WiFiCredsFormat::scanEntry(entry, line, sizeof(line))) {
+ *         Serial.println(line); // MyHomeWiFi (-61 dBm) ch 6 *
+ *     }
+ * }
+ * Serial.println(WiFiCredsFormat::linkStatus(driver.status()));
+ * @endcode
+ */
+class WiFiCredsFormat {
+public:
+    /**
+     * @brief Name of a link status
+     * @param status Status reported by a WiFiCredsDriver
+     * @return const char* Constant string such as "Connected"; never nullptr
+     */
+    static const char* linkStatus(WiFiCredsLinkStatus status);
+
+    /**
+     * @brief Format a BSSID as colon-separated upper-case hex
+     *
+     * @param bssid 6-byte MAC address
+     * @param buffer Receives the text, at least WIFICREDS_BSSID_STRING_SIZE bytes
+     * @param size Size of @p buffer in bytes
+     * @return true on success, false if @p buffer is too small (it then holds an empty string)
+     */
+    static bool bssid(const uint8_t bssid[6], char* buffer, size_t size);
+
+    /**
+     * @brief Format one scan result as "SSID (RSSI dBm) ch CHANNEL", with " *" for encrypted networks
+     *
+     * Hidden networks, which report an empty SSID, are shown as "<hidden>".
+     *
+     * @param entry Scan result
+     * @param buffer Receives the text, WIFICREDS_SCAN_ENTRY_STRING_SIZE bytes fit any entry
+     * @param size Size of @p buffer in bytes
+     * @return true on success, false if @p buffer is too small (it then holds an empty string)
+     */
+    static bool scanEntry(const WiFiCredsScanEntry& entry, char* buffer, size_t size);
+
+private:
+    // Prevent instantiation of this class
+    WiFiCredsFormat() = delete;
+    WiFiCredsFormat(const WiFiCredsFormat&) = delete;
+    WiFiCredsFormat& operator=(const WiFiCredsFormat&) = delete;
+};
+
+#endif // WIFICREDS_FORMAT_H
@@ -0,0 +1,300 @@
+/**
+ * @file WiFiCredsIndex.h
+ * @brief Compile-time perfect-hash index over credential set names
+ * @author Rithik Krisna M
+ * @version 1.0.4
+ * @date 2025
+ *
+ * Builds a minimal perfect hash (hash-and-displace) over the names in
+ * CREDENTIAL_SETS while the sketch is being compiled, so a name lookup costs
+ * one hash of the name, at most one re-hash and a single strcmp, regardless
+ * of how many credential sets are defined. SSIDs, which may repeat across
+ * sets, get a compile-time open-addressing table instead. Nothing is built
+ * at runtime.
+ *
+ * @note Requires C++14 constexpr; older toolchains fall back to a linear scan
+ * @note Internal header, included by WiFiCreds.cpp after credentials.h, and by the
+ *       runtime tables for hashName()
+ */
+
+#ifndef WIFICREDS_INDEX_H
+#define WIFICREDS_INDEX_H
+
+#include "WiFiCreds.h"
+
+#if __cplusplus >= 201402L
+#define WIFICREDS_HAS_NAME_INDEX 1
+#define WIFICREDS_INDEX_CONSTEXPR constexpr
+#else
+#define WIFICREDS_HAS_NAME_INDEX 0
+#define WIFICREDS_INDEX_CONSTEXPR inline
+#endif
+
+namespace WiFiCredsIndex {
+
+/**
+ * @brief Seeded FNV-1a with a murmur3 finalizer
+ *
+ * The one string hash of the library: the compile-time indexes, the SSID
+ * lookup and the runtime tables of WiFiCredsStore and WiFiCredsChannelMap
+ * all use it, so hashes written to storage stay comparable.
+ *
+ * @param s Null-terminated string to hash
+ * @param seed Hash seed (0 selects the bucket, displacements use 1..MAX_SEED)
+ * @return uint32_t Well-mixed 32-bit hash
+ * @note constexpr from C++14 on, for the compile-time index; a plain inline function before
+ */
+WIFICREDS_INDEX_CONSTEXPR uint32_t hashName(const char* s, uint32_t seed) {
+    uint32_t h = 2166136261UL ^ (seed * 0x9E3779B9UL);
+    for (; *s != '\0'; ++s) {
+        h ^= static_cast<uint8_t>(*s);
+        h *= 16777619UL;
+    }
+    h ^= h >> 16;
+    h *= 0x85EBCA6BUL;
+    h ^= h >> 13;
+    h *= 0xC2B2AE35UL;
+    h ^= h >> 16;
+    return h;
+}
+
+} // namespace WiFiCredsIndex
+
+#if WIFICREDS_HAS_NAME_INDEX
+
+namespace WiFiCredsIndex {
+
+/// Marks an unused slot in NameIndex::slots
+constexpr uint16_t EMPTY_SLOT = 0xFFFF;
+
+/// Upper bound for the displacement seed search of a single bucket
+constexpr uint32_t MAX_SEED = 1UL << 16;
+
+/**
+ * @brief Not constexpr on purpose: reaching it during index construction turns
+ *        a duplicate credential name into a compile error naming the problem
+ */
+inline void duplicateCredentialName() {}
+
+/**
+ * @brief Not constexpr on purpose: reaching it means no displacement seed was found
+ */
+inline void perfectHashSeedSearchFailed() {}
+
+/**
+ * @brief Compile-time string equality
+ */
+constexpr bool namesEqual(const char* a, const char* b) {
+    while (*a != '\0' && *a == *b) {
+        ++a;
+        ++b;
+    }
+    return *a == *b;
+}
+
+/**
+ * @brief Smallest power of two that is >= n (and at least 1)
+ */
+constexpr size_t tableSizeFor(size_t n) {
+    size_t size = 1;
+    while (size < n) {
+        size <<= 1;
+    }
+    return size;
+}
+
+/**
+ * @struct NameIndex
+ * @brief Perfect-hash lookup tables for a credential array
+ *
+ * A name hashes (seed 0) to a bucket. A positive displacement is the seed
+ * that places every name of that bucket in a distinct slot; a negative one
+ * encodes the slot of a single-name bucket directly; zero means the bucket
+ * is empty. Each slot holds the CREDENTIAL_SETS index stored there.
+ *
+ * @tparam M Number of buckets and slots (power of two)
+ */
+template <size_t M>
+struct NameIndex {
+    int32_t displacement[M];  ///< Per-bucket seed, -(slot + 1), or 0 when empty
+    uint16_t slots[M];        ///< Credential index per slot, or EMPTY_SLOT
+
+    /**
+     * @brief Resolve a name to its only possible candidate index
+     *
+     * @param name Null-terminated name to look up (must not be nullptr)
+     * @return size_t Candidate index, or EMPTY_SLOT if the name cannot be present
+     * @note The caller still has to compare the candidate's name
+     * @note constexpr so that an index written by credgen can be checked at compile time
+     */
+    constexpr size_t candidate(const char* name) const {
+        const int32_t d = displacement[hashName(name, 0) & (M - 1)];
+        if (d == 0) {
+            return EMPTY_SLOT;
+        }
+        const size_t slot = (d < 0) ? static_cast<size_t>(-(d + 1))
+                                    : (hashName(name, static_cast<uint32_t>(d)) & (M - 1));
+        return slots[slot];
+    }
+};
+
+/**
+ * @brief Build the perfect-hash index for the first @p count entries of @p sets
+ *
+ * Buckets are placed largest first while the table is still sparse; buckets
+ * holding a single name are then dropped into the remaining free slots.
+ *
+ * @tparam M Table size, see tableSizeFor()
+ * @param sets The credential array
+ * @param count Number of named entries in @p sets
+ * @return NameIndex<M> The finished index
+ */
+template <size_t M, size_t N>
+constexpr NameIndex<M> buildNameIndex(const CredentialSet (&sets)[N], size_t count) {
+    NameIndex<M> index = {};
+    uint32_t bucketOf[N] = {};
+    uint16_t bucketSize[M] = {};
+    uint16_t bucketStart[M + 1] = {};
+    uint16_t members[N] = {};
+    uint16_t filled[M] = {};
+    bool taken[M] = {};
+    size_t slotOf[N] = {};
+    uint16_t largest = 0;
+
+    for (size_t s = 0; s < M; s++) {
+        index.slots[s] = EMPTY_SLOT;
+    }
+
+    // Group names by bucket (counting sort)
+    for (size_t i = 0; i < count; i++) {
+        bucketOf[i] = hashName(sets[i].name, 0) & (M - 1);
+        bucketSize[bucketOf[i]]++;
+        if (bucketSize[bucketOf[i]] > largest) {
+            largest = bucketSize[bucketOf[i]];
+        }
+    }
+    for (size_t b = 0; b < M; b++) {
+        bucketStart[b + 1] = bucketStart[b] + bucketSize[b];
+    }
+    for (size_t i = 0; i < count; i++) {
+        const uint32_t b = bucketOf[i];
+        members[bucketStart[b] + filled[b]] = static_cast<uint16_t>(i);
+        filled[b]++;
+    }
+
+    // Place multi-name buckets, largest first, by searching a displacement seed
+    for (uint16_t size = largest; size >= 2; size--) {
+        for (size_t b = 0; b < M; b++) {
+            if (bucketSize[b] != size) {
+                continue;
+            }
+            const size_t first = bucketStart[b];
+            uint32_t seed = 1;
+            for (;; seed++) {
+                if (seed > MAX_SEED) {
+                    perfectHashSeedSearchFailed();
+                }
+                bool fits = true;
+                for (size_t k = 0; k < size && fits; k++) {
+                    const char* name = sets[members[first + k]].name;
+                    slotOf[k] = hashName(name, seed) & (M - 1);
+                    if (taken[slotOf[k]]) {
+                        fits = false;
+                    }
+                    for (size_t j = 0; j < k && fits; j++) {
+                        if (slotOf[j] == slotOf[k]) {
+                            if (namesEqual(sets[members[first + j]].name, name)) {
+                                duplicateCredentialName();
+                            }
+                            fits = false;
+                        }
+                    }
+                }
+                if (fits) {
+                    break;
+                }
+            }
+            for (size_t k = 0; k < size; k++) {
+                taken[slotOf[k]] = true;
+                index.slots[slotOf[k]] = members[first + k];
+            }
+            index.displacement[b] = static_cast<int32_t>(seed);
+        }
+    }
+
+    // Single-name buckets take the free slots in order
+    size_t nextFree = 0;
+    for (size_t b = 0; b < M; b++) {
+        if (bucketSize[b] != 1) {
+            continue;
+        }
+        while (taken[nextFree]) {
+            nextFree++;
+        }
+        taken[nextFree] = true;
+        index.slots[nextFree] = members[bucketStart[b]];
+        index.displacement[b] = -static_cast<int32_t>(nextFree + 1);
+    }
+
+    return index;
+}
+
+/**
+ * @brief 16-bit tag stored next to each SSID slot to skip most string compares
+ */
+constexpr uint16_t hashTag(uint32_t hash) {
+    return static_cast<uint16_t>(hash >> 16);
+}
+
+/**
+ * @struct SsidIndex
+ * @brief Open-addressing (linear probing) table over credential SSIDs
+ *
+ * Every set with a non-empty SSID occupies one slot, so sets sharing an SSID
+ * are all found by probing from the SSID's home slot until an empty slot.
+ *
+ * @tparam M Number of slots (power of two, at least twice the entry count)
+ */
+template <size_t M>
+struct SsidIndex {
+    uint16_t slots[M]; ///< Credential index per slot, or EMPTY_SLOT
+    uint16_t tags[M];  ///< hashTag() of the SSID stored in the slot
+};
+
+/**
+ * @brief Build the SSID table for the first @p count entries of @p sets
+ *
+ * @tparam M Table size, see tableSizeFor() (use twice the entry count)
+ * @param sets The credential array
+ * @param count Number of named entries in @p sets
+ * @return SsidIndex<M> The finished table
+ */
+template <size_t M, size_t N>
+constexpr SsidIndex<M> buildSsidIndex(const CredentialSet (&sets)[N], size_t count) {
+    SsidIndex<M> index = {};
+
+    for (size_t s = 0; s < M; s++) {
+        index.slots[s] = EMPTY_SLOT;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        if (sets[i].ssidLength == 0) {
+            continue;
+        }
+        const uint32_t hash = hashName(sets[i].ssid, 0);
+        size_t slot = hash & (M - 1);
+        while (index.slots[slot] != EMPTY_SLOT) {
+            slot = (slot + 1) & (M - 1);
+        }
+        index.slots[slot] = static_cast<uint16_t>(i);
+        index.tags[slot] = hashTag(hash);
+    }
+
+    return index;
+}
+
+} // namespace WiFiCredsIndex
+
+#endif // WIFICREDS_HAS_NAME_INDEX
+
+#endif // WIFICREDS_INDEX_H
@@ -0,0 +1,119 @@
+/**
+ * @file WiFiCredsMappedBlob.cpp
+ * @brief Implementation of memory-mapped credential blob files
+ * @author Rithik Krisna M
+ * @version 1.0.4
+ * @date 2025
+ */
+
+#include "WiFiCredsMappedBlob.h"
+
+#if WIFICREDS_HAS_MMAP
+
+#include <fcntl.h>
+#include <stdio.h>      // Required for rename and snprintf
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+WiFiCredsMapping::~WiFiCredsMapping() {
+    if (_data != nullptr) {
+        munmap(_data, _size);
+    }
+}
+
+WiFiCredsMappedBlob::WiFiCredsMappedBlob(const std::string& path) : _path(path) {}
+
+bool WiFiCredsMappedBlob::open(bool verify) {
+    Snapshot mapping = map(verify);
+    if (!mapping) {
+        return false;
+    }
+    std::atomic_store(&_current, mapping);
+    return true;
+}
+
+bool WiFiCredsMappedBlob::reload(bool verify) {
+    struct stat info;
+    if (stat(_path.c_str(), &info) != 0) {
+        return false;
+    }
+
+    // rename() gives the new file a new inode; the same inode means no update
+    Snapshot current = snapshot();
+    if (current && current->_device == info.st_dev && current->_inode == info.st_ino) {
+        return false;
+    }
+
+    return open(verify);
+}
+
+WiFiCredsMappedBlob::Snapshot WiFiCredsMappedBlob::snapshot() const {
+    return std::atomic_load(&_current);
+}
+
+bool WiFiCredsMappedBlob::publish(const std::string& path, const uint8_t* data, size_t size) {
+    char suffix[32];
+    snprintf(suffix, sizeof(suffix), ".tmp.%ld", static_cast<long>(getpid()));
+    const std::string temporary = path + suffix;
+
+    const int fd = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600);
+    if (fd < 0) {
+        return false;
+    }
+
+    size_t written = 0;
+    while (written < size) {
+        const ssize_t result = write(fd, data + written, size - written);
+        if (result <= 0) {
+            break;
+        }
+        written += static_cast<size_t>(result);
+    }
+
+    // The data must be on disk before the rename makes it visible
+    const bool complete = written == size && fsync(fd) == 0;
+    if (close(fd) != 0 || !complete || rename(temporary.c_str(), path.c_str()) != 0) {
+        unlink(temporary.c_str());
+        return false;
+    }
+    return true;
+}
+
+// ===== PRIVATE HELPER METHODS =====
+
+WiFiCredsMappedBlob::Snapshot WiFiCredsMappedBlob::map(bool verify) const {
+    const int fd = ::open(_path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return Snapshot();
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < WIFICREDS_BLOB_HEADER_SIZE) {
+        close(fd);
+        return Snapshot();
+    }
+
+    std::shared_ptr<WiFiCredsMapping> mapping(new WiFiCredsMapping());
+    mapping->_size = static_cast<size_t>(info.st_size);
+    mapping->_device = info.st_dev;
+    mapping->_inode = info.st_ino;
+
+    // The mapping stays valid after close(), and after the file is renamed over or deleted
+    void* data = mmap(nullptr, mapping->_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        return Snapshot();
+    }
+    mapping->_data = data;
+
+    // Lookups are binary searches, so read-ahead would mostly fetch unused pages
+    madvise(data, mapping->_size, MADV_RANDOM);
+
+    if (!mapping->_blob.begin(static_cast<const uint8_t*>(data), mapping->_size, verify)) {
+        return Snapshot();
+    }
+    return mapping;
+}
+
+#endif // WIFICREDS_HAS_MMAP
\ No newline at end of file
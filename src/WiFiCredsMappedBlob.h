@@ -0,0 +1,155 @@
+/**
+ * @file WiFiCredsMappedBlob.h
+ * @brief Memory-mapped credential blob files with hot swap, for Linux hosts
+ * @author Rithik Krisna M
+ * @version 1.0.4
+ * @date 2025
+ *
+ * Gateways that pick credentials for many downstream devices keep their
+ * credential database as a blob file (credgen --format blob) and map it
+ * read-only. Opening costs one mmap() and a header check, whatever the
+ * file size; pages are only read from disk when a lookup touches them.
+ * Lookups go through WiFiCredsBlob, so getSSID(), getPassword() and
+ * resolve() return pointers straight into the mapping.
+ *
+ * Updates replace the file with rename(), which is atomic: a new file is
+ * written next to the old one and renamed over it (publish() does this).
+ * reload() notices the new file, maps and verifies it, then swaps it in.
+ * Readers work on snapshots. A snapshot keeps its mapping alive, so a reader
+ * that is in the middle of a lookup is never affected by a swap, and the
+ * old mapping is released when its last snapshot goes away.
+ *
+ * @note Available in host builds on Linux and other POSIX systems; not compiled on boards
+ */
+
+#ifndef WIFICREDS_MAPPED_BLOB_H
+#define WIFICREDS_MAPPED_BLOB_H
+
+#include "WiFiCredsBlob.h"
+
+#if !defined(ARDUINO) && (defined(__unix__) || defined(__APPLE__))
+#define WIFICREDS_HAS_MMAP 1
+#else
+#define WIFICREDS_HAS_MMAP 0
+#endif
+
+#if WIFICREDS_HAS_MMAP
+
+#include <memory>
+#include <string>
+#include <sys/types.h>
+
+/**
+ * @class WiFiCredsMapping
+ * @brief One mapped blob file; unmapped when destroyed
+ */
+class WiFiCredsMapping {
+public:
+    ~WiFiCredsMapping();
+
+    /// Reader for the mapped blob
+    const WiFiCredsBlob& blob() const { return _blob; }
+
+    /// Size of the mapped file in bytes
+    size_t size() const { return _size; }
+
+private:
+    friend class WiFiCredsMappedBlob;
+
+    WiFiCredsMapping() : _data(nullptr), _size(0), _device(0), _inode(0) {}
+    WiFiCredsMapping(const WiFiCredsMapping&) = delete;
+    WiFiCredsMapping& operator=(const WiFiCredsMapping&) = delete;
+
+    void* _data;
+    size_t _size;
+    dev_t _device;             ///< Identifies the file, to detect a replacement
+    ino_t _inode;
+    WiFiCredsBlob _blob;
+};
+
+/**
+ * @class WiFiCredsMappedBlob
+ * @brief A blob file mapped read-only, swapped atomically on update
+ *
+ * @code
+ * WiFiCredsMappedBlob db("/var/lib/gateway/credentials.bin");
+ * if (!db.open()) {
+ *     // missing or malformed file
+ * }
+ *
+ * // Reader threads
+ * WiFiCredsMappedBlob::Snapshot snapshot = db.snapshot();
+ * const char* ssid = snapshot->blob().getSSID("site-0042");
+ *
+ * // Updater thread, for example after credgen wrote a new file
+ * db.reload();
+ * @endcode
+ */
+class WiFiCredsMappedBlob {
+public:
+    /// Keeps one mapping alive; pointers from its blob stay valid while any copy exists
+    typedef std::shared_ptr<const WiFiCredsMapping> Snapshot;
+
+    /**
+     * @brief Create a database for a blob file
+     * @param path Path of the blob file
+     */
+    explicit WiFiCredsMappedBlob(const std::string& path);
+
+    /**
+     * @brief Map the file
+     *
+     * @param verify false (default) to check only the blob header, so opening
+     *               takes the same time for any file size; true to also check
+     *               the CRC and every record. Without it a record whose offset
+     *               points outside the file resolves to CredentialResolution::None
+     * @return true if the file was mapped, false if it is missing or malformed
+     */
+    bool open(bool verify = false);
+
+    /**
+     * @brief Swap in the file if it was replaced since the last open() or reload()
+     *
+     * The new file is mapped and checked before the swap; a malformed file is
+     * not swapped in and the current mapping stays. Readers are never waited for.
+     *
+     * @param verify true (default) to check the CRC and every record of the new file
+     * @return true if a new mapping was swapped in, false if the file is unchanged or unusable
+     */
+    bool reload(bool verify = true);
+
+    /**
+     * @brief Current mapping
+     * @return Snapshot The mapping, or an empty pointer before a successful open()
+     * @note Safe to call from any thread, concurrently with reload()
+     */
+    Snapshot snapshot() const;
+
+    /**
+     * @brief Replace a blob file atomically
+     *
+     * Writes @p data to a temporary file in the same directory, flushes it
+     * to disk and renames it over @p path. Readers see either the old or the
+     * new file, never a partial one.
+     *
+     * @param path Path of the blob file
+     * @param data Blob bytes
+     * @param size Number of bytes
+     * @return true on success, false otherwise
+     */
+    static bool publish(const std::string& path, const uint8_t* data, size_t size);
+
+private:
+    std::string _path;
+    Snapshot _current;         ///< Accessed only with std::atomic_load/atomic_store
+
+    /**
+     * @brief Map the file at _path
+     * @return Snapshot The new mapping, or an empty pointer on failure
+     */
+    Snapshot map(bool verify) const;
+};
+
+#endif // WIFICREDS_HAS_MMAP
+
+#endif // WIFICREDS_MAPPED_BLOB_H
@@ -0,0 +1,72 @@
+/**
+ * @file WiFiCredsMultiConnect.cpp
+ * @brief Implementation of the multi-network connect strategy
+ * @author Rithik Krisna M
+ * @version 1.0.4
+ * @date 2025
+ */
+
+#include "WiFiCredsMultiConnect.h"
+
+WiFiCredsMultiConnect::WiFiCredsMultiConnect(WiFiCredsDriver& driver)
+    : _driver(driver), _connection(driver), _handler(nullptr), _context(nullptr),
+      _candidateCount(0), _next(0), _attemptFailed(false), _exhausted(false) {
+    _connection.onEvent(handleEvent, this);
+}
+
+void WiFiCredsMultiConnect::onEvent(WiFiCredsEventHandler handler, void* context) {
+    _handler = handler;
+    _context = context;
+}
+
+size_t WiFiCredsMultiConnect::start() {
+    _connection.disconnect();
+
+    // One scan replaces a band search per credential set
+    _candidateCount = WiFiCredsScan::rank(_driver, _driver.scanNetworks(),
+                                          _candidates, WIFICREDS_MULTI_MAX_CANDIDATES);
+    _next = 0;
+    _attemptFailed = false;
+    _exhausted = false;
+
+    tryNext();
+    return _candidateCount;
+}
+
+WiFiCredsConnectionState WiFiCredsMultiConnect::poll() {
+    WiFiCredsConnectionState state = _connection.poll();
+
+    // Started here rather than in the event hook, so handlers never re-enter the connection
+    if (_attemptFailed) {
+        _attemptFailed = false;
+        tryNext();
+        state = _connection.state();
+    }
+
+    return state;
+}
+
+// ===== PRIVATE HELPER METHODS =====
+
+void WiFiCredsMultiConnect::tryNext() {
+    while (_next < _candidateCount) {
+        const WiFiCredsCandidate& next = _candidates[_next++];
+        if (_connection.connectIndex(next.credentialIndex, WIFICREDS_TIMEOUT_LEARNED,
+                                     next.channel, next.bssid)) {
+            return;
+        }
+    }
+    _exhausted = true;
+}
+
+void WiFiCredsMultiConnect::handleEvent(WiFiCredsEvent event, const CredentialView& creds, void* context) {
+    WiFiCredsMultiConnect* self = static_cast<WiFiCredsMultiConnect*>(context);
+
+    if (event == WiFiCredsEvent::Failed || event == WiFiCredsEvent::Timeout) {
+        self->_attemptFailed = true;
+    }
+
+    if (self->_handler != nullptr) {
+        self->_handler(event, creds, self->_context);
+    }
+}
\ No newline at end of file
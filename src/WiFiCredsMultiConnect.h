@@ -0,0 +1,132 @@
+/**
+ * @file WiFiCredsMultiConnect.h
+ * @brief Multi-network connect strategy for the WiFiCreds library
+ * @author Rithik Krisna M
+ * @version 1.0.4
+ * @date 2025
+ *
+ * Trying every credential set in turn with a fixed timeout makes the worst
+ * case N full timeouts, most of it spent waiting for networks that are not
+ * even in range. WiFiCredsMultiConnect instead runs one scan, keeps only
+ * networks some credential set knows (WiFiCredsScan), and tries them
+ * strongest first. Each attempt is locked to the scanned channel and BSSID,
+ * so no attempt searches the band, and is time-boxed with the timeout
+ * WiFiCredsStats learned for the credential set.
+ *
+ * @note A station radio associates with one access point at a time, so
+ *       candidates are tried one after another, but only reachable ones are tried
+ */
+
+#ifndef WIFICREDS_MULTI_CONNECT_H
+#define WIFICREDS_MULTI_CONNECT_H
+
+#include "WiFiCreds.h"
+#include "WiFiCredsConnection.h"
+#include "WiFiCredsScan.h"
+
+/**
+ * @def WIFICREDS_MULTI_MAX_CANDIDATES
+ * @brief Maximum number of scanned networks kept as candidates
+ */
+#ifndef WIFICREDS_MULTI_MAX_CANDIDATES
+#define WIFICREDS_MULTI_MAX_CANDIDATES 8
+#endif
+
+/**
+ * @class WiFiCredsMultiConnect
+ * @brief Scan once, then try the known networks in range strongest first
+ *
+ * Events of the individual attempts are forwarded to the handler set with
+ * onEvent(). When every candidate has failed, poll() returns Idle and
+ * exhausted() becomes true.
+ *
+ * @code
+ * WiFiCredsArduinoDriver driver;
+ * WiFiCredsMultiConnect multi(driver);
+ *
+ * void setup() {
+ *     multi.start();
+ * }
+ *
+ * void loop() {
+ *     multi.poll();
+ *     if (multi.exhausted()) {
+ *         multi.start(); // rescan and try again
+ *     }
+ * }
+ * @endcode
+ */
+class WiFiCredsMultiConnect {
+public:
+    /**
+     * @brief Create a multi-network connect strategy
+     * @param driver Driver used for the scan and all attempts
+     */
+    explicit WiFiCredsMultiConnect(WiFiCredsDriver& driver);
+
+    /**
+     * @brief Set the event handler for the individual attempts
+     * @param handler Function called for every event, or nullptr for none
+     * @param context Passed through to @p handler
+     */
+    void onEvent(WiFiCredsEventHandler handler, void* context = nullptr);
+
+    /**
+     * @brief Scan, rank the known networks and start the first attempt
+     *
+     * @return size_t Number of candidates found (0 means nothing known is in range)
+     * @note driver.scanNetworks() blocks for the duration of the scan
+     */
+    size_t start();
+
+    /**
+     * @brief Advance the current attempt, moving on to the next candidate when it fails
+     * @return WiFiCredsConnectionState State of the underlying connection
+     */
+    WiFiCredsConnectionState poll();
+
+    /// true once every candidate of the last start() has failed
+    bool exhausted() const { return _exhausted; }
+
+    /// true if the link is up, as of the last poll()
+    bool isConnected() const { return _connection.isConnected(); }
+
+    /// Number of candidates found by the last start()
+    size_t candidateCount() const { return _candidateCount; }
+
+    /**
+     * @brief Access a candidate of the last start()
+     * @param index Rank, 0 is the strongest
+     * @return const WiFiCredsCandidate* The candidate, or nullptr if index is invalid
+     */
+    const WiFiCredsCandidate* candidate(size_t index) const {
+        return (index < _candidateCount) ? &_candidates[index] : nullptr;
+    }
+
+    /// The connection used for the attempts
+    WiFiCredsConnection& connection() { return _connection; }
+
+private:
+    WiFiCredsDriver& _driver;
+    WiFiCredsConnection _connection;
+    WiFiCredsEventHandler _handler;
+    void* _context;
+
+    WiFiCredsCandidate _candidates[WIFICREDS_MULTI_MAX_CANDIDATES];
+    size_t _candidateCount;
+    size_t _next;              ///< Next candidate to try
+    bool _attemptFailed;       ///< Set by the event hook, handled in poll()
+    bool _exhausted;
+
+    /**
+     * @brief Start attempts until one is accepted by the connection or candidates run out
+     */
+    void tryNext();
+
+    /**
+     * @brief Event hook installed on the connection; forwards events
+     */
+    static void handleEvent(WiFiCredsEvent event, const CredentialView& creds, void* context);
+};
+
+#endif // WIFICREDS_MULTI_CONNECT_H
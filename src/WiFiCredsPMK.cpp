@@ -0,0 +1,205 @@
+/**
+ * @file WiFiCredsPMK.cpp
+ * @brief Implementation of WPA2 PMK derivation for the WiFiCreds library
+ * @author Rithik Krisna M
+ * @version 1.0.4
+ * @date 2025
+ */
+
+#include "WiFiCredsPMK.h"
+#include <string.h>     // Required for memcpy and memset
+
+namespace {
+
+const size_t SHA1_BLOCK_SIZE = 64;
+const size_t SHA1_DIGEST_SIZE = 20;
+const uint32_t PBKDF2_ITERATIONS = 4096;
+
+inline uint32_t rotl(uint32_t value, unsigned bits) {
+    return (value << bits) | (value >> (32 - bits));
+}
+
+/**
+ * @brief SHA-1 compression of one 64-byte block into @p state
+ */
+void sha1Compress(uint32_t state[5], const uint8_t block[SHA1_BLOCK_SIZE]) {
+    uint32_t w[16];
+    for (size_t i = 0; i < 16; i++) {
+        w[i] = (static_cast<uint32_t>(block[i * 4]) << 24) | (static_cast<uint32_t>(block[i * 4 + 1]) << 16) |
+               (static_cast<uint32_t>(block[i * 4 + 2]) << 8) | static_cast<uint32_t>(block[i * 4 + 3]);
+    }
+
+    uint32_t a = state[0], b = state[1], c = state[2], d = state[3], e = state[4];
+    for (size_t i = 0; i < 80; i++) {
+        // Message schedule kept in a 16-word ring to save stack on small MCUs
+        if (i >= 16) {
+            w[i & 15] = rotl(w[(i + 13) & 15] ^ w[(i + 8) & 15] ^ w[(i + 2) & 15] ^ w[i & 15], 1);
+        }
+        uint32_t f, k;
+        if (i < 20) {
+            f = (b & c) | (~b & d);
+            k = 0x5A827999UL;
+        } else if (i < 40) {
+            f = b ^ c ^ d;
+            k = 0x6ED9EBA1UL;
+        } else if (i < 60) {
+            f = (b & c) | (b & d) | (c & d);
+            k = 0x8F1BBCDCUL;
+        } else {
+            f = b ^ c ^ d;
+            k = 0xCA62C1D6UL;
+        }
+        uint32_t t = rotl(a, 5) + f + e + k + w[i & 15];
+        e = d;
+        d = c;
+        c = rotl(b, 30);
+        b = a;
+        a = t;
+    }
+
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+}
+
+void sha1Init(uint32_t state[5]) {
+    state[0] = 0x67452301UL;
+    state[1] = 0xEFCDAB89UL;
+    state[2] = 0x98BADCFEUL;
+    state[3] = 0x10325476UL;
+    state[4] = 0xC3D2E1F0UL;
+}
+
+void storeDigest(const uint32_t state[5], uint8_t digest[SHA1_DIGEST_SIZE]) {
+    for (size_t i = 0; i < 5; i++) {
+        digest[i * 4] = static_cast<uint8_t>(state[i] >> 24);
+        digest[i * 4 + 1] = static_cast<uint8_t>(state[i] >> 16);
+        digest[i * 4 + 2] = static_cast<uint8_t>(state[i] >> 8);
+        digest[i * 4 + 3] = static_cast<uint8_t>(state[i]);
+    }
+}
+
+/**
+ * @brief Finish a hash whose key block is already absorbed
+ *
+ * Hashes @p length bytes of @p data (at most 55 + 64 bytes) on top of
+ * @p prefixState, which has consumed exactly one 64-byte block.
+ */
+void sha1FinishAfterBlock(const uint32_t prefixState[5], const uint8_t* data, size_t length,
+                          uint8_t digest[SHA1_DIGEST_SIZE]) {
+    uint32_t state[5];
+    memcpy(state, prefixState, sizeof(state));
+
+    uint8_t block[SHA1_BLOCK_SIZE];
+    const uint64_t bitLength = static_cast<uint64_t>(SHA1_BLOCK_SIZE + length) * 8;
+
+    while (length >= SHA1_BLOCK_SIZE) {
+        sha1Compress(state, data);
+        data += SHA1_BLOCK_SIZE;
+        length -= SHA1_BLOCK_SIZE;
+    }
+
+    memset(block, 0, sizeof(block));
+    memcpy(block, data, length);
+    block[length] = 0x80;
+    if (length >= SHA1_BLOCK_SIZE - 8) {
+        sha1Compress(state, block);
+        memset(block, 0, sizeof(block));
+    }
+    for (size_t i = 0; i < 8; i++) {
+        block[SHA1_BLOCK_SIZE - 1 - i] = static_cast<uint8_t>(bitLength >> (i * 8));
+    }
+    sha1Compress(state, block);
+    storeDigest(state, digest);
+}
+
+/**
+ * @brief Precompute the HMAC inner and outer states for a key of at most 64 bytes
+ */
+void hmacKeyStates(const char* key, size_t keyLength, uint32_t inner[5], uint32_t outer[5]) {
+    uint8_t pad[SHA1_BLOCK_SIZE];
+
+    memset(pad, 0x36, sizeof(pad));
+    for (size_t i = 0; i < keyLength; i++) {
+        pad[i] ^= static_cast<uint8_t>(key[i]);
+    }
+    sha1Init(inner);
+    sha1Compress(inner, pad);
+
+    memset(pad, 0x5C, sizeof(pad));
+    for (size_t i = 0; i < keyLength; i++) {
+        pad[i] ^= static_cast<uint8_t>(key[i]);
+    }
+    sha1Init(outer);
+    sha1Compress(outer, pad);
+
+    memset(pad, 0, sizeof(pad));
+}
+
+/**
+ * @brief HMAC-SHA1 with precomputed key states
+ */
+void hmac(const uint32_t inner[5], const uint32_t outer[5], const uint8_t* data, size_t length,
+          uint8_t mac[SHA1_DIGEST_SIZE]) {
+    uint8_t innerDigest[SHA1_DIGEST_SIZE];
+    sha1FinishAfterBlock(inner, data, length, innerDigest);
+    sha1FinishAfterBlock(outer, innerDigest, sizeof(innerDigest), mac);
+}
+
+} // namespace
+
+bool WiFiCredsPMK::derive(const char* ssid, size_t ssidLength, const char* passphrase, size_t passphraseLength,
+                          uint8_t pmk[WIFICREDS_PMK_LENGTH]) {
+    if (ssid == nullptr || passphrase == nullptr || ssidLength == 0 || ssidLength > 32 ||
+        passphraseLength < 8 || passphraseLength > 63) {
+        return false;
+    }
+
+    uint32_t inner[5];
+    uint32_t outer[5];
+    hmacKeyStates(passphrase, passphraseLength, inner, outer);
+
+    // PBKDF2 needs two SHA-1 blocks for 32 bytes of output
+    uint8_t salt[32 + 4];
+    memcpy(salt, ssid, ssidLength);
+
+    for (uint8_t blockIndex = 1; blockIndex <= 2; blockIndex++) {
+        salt[ssidLength] = 0;
+        salt[ssidLength + 1] = 0;
+        salt[ssidLength + 2] = 0;
+        salt[ssidLength + 3] = blockIndex;
+
+        uint8_t u[SHA1_DIGEST_SIZE];
+        uint8_t t[SHA1_DIGEST_SIZE];
+        hmac(inner, outer, salt, ssidLength + 4, u);
+        memcpy(t, u, sizeof(t));
+
+        for (uint32_t i = 1; i < PBKDF2_ITERATIONS; i++) {
+            hmac(inner, outer, u, sizeof(u), u);
+            for (size_t j = 0; j < sizeof(t); j++) {
+                t[j] ^= u[j];
+            }
+        }
+
+        const size_t offset = (blockIndex - 1) * SHA1_DIGEST_SIZE;
+        const size_t count = (blockIndex == 1) ? SHA1_DIGEST_SIZE : WIFICREDS_PMK_LENGTH - SHA1_DIGEST_SIZE;
+        memcpy(pmk + offset, t, count);
+        memset(u, 0, sizeof(u));
+        memset(t, 0, sizeof(t));
+    }
+
+    memset(inner, 0, sizeof(inner));
+    memset(outer, 0, sizeof(outer));
+    return true;
+}
+
+void WiFiCredsPMK::toHex(const uint8_t pmk[WIFICREDS_PMK_LENGTH], char hex[WIFICREDS_PSK_HEX_SIZE]) {
+    static const char digits[] = "0123456789abcdef";
+    for (size_t i = 0; i < WIFICREDS_PMK_LENGTH; i++) {
+        hex[i * 2] = digits[pmk[i] >> 4];
+        hex[i * 2 + 1] = digits[pmk[i] & 0x0F];
+    }
+    hex[WIFICREDS_PMK_LENGTH * 2] = '\0';
+}
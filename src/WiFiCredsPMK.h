@@ -0,0 +1,60 @@
+/**
+ * @file WiFiCredsPMK.h
+ * @brief WPA2 pairwise master key (PMK) derivation for the WiFiCreds library
+ * @author Rithik Krisna M
+ * @version 1.0.4
+ * @date 2025
+ *
+ * WPA2-Personal derives a 32-byte PMK from the SSID and passphrase with
+ * PBKDF2-HMAC-SHA1 (4096 iterations). The radio stacks repeat this on every
+ * WiFi.begin(ssid, passphrase), which takes hundreds of milliseconds to
+ * seconds on small MCUs. Handing the stack the PMK (as 64 hex characters)
+ * skips that work.
+ *
+ * @note Portable C++, no hardware crypto or heap required
+ */
+
+#ifndef WIFICREDS_PMK_H
+#define WIFICREDS_PMK_H
+
+#include "WiFiCreds.h"
+
+/**
+ * @class WiFiCredsPMK
+ * @brief PBKDF2-HMAC-SHA1 PMK derivation and formatting helpers
+ *
+ * @note Most sketches use WiFiCreds::getPMK() and WiFiCreds::getPSKHex(),
+ *       which also use precomputed and cached keys
+ */
+class WiFiCredsPMK {
+public:
+    /**
+     * @brief Derive the WPA2 PMK for an SSID and passphrase
+     *
+     * @param ssid Network SSID (1-32 bytes)
+     * @param ssidLength Length of @p ssid
+     * @param passphrase WPA2 passphrase (8-63 characters)
+     * @param passphraseLength Length of @p passphrase
+     * @param pmk Receives the 32-byte PMK
+     * @return true on success, false if the SSID or passphrase length is out of range
+     * @note Runs 8192 SHA-1 compressions; expect hundreds of milliseconds on an ESP8266
+     */
+    static bool derive(const char* ssid, size_t ssidLength, const char* passphrase, size_t passphraseLength,
+                       uint8_t pmk[WIFICREDS_PMK_LENGTH]);
+
+    /**
+     * @brief Format a PMK as the 64-character hex PSK accepted by WiFi.begin()
+     *
+     * @param pmk The 32-byte PMK
+     * @param hex Receives 64 lowercase hex characters and a null terminator
+     */
+    static void toHex(const uint8_t pmk[WIFICREDS_PMK_LENGTH], char hex[WIFICREDS_PSK_HEX_SIZE]);
+
+private:
+    // Prevent instantiation of this class
+    WiFiCredsPMK() = delete;
+    WiFiCredsPMK(const WiFiCredsPMK&) = delete;
+    WiFiCredsPMK& operator=(const WiFiCredsPMK&) = delete;
+};
+
+#endif // WIFICREDS_PMK_H
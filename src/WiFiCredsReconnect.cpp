@@ -0,0 +1,181 @@
+/**
+ * @file WiFiCredsReconnect.cpp
+ * @brief Implementation of the reconnect scheduler
+ * @author Rithik Krisna M
+ * @version 1.0.4
+ * @date 2025
+ */
+
+#include "WiFiCredsReconnect.h"
+
+WiFiCredsReconnect::WiFiCredsReconnect(WiFiCredsDriver& driver, WiFiCredsConnection& connection, uint32_t seed)
+    : _driver(driver), _connection(connection), _random(seed != 0 ? seed : 1),
+      _baseMs(WIFICREDS_RECONNECT_BASE_DELAY), _maxMs(WIFICREDS_RECONNECT_MAX_DELAY),
+      _timeoutMs(WIFICREDS_TIMEOUT_LEARNED), _slotCount(0), _current(0), _attempting(false), _waiting(false),
+      _budget(WIFICREDS_RECONNECT_BUDGET), _tokens(WIFICREDS_RECONNECT_BUDGET),
+      _refillMs(WIFICREDS_RECONNECT_BUDGET_REFILL), _refilledAt(0), _attempts(0) {}
+
+bool WiFiCredsReconnect::add(const char* name) {
+    const CredentialView creds = WiFiCreds::resolve(name);
+    if (creds.resolution == CredentialResolution::None || _slotCount >= WIFICREDS_RECONNECT_SLOTS) {
+        return false;
+    }
+    Slot& slot = _slots[_slotCount++];
+    slot.credentialIndex = static_cast<uint16_t>(creds.index);
+    slot.failures = 0;
+    slot.delayMs = _baseMs;
+    slot.notBefore = _driver.now();
+    return true;
+}
+
+void WiFiCredsReconnect::setDelays(uint32_t baseMs, uint32_t maxMs) {
+    _baseMs = (baseMs > 0) ? baseMs : 1;
+    // Three times the cap must still fit the 32-bit clock
+    _maxMs = (maxMs < _baseMs) ? _baseMs : ((maxMs > 0x40000000UL) ? 0x40000000UL : maxMs);
+}
+
+void WiFiCredsReconnect::setBudget(uint8_t attempts, uint32_t refillMs) {
+    _budget = (attempts > 0) ? attempts : 1;
+    _tokens = (_tokens < _budget) ? _tokens : _budget;
+    _refillMs = (refillMs > 0) ? refillMs : 1;
+}
+
+WiFiCredsConnectionState WiFiCredsReconnect::poll() {
+    const WiFiCredsConnectionState state = _connection.poll();
+    const uint32_t now = _driver.now();
+    
+    refill(now);
+    
+    if (state == WiFiCredsConnectionState::Connected) {
+        if (_attempting) {
+            // Success: this set starts from scratch the next time
+            _slots[_current].failures = 0;
+            _slots[_current].delayMs = _baseMs;
+            _attempting = false;
+        }
+        _waiting = false;
+        return state;
+    }
+    
+    // Someone else's attempt, such as a roam, is left alone
+    if (state == WiFiCredsConnectionState::Connecting) {
+        return state;
+    }
+    
+    if (_attempting) {
+        _attempting = false;
+        _waiting = true;
+        backOff(_slots[_current], now);
+    } else if (!_waiting) {
+        startWaiting(now);
+    }
+    
+    if (_slotCount == 0 || _tokens == 0) {
+        return state;
+    }
+    const size_t next = nextSlot();
+    if (static_cast<int32_t>(now - _slots[next].notBefore) < 0) {
+        return state;
+    }
+    
+    if (!_connection.connectIndex(_slots[next].credentialIndex, _timeoutMs)) {
+        // The set is gone (a smaller table after an update); keep it out of the way
+        backOff(_slots[next], now);
+        return state;
+    }
+    _tokens--;
+    _attempts++;
+    _current = next;
+    _attempting = true;
+    return _connection.state();
+}
+
+void WiFiCredsReconnect::reset() {
+    const uint32_t now = _driver.now();
+    for (size_t i = 0; i < _slotCount; i++) {
+        _slots[i].failures = 0;
+        _slots[i].delayMs = _baseMs;
+        _slots[i].notBefore = now;
+    }
+    _tokens = _budget;
+    _refilledAt = now;
+    _waiting = false;
+}
+
+uint32_t WiFiCredsReconnect::nextAttemptIn() const {
+    if (!_waiting || _slotCount == 0) {
+        return 0;
+    }
+    const uint32_t now = _driver.now();
+    const Slot& slot = _slots[nextSlot()];
+    uint32_t wait = (static_cast<int32_t>(slot.notBefore - now) > 0) ? slot.notBefore - now : 0;
+    
+    // With the budget used up, the next token decides
+    if (_tokens == 0) {
+        // The token may be due already and only wait for the next poll() to be credited
+        const uint32_t refillAt = _refilledAt + _refillMs;
+        const uint32_t refill = (static_cast<int32_t>(refillAt - now) > 0) ? refillAt - now : 0;
+        wait = (refill > wait) ? refill : wait;
+    }
+    return wait;
+}
+
+// ===== PRIVATE HELPER METHODS =====
+
+void WiFiCredsReconnect::startWaiting(uint32_t now) {
+    _waiting = true;
+    
+    if (_slotCount == 0) {
+        const CredentialView last = _connection.credentials();
+        add((last.resolution != CredentialResolution::None) ? last.name : nullptr);
+    }
+    
+    // Devices that lost the link together spread their first attempts over the base delay;
+    // one value for all sets keeps them in the order they were added
+    const uint32_t first = now + randomBetween(0, _baseMs - 1);
+    for (size_t i = 0; i < _slotCount; i++) {
+        if (_slots[i].failures == 0 || static_cast<int32_t>(first - _slots[i].notBefore) > 0) {
+            _slots[i].notBefore = first;
+        }
+    }
+}
+
+void WiFiCredsReconnect::backOff(Slot& slot, uint32_t now) {
+    if (slot.failures < 255) {
+        slot.failures++;
+    }
+    // Decorrelated jitter: between the base and three times the last delay
+    const uint32_t previous = (slot.delayMs < _maxMs) ? slot.delayMs : _maxMs;
+    const uint32_t delay = randomBetween(_baseMs, previous * 3);
+    slot.delayMs = (delay < _maxMs) ? delay : _maxMs;
+    slot.notBefore = now + slot.delayMs;
+}
+
+size_t WiFiCredsReconnect::nextSlot() const {
+    size_t next = 0;
+    for (size_t i = 1; i < _slotCount; i++) {
+        if (static_cast<int32_t>(_slots[i].notBefore - _slots[next].notBefore) < 0) {
+            next = i;
+        }
+    }
+    return next;
+}
+
+void WiFiCredsReconnect::refill(uint32_t now) {
+    if (_tokens >= _budget) {
+        _refilledAt = now;
+        return;
+    }
+    while (_tokens < _budget && now - _refilledAt >= _refillMs) {
+        _tokens++;
+        _refilledAt += _refillMs;
+    }
+}
+
+uint32_t WiFiCredsReconnect::randomBetween(uint32_t low, uint32_t high) {
+    // xorshift32
+    _random ^= _random << 13;
+    _random ^= _random >> 17;
+    _random ^= _random << 5;
+    return (high > low) ? low + _random % (high - low + 1) : low;
+}
\ No newline at end of file
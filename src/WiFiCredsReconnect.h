@@ -0,0 +1,216 @@
+/**
+ * @file WiFiCredsReconnect.h
+ * @brief Reconnect scheduling with exponential backoff, jitter and an attempt budget
+ * @author Rithik Krisna M
+ * @version 1.0.4
+ * @date 2025
+ *
+ * Retrying every second after the link is lost is harmless for one device,
+ * but when an access point reboots, every device in range retries at the
+ * same moment and keeps doing so in lock-step. The AP comes back to a storm
+ * of association requests and admits the fleet far more slowly than it
+ * could. WiFiCredsReconnect spreads and thins out those retries:
+ * - the first attempt after a lost link waits a random time below the base
+ *   delay, so devices that lost the link together do not retry together
+ * - every failed attempt grows the delay of that credential set with
+ *   decorrelated jitter: a random delay between the base delay and three
+ *   times the previous one, capped at the maximum delay
+ * - a token bucket limits the attempts of the device as a whole: at most
+ *   WIFICREDS_RECONNECT_BUDGET in a burst, refilled by one every
+ *   WIFICREDS_RECONNECT_BUDGET_REFILL
+ *
+ * Each credential set added with add() keeps its own backoff, and the set
+ * whose delay runs out first is tried next, so a network that is down does
+ * not hold up a fallback network that is up.
+ *
+ * @note Seed every device differently (MAC address, esp_random()) with
+ *       setSeed(), or the jitter is the same on every device and the storm
+ *       comes back
+ */
+
+#ifndef WIFICREDS_RECONNECT_H
+#define WIFICREDS_RECONNECT_H
+
+#include "WiFiCreds.h"
+#include "WiFiCredsConnection.h"
+
+/**
+ * @def WIFICREDS_RECONNECT_SLOTS
+ * @brief Maximum number of credential sets with their own backoff
+ */
+#ifndef WIFICREDS_RECONNECT_SLOTS
+#define WIFICREDS_RECONNECT_SLOTS 4
+#endif
+
+/// Default base delay in milliseconds
+#ifndef WIFICREDS_RECONNECT_BASE_DELAY
+#define WIFICREDS_RECONNECT_BASE_DELAY 2000UL
+#endif
+
+/// Default longest delay in milliseconds between two attempts on one credential set
+#ifndef WIFICREDS_RECONNECT_MAX_DELAY
+#define WIFICREDS_RECONNECT_MAX_DELAY 30000UL
+#endif
+
+/// Default number of attempts the device may make in a burst
+#ifndef WIFICREDS_RECONNECT_BUDGET
+#define WIFICREDS_RECONNECT_BUDGET 8
+#endif
+
+/// Default milliseconds after which one more attempt is allowed
+#ifndef WIFICREDS_RECONNECT_BUDGET_REFILL
+#define WIFICREDS_RECONNECT_BUDGET_REFILL 10000UL
+#endif
+
+/**
+ * @class WiFiCredsReconnect
+ * @brief Keeps a WiFiCredsConnection connected without hammering the network
+ *
+ * poll() replaces WiFiCredsConnection::poll() in loop(). Events still go to
+ * the handler set on the connection.
+ *
+ * @code
+ * WiFiCredsArduinoDriver driver;
+ * WiFiCredsConnection connection(driver);
+ * WiFiCredsReconnect reconnect(driver, connection);
+ *
+ * void setup() {
+ *     reconnect.setSeed(esp_random());
+ *     reconnect.add("office");
+ *     reconnect.add("mobile"); // fallback, with its own backoff
+ * }
+ *
+ * void loop() {
+ *     reconnect.poll(); // connects, and reconnects after a lost link
+ * }
+ * @endcode
+ */
+class WiFiCredsReconnect {
+public:
+    /**
+     * @brief Create a reconnect scheduler
+     * @param driver Driver of the connection, used for the clock
+     * @param connection Connection that is kept connected
+     * @param seed Seed for the jitter, see setSeed()
+     */
+    WiFiCredsReconnect(WiFiCredsDriver& driver, WiFiCredsConnection& connection, uint32_t seed = 1);
+
+    /**
+     * @brief Seed the jitter
+     * @param seed Must differ between devices (0 is replaced by 1)
+     */
+    void setSeed(uint32_t seed) { _random = (seed != 0) ? seed : 1; }
+
+    /**
+     * @brief Add a credential set to try
+     *
+     * Without any, the set the connection used last is tried, or the default set.
+     *
+     * @param name Name of the credential set (nullptr for default)
+     * @return true if added, false if no set is available or WIFICREDS_RECONNECT_SLOTS is reached
+     */
+    bool add(const char* name);
+
+    /**
+     * @brief Set the range of the backoff delay
+     * @param baseMs Base delay in milliseconds: the first attempt after a lost link waits up to this long
+     * @param maxMs Longest delay in milliseconds between two attempts on one credential set
+     */
+    void setDelays(uint32_t baseMs, uint32_t maxMs);
+
+    /**
+     * @brief Set the attempt budget
+     * @param attempts Attempts allowed in a burst (at least 1)
+     * @param refillMs Milliseconds after which one more attempt is allowed
+     */
+    void setBudget(uint8_t attempts, uint32_t refillMs);
+
+    /**
+     * @brief Set the timeout of each attempt
+     * @param timeoutMs Milliseconds, or WIFICREDS_TIMEOUT_LEARNED (the default)
+     */
+    void setTimeout(uint32_t timeoutMs) { _timeoutMs = timeoutMs; }
+
+    /**
+     * @brief Poll the connection and start the next attempt when it is due
+     * @return WiFiCredsConnectionState State of the connection
+     */
+    WiFiCredsConnectionState poll();
+
+    /**
+     * @brief Forget all backoff; the next attempt starts as after a first lost link
+     */
+    void reset();
+
+    /// true while waiting for the next attempt
+    bool waiting() const { return _waiting; }
+
+    /**
+     * @brief Time until the next attempt
+     * @return uint32_t Milliseconds, 0 if an attempt is due or none is scheduled
+     */
+    uint32_t nextAttemptIn() const;
+
+    /// Attempts left in the budget
+    uint8_t budget() const { return _tokens; }
+
+    /// Number of attempts started
+    uint32_t attempts() const { return _attempts; }
+
+private:
+    /**
+     * @brief Backoff state of one credential set
+     */
+    struct Slot {
+        uint16_t credentialIndex;
+        uint8_t failures;      ///< Failed attempts since the last success, saturating at 255
+        uint32_t delayMs;      ///< Delay chosen after the last failure
+        uint32_t notBefore;    ///< Driver time of the next allowed attempt
+    };
+
+    WiFiCredsDriver& _driver;
+    WiFiCredsConnection& _connection;
+    uint32_t _random;
+    uint32_t _baseMs;
+    uint32_t _maxMs;
+    uint32_t _timeoutMs;
+
+    Slot _slots[WIFICREDS_RECONNECT_SLOTS];
+    size_t _slotCount;
+    size_t _current;           ///< Slot of the attempt in progress
+    bool _attempting;          ///< An attempt started here has not finished
+    bool _waiting;             ///< Disconnected, waiting for the next attempt
+
+    uint8_t _budget;
+    uint8_t _tokens;
+    uint32_t _refillMs;
+    uint32_t _refilledAt;
+    uint32_t _attempts;
+
+    /**
+     * @brief Schedule the first attempt after the link was lost or never made
+     */
+    void startWaiting(uint32_t now);
+
+    /**
+     * @brief Grow the delay of a slot after a failed attempt
+     */
+    void backOff(Slot& slot, uint32_t now);
+
+    /**
+     * @brief Slot whose delay runs out first
+     */
+    size_t nextSlot() const;
+
+    /**
+     * @brief Credit the attempts earned since the last refill
+     */
+    void refill(uint32_t now);
+
+    /**
+     * @brief Random value in [low, high]
+     */
+    uint32_t randomBetween(uint32_t low, uint32_t high);
+};
+
+#endif // WIFICREDS_RECONNECT_H
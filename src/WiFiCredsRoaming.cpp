@@ -0,0 +1,180 @@
+/**
+ * @file WiFiCredsRoaming.cpp
+ * @brief Implementation of the roaming engine
+ * @author Rithik Krisna M
+ * @version 1.0.4
+ * @date 2025
+ */
+
+#include "WiFiCredsRoaming.h"
+#include <string.h>     // Required for memcmp and memcpy
+
+namespace {
+
+// Samples the trend is extrapolated over
+const int32_t LOOKAHEAD_SAMPLES = static_cast<int32_t>(WIFICREDS_ROAM_LOOKAHEAD / WIFICREDS_ROAM_SAMPLE_PERIOD);
+
+// Samples the average trails a steady ramp by: (1 - a) / a for the weight a = 1/4 of sample()
+const int32_t LAG_SAMPLES = 3;
+
+static_assert(WIFICREDS_ROAM_SAMPLE_PERIOD > 0, "WIFICREDS_ROAM_SAMPLE_PERIOD must not be 0");
+
+/**
+ * @brief Round a value in 1/16 dB to whole dB, clamped to the int8_t range
+ */
+int8_t toDbm(int32_t sixteenths) {
+    const int32_t dbm = (sixteenths >= 0) ? (sixteenths + 8) / 16 : -((8 - sixteenths) / 16);
+    return static_cast<int8_t>((dbm < -128) ? -128 : ((dbm > 127) ? 127 : dbm));
+}
+
+} // namespace
+
+WiFiCredsRoaming::WiFiCredsRoaming(WiFiCredsDriver& driver, WiFiCredsConnection& connection,
+                                   WiFiCredsScanScheduler& scanner)
+    : _driver(driver), _connection(connection), _scanner(scanner),
+      _trigger(WIFICREDS_ROAM_TRIGGER), _margin(WIFICREDS_ROAM_MARGIN),
+      _linked(false), _average(0), _slope(0), _sampledAt(0), _weak(false),
+      _candidateCount(0), _candidatesAt(0), _seenScans(0),
+      _roaming(false), _roamIndex(0), _roamedAt(0), _roamCount(0), _failedRoams(0) {
+    memset(_bssid, 0, sizeof(_bssid));
+}
+
+bool WiFiCredsRoaming::poll() {
+    const uint32_t now = _driver.now();
+    
+    if (!_connection.isConnected()) {
+        _linked = false;
+        if (_roaming && _connection.state() == WiFiCredsConnectionState::Idle) {
+            // The target did not take us; any AP of the set beats no link
+            _roaming = false;
+            _failedRoams++;
+            _connection.connectIndex(_roamIndex);
+        }
+        return false;
+    }
+    _roaming = false;
+    
+    // A new link, whether made here or by the sketch, starts the filters over
+    uint8_t current[6];
+    if (!_driver.bssid(current)) {
+        return false;
+    }
+    if (!_linked || memcmp(current, _bssid, sizeof(_bssid)) != 0) {
+        memcpy(_bssid, current, sizeof(_bssid));
+        _linked = true;
+        _candidateCount = 0;
+        _average = static_cast<int32_t>(_driver.rssi()) * 16;
+        _slope = 0;
+        _sampledAt = now;
+        _weak = false;
+    } else if (now - _sampledAt >= WIFICREDS_ROAM_SAMPLE_PERIOD) {
+        _sampledAt = now;
+        sample(_driver.rssi());
+    }
+    
+    const size_t credentialIndex = _connection.credentials().index;
+    if (_scanner.scanCount() != _seenScans) {
+        _seenScans = _scanner.scanCount();
+        takeCandidates(credentialIndex);
+    }
+    
+    const int8_t predicted = predictedRssi();
+    if (predicted >= _trigger) {
+        _weak = false;
+        return false;
+    }
+    
+    // Weak or fading: scan at once, since the window for a roam is only a few seconds long.
+    // Candidates of a recent scan tell which channels to look at.
+    if (!_weak) {
+        _weak = true;
+        if (now - _candidatesAt >= WIFICREDS_ROAM_SCAN_PERIOD || !scanCandidates(INT8_MIN)) {
+            _scanner.scanNow();
+        }
+    } else if (_scanner.phase() == WiFiCredsScanPhase::Waiting) {
+        const uint32_t sinceScan = now - _scanner.lastScanAt();
+        if (_scanner.scanCount() == 0 || sinceScan >= WIFICREDS_ROAM_SCAN_PERIOD) {
+            _scanner.scanNow();
+        } else if (predicted < rssi() && sinceScan >= WIFICREDS_ROAM_TRACK_PERIOD) {
+            // On the move a candidate gains a few dB per second: follow the ones a roam could go to
+            scanCandidates(predicted);
+        }
+    }
+    
+    if (_candidateCount == 0 || now - _candidatesAt > WIFICREDS_ROAM_CANDIDATE_AGE ||
+        (_roamCount > 0 && now - _roamedAt < WIFICREDS_ROAM_HOLD)) {
+        return false;
+    }
+    
+    const WiFiCredsCandidate& best = _candidates[0];
+    if (best.rssi < predicted + _margin) {
+        return false;
+    }
+    
+    // Pinned to the BSSID and channel, so the stack neither searches the band nor picks the old AP
+    if (!_connection.connectIndex(credentialIndex, WIFICREDS_TIMEOUT_LEARNED, best.channel, best.bssid)) {
+        return false;
+    }
+    _roaming = true;
+    _roamIndex = credentialIndex;
+    _roamedAt = now;
+    _roamCount++;
+    _linked = false;
+    _candidateCount = 0;
+    return true;
+}
+
+int8_t WiFiCredsRoaming::rssi() const {
+    return _linked ? toDbm(_average) : 0;
+}
+
+int16_t WiFiCredsRoaming::trend() const {
+    // 1/16 dB per sample to 1/10 dB per second
+    return static_cast<int16_t>(_slope * 10 * 1000 / (16 * static_cast<int32_t>(WIFICREDS_ROAM_SAMPLE_PERIOD)));
+}
+
+int8_t WiFiCredsRoaming::predictedRssi() const {
+    if (!_linked) {
+        return 0;
+    }
+    // Only a falling signal is extrapolated; a rising one is no reason to stay or to roam
+    const int32_t slope = (_slope < 0) ? _slope : 0;
+    return toDbm(_average + slope * (LAG_SAMPLES + LOOKAHEAD_SAMPLES));
+}
+
+// ===== PRIVATE HELPER METHODS =====
+
+void WiFiCredsRoaming::sample(int8_t rssi) {
+    // EWMAs with weights 1/4 for the level and 1/8 for its change
+    const int32_t previous = _average;
+    _average += (static_cast<int32_t>(rssi) * 16 - _average) / 4;
+    _slope += ((_average - previous) - _slope) / 8;
+}
+
+bool WiFiCredsRoaming::scanCandidates(int32_t weakest) {
+    // A few dwells instead of a sweep of the band, so the results are fresh when they arrive
+    uint16_t channels = 0;
+    for (size_t i = 0; i < _candidateCount; i++) {
+        if (_candidates[i].rssi >= weakest && _candidates[i].channel <= WIFICREDS_MAX_CHANNEL) {
+            channels |= static_cast<uint16_t>(1U << _candidates[i].channel);
+        }
+    }
+    if (channels == 0) {
+        return false;
+    }
+    _scanner.scanChannels(channels);
+    return true;
+}
+
+void WiFiCredsRoaming::takeCandidates(size_t credentialIndex) {
+    _candidateCount = 0;
+    _candidatesAt = _scanner.lastScanAt();
+    
+    // The scheduler's table is sorted by RSSI, so the candidates are too
+    for (size_t i = 0; i < _scanner.count() && _candidateCount < WIFICREDS_ROAM_CANDIDATES; i++) {
+        const WiFiCredsCandidate* known = _scanner.candidate(i);
+        if (known->credentialIndex == credentialIndex && memcmp(known->bssid, _bssid, sizeof(_bssid)) != 0) {
+            _candidates[_candidateCount++] = *known;
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,208 @@
+/**
+ * @file WiFiCredsRoaming.h
+ * @brief Proactive roaming between access points of the same credential set
+ * @author Rithik Krisna M
+ * @version 1.0.4
+ * @date 2025
+ *
+ * Station stacks stay associated with an access point until its signal is
+ * gone, so a device moving through a building served by many APs with the
+ * same SSID first loses the link and only then reconnects, seconds later.
+ * WiFiCredsRoaming watches the link RSSI instead. When its trend says the
+ * signal is about to become weak, it scans at once and moves to a better AP
+ * of the same credential set while the current link still works, with a
+ * connect pinned to that AP's BSSID and channel.
+ *
+ * The link RSSI is sampled every WIFICREDS_ROAM_SAMPLE_PERIOD and smoothed
+ * with an EWMA; a second EWMA of its change gives the trend, which is used
+ * to predict the RSSI WIFICREDS_ROAM_LOOKAHEAD ahead. While the prediction
+ * is below the trigger, the band is swept every WIFICREDS_ROAM_SCAN_PERIOD,
+ * and while the link fades, the channels of the candidates about as strong
+ * as it are rescanned every WIFICREDS_ROAM_TRACK_PERIOD (a dwell or two per
+ * scan, see WiFiCredsScanScheduler::scanChannels()). Two rules keep the
+ * device from bouncing between APs of similar strength:
+ * - an AP must beat the predicted RSSI by the hysteresis margin (setMargin())
+ * - after a roam, the next one waits at least WIFICREDS_ROAM_HOLD
+ *
+ * @note Roaming never happens while the predicted RSSI is above the trigger
+ *       level (setTrigger()), so a good link is never interrupted
+ */
+
+#ifndef WIFICREDS_ROAMING_H
+#define WIFICREDS_ROAMING_H
+
+#include "WiFiCreds.h"
+#include "WiFiCredsConnection.h"
+#include "WiFiCredsScanScheduler.h"
+
+/// Default RSSI in dBm below which the device looks for a better access point
+#ifndef WIFICREDS_ROAM_TRIGGER
+#define WIFICREDS_ROAM_TRIGGER (-67)
+#endif
+
+/// Default hysteresis margin in dB a new access point must be stronger by
+#ifndef WIFICREDS_ROAM_MARGIN
+#define WIFICREDS_ROAM_MARGIN 8
+#endif
+
+/// Milliseconds between two samples of the link RSSI
+#ifndef WIFICREDS_ROAM_SAMPLE_PERIOD
+#define WIFICREDS_ROAM_SAMPLE_PERIOD 500UL
+#endif
+
+/// How far ahead in milliseconds the RSSI trend is extrapolated
+#ifndef WIFICREDS_ROAM_LOOKAHEAD
+#define WIFICREDS_ROAM_LOOKAHEAD 2000UL
+#endif
+
+/// Minimum time in milliseconds between two roams
+#ifndef WIFICREDS_ROAM_HOLD
+#define WIFICREDS_ROAM_HOLD 10000UL
+#endif
+
+/// While the link is weak, scan at least this often (milliseconds)
+#ifndef WIFICREDS_ROAM_SCAN_PERIOD
+#define WIFICREDS_ROAM_SCAN_PERIOD 4000UL
+#endif
+
+/// While the link fades, the channels of candidates about as strong as it are rescanned this often
+#ifndef WIFICREDS_ROAM_TRACK_PERIOD
+#define WIFICREDS_ROAM_TRACK_PERIOD 250UL
+#endif
+
+/// Scan results older than this many milliseconds are not roamed to
+#ifndef WIFICREDS_ROAM_CANDIDATE_AGE
+#define WIFICREDS_ROAM_CANDIDATE_AGE 8000UL
+#endif
+
+/**
+ * @def WIFICREDS_ROAM_CANDIDATES
+ * @brief Maximum number of other access points of the connected set kept as roaming targets
+ */
+#ifndef WIFICREDS_ROAM_CANDIDATES
+#define WIFICREDS_ROAM_CANDIDATES 4
+#endif
+
+/**
+ * @class WiFiCredsRoaming
+ * @brief Moves the link to a stronger access point of the same network before it is lost
+ *
+ * Works on top of a WiFiCredsConnection, which makes the connects, and a
+ * WiFiCredsScanScheduler, which supplies the scan results. Poll all three
+ * from loop(). A roam shows up on the connection's event handler as a
+ * Connecting and a Connected event, without a Disconnected event.
+ *
+ * @code
+ * WiFiCredsArduinoDriver driver;
+ * WiFiCredsConnection connection(driver);
+ * WiFiCredsScanScheduler scanner(driver);
+ * WiFiCredsRoaming roaming(driver, connection, scanner);
+ *
+ * void loop() {
+ *     connection.poll();
+ *     scanner.poll();
+ *     roaming.poll();
+ * }
+ * @endcode
+ */
+class WiFiCredsRoaming {
+public:
+    /**
+     * @brief Create a roaming engine
+     * @param driver Driver of the connection, used for link RSSI and BSSID
+     * @param connection Connection that is moved between access points
+     * @param scanner Scheduler whose scans provide the candidates
+     */
+    WiFiCredsRoaming(WiFiCredsDriver& driver, WiFiCredsConnection& connection, WiFiCredsScanScheduler& scanner);
+
+    /**
+     * @brief Set the RSSI below which a better access point is looked for
+     * @param dBm Trigger level, compared with the predicted link RSSI
+     */
+    void setTrigger(int8_t dBm) { _trigger = dBm; }
+
+    /**
+     * @brief Set the hysteresis margin
+     * @param dB How much stronger than the predicted link RSSI a candidate must be
+     */
+    void setMargin(uint8_t dB) { _margin = dB; }
+
+    /**
+     * @brief Sample the link, update the candidates and roam if it pays off
+     * @return true if a roam was started in this call
+     */
+    bool poll();
+
+    /// Smoothed link RSSI in dBm, 0 while not connected
+    int8_t rssi() const;
+
+    /// RSSI trend in tenths of a dB per second (negative while the signal fades)
+    int16_t trend() const;
+
+    /// Link RSSI in dBm expected WIFICREDS_ROAM_LOOKAHEAD from now
+    int8_t predictedRssi() const;
+
+    /// true while a roam is in progress
+    bool roaming() const { return _roaming; }
+
+    /// Number of roams started
+    uint32_t roamCount() const { return _roamCount; }
+
+    /// Number of roams whose connect failed or timed out
+    uint32_t failedRoams() const { return _failedRoams; }
+
+    /// Number of candidates from the last scan
+    size_t candidateCount() const { return _candidateCount; }
+
+    /**
+     * @brief Access a candidate: another access point of the connected credential set
+     * @param rank 0 is the strongest
+     * @return const WiFiCredsCandidate* The candidate, or nullptr if @p rank is invalid
+     */
+    const WiFiCredsCandidate* candidate(size_t rank) const {
+        return (rank < _candidateCount) ? &_candidates[rank] : nullptr;
+    }
+
+private:
+    WiFiCredsDriver& _driver;
+    WiFiCredsConnection& _connection;
+    WiFiCredsScanScheduler& _scanner;
+    int8_t _trigger;
+    uint8_t _margin;
+
+    bool _linked;               ///< The RSSI filter belongs to the current link
+    uint8_t _bssid[6];          ///< Access point of the current link
+    int32_t _average;           ///< Smoothed RSSI in 1/16 dB
+    int32_t _slope;             ///< Smoothed RSSI change per sample in 1/16 dB
+    uint32_t _sampledAt;
+    bool _weak;                 ///< The predicted RSSI was below the trigger at the last poll()
+
+    WiFiCredsCandidate _candidates[WIFICREDS_ROAM_CANDIDATES]; ///< Strongest first
+    size_t _candidateCount;
+    uint32_t _candidatesAt;     ///< Start of the scan the candidates come from
+    uint32_t _seenScans;        ///< Scan count of the scheduler when candidates were last taken
+
+    bool _roaming;
+    size_t _roamIndex;          ///< Credential set of the roam in progress
+    uint32_t _roamedAt;
+    uint32_t _roamCount;
+    uint32_t _failedRoams;
+
+    /**
+     * @brief Feed one RSSI sample into the filters
+     */
+    void sample(int8_t rssi);
+
+    /**
+     * @brief Rescan the channels of the candidates at least @p weakest dBm strong
+     * @return false if there are none, so nothing is scanned
+     */
+    bool scanCandidates(int32_t weakest);
+
+    /**
+     * @brief Take the other access points of the connected set from the scheduler's last scan
+     */
+    void takeCandidates(size_t credentialIndex);
+};
+
+#endif // WIFICREDS_ROAMING_H
@@ -0,0 +1,127 @@
+/**
+ * @file WiFiCredsScan.cpp
+ * @brief Implementation of the scan-result to credential join
+ * @author Rithik Krisna M
+ * @version 1.0.4
+ * @date 2025
+ */
+
+#include "WiFiCredsScan.h"
+#include <string.h>     // Required for memcpy and strcmp
+
+namespace {
+
+/**
+ * @brief true if @p a should be tried before @p b
+ */
+bool ranksBefore(const WiFiCredsCandidate& a, const WiFiCredsCandidate& b) {
+    if (a.rssi != b.rssi) {
+        return a.rssi > b.rssi;
+    }
+    return a.credentialIndex < b.credentialIndex;
+}
+
+} // namespace
+
+size_t WiFiCredsScan::rank(const WiFiCredsScanEntry* results, size_t resultCount,
+                           WiFiCredsCandidate* candidates, size_t maxCandidates) {
+    size_t count = 0;
+    
+    if (results == nullptr) {
+        return 0;
+    }
+    
+    for (size_t i = 0; i < resultCount; i++) {
+        count = insert(results[i], candidates, count, maxCandidates);
+    }
+    
+    return count;
+}
+
+size_t WiFiCredsScan::rank(WiFiCredsDriver& driver, int resultCount,
+                           WiFiCredsCandidate* candidates, size_t maxCandidates) {
+    size_t count = 0;
+    WiFiCredsScanEntry entry;
+    
+    for (int i = 0; i < resultCount; i++) {
+        if (driver.scanResult(i, entry)) {
+            count = insert(entry, candidates, count, maxCandidates);
+        }
+    }
+    
+    return count;
+}
+
+size_t WiFiCredsScan::insert(const WiFiCredsScanEntry& entry, WiFiCredsCandidate* candidates,
+                             size_t count, size_t maxCandidates) {
+    if (candidates == nullptr || maxCandidates == 0) {
+        return 0;
+    }
+    
+    uint16_t matches[WIFICREDS_SCAN_SSID_MATCHES];
+    const size_t matchCount = WiFiCreds::findSSID(entry.ssid, matches, WIFICREDS_SCAN_SSID_MATCHES);
+    
+    for (size_t m = 0; m < matchCount; m++) {
+        // Security must match, or the connection attempt is bound to fail
+        const bool credentialOpen = WiFiCreds::getPasswordLengthAt(matches[m]) == 0;
+        if (credentialOpen != entry.open) {
+            continue;
+        }
+        
+        WiFiCredsCandidate candidate;
+        candidate.credentialIndex = matches[m];
+        memcpy(candidate.bssid, entry.bssid, sizeof(candidate.bssid));
+        candidate.channel = entry.channel;
+        candidate.rssi = entry.rssi;
+        
+        // Full list and not better than the weakest entry: nothing to do
+        if (count == maxCandidates && !ranksBefore(candidate, candidates[count - 1])) {
+            continue;
+        }
+        
+        // Insertion into the sorted list; the list is short, so this beats sorting afterwards
+        size_t position = (count < maxCandidates) ? count++ : count - 1;
+        while (position > 0 && ranksBefore(candidate, candidates[position - 1])) {
+            candidates[position] = candidates[position - 1];
+            position--;
+        }
+        candidates[position] = candidate;
+    }
+    
+    return count;
+}
+
+int WiFiCredsScan::find(const WiFiCredsScanEntry* results, size_t resultCount, const char* ssid) {
+    int found = -1;
+    
+    if (results == nullptr || ssid == nullptr) {
+        return -1;
+    }
+    
+    for (size_t i = 0; i < resultCount; i++) {
+        if (strcmp(results[i].ssid, ssid) == 0 && (found < 0 || results[i].rssi > results[found].rssi)) {
+            found = static_cast<int>(i);
+        }
+    }
+    
+    return found;
+}
+
+int WiFiCredsScan::find(WiFiCredsDriver& driver, int resultCount, const char* ssid, WiFiCredsScanEntry& entry) {
+    int found = -1;
+    WiFiCredsScanEntry current;
+    
+    if (ssid == nullptr) {
+        return -1;
+    }
+    
+    for (int i = 0; i < resultCount; i++) {
+        if (driver.scanResult(i, current) && strcmp(current.ssid, ssid) == 0 &&
+            (found < 0 || current.rssi > entry.rssi)) {
+            entry = current;
+            found = i;
+        }
+    }
+    
+    return found;
+}
\ No newline at end of file
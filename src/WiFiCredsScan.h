@@ -0,0 +1,132 @@
+/**
+ * @file WiFiCredsScan.h
+ * @brief Joins Wi-Fi scan results against the credential table
+ * @author Rithik Krisna M
+ * @version 1.0.4
+ * @date 2025
+ *
+ * Turns a scan into a ranked list of networks the device can actually join:
+ * every scan result is looked up in the compile-time SSID index once, and
+ * each match becomes a (credential, BSSID, channel, RSSI) candidate. The
+ * list is kept sorted by signal strength in a caller-provided array, so no
+ * String objects or heap allocations are involved. find() does the same for
+ * a single SSID, such as the default network's.
+ */
+
+#ifndef WIFICREDS_SCAN_H
+#define WIFICREDS_SCAN_H
+
+#include "WiFiCreds.h"
+#include "WiFiCredsDriver.h"
+
+/**
+ * @def WIFICREDS_SCAN_SSID_MATCHES
+ * @brief Maximum number of credential sets considered for one scanned SSID
+ */
+#ifndef WIFICREDS_SCAN_SSID_MATCHES
+#define WIFICREDS_SCAN_SSID_MATCHES 4
+#endif
+
+/**
+ * @struct WiFiCredsCandidate
+ * @brief A network from the scan that a credential set can connect to
+ */
+struct WiFiCredsCandidate {
+    uint16_t credentialIndex; ///< Index of the credential set in CREDENTIAL_SETS
+    uint8_t bssid[6];         ///< Access point MAC address
+    uint8_t channel;          ///< Wi-Fi channel
+    int8_t rssi;              ///< Signal strength in dBm
+};
+
+/**
+ * @class WiFiCredsScan
+ * @brief Ranks scan results by signal strength against all credential sets
+ *
+ * Candidates are ordered by RSSI (strongest first); on equal RSSI the set
+ * that comes first in CREDENTIAL_SETS wins. A credential set only matches
+ * a network with the same security: a set without a password matches open
+ * networks only, and a set with a password matches encrypted networks only.
+ *
+ * @code
+ * WiFiCredsCandidate candidates[8];
+ * size_t count = WiFiCredsScan::rank(driver, driver.scanNetworks(), candidates, 8);
+ * if (count > 0) {
+ *     CredentialView creds = WiFiCreds::resolveIndex(candidates[0].credentialIndex);
+ *     driver.begin(creds.ssid, creds.password, candidates[0].channel, candidates[0].bssid);
+ * }
+ * @endcode
+ */
+class WiFiCredsScan {
+public:
+    /**
+     * @brief Rank an array of scan results
+     *
+     * @param results Scan results
+     * @param resultCount Number of entries in @p results
+     * @param candidates Receives the ranked candidates
+     * @param maxCandidates Capacity of @p candidates; weaker candidates beyond it are dropped
+     * @return size_t Number of candidates written
+     */
+    static size_t rank(const WiFiCredsScanEntry* results, size_t resultCount,
+                       WiFiCredsCandidate* candidates, size_t maxCandidates);
+
+    /**
+     * @brief Rank the results of the driver's last scan
+     *
+     * Results are read one at a time, so no array of scan entries is needed.
+     *
+     * @param driver Driver that ran the scan
+     * @param resultCount Value returned by driver.scanNetworks() (negative means no results)
+     * @param candidates Receives the ranked candidates
+     * @param maxCandidates Capacity of @p candidates
+     * @return size_t Number of candidates written
+     */
+    static size_t rank(WiFiCredsDriver& driver, int resultCount,
+                       WiFiCredsCandidate* candidates, size_t maxCandidates);
+
+    /**
+     * @brief Add the candidates for one scan result to a ranked list
+     *
+     * Use this to feed results straight from a Wi-Fi library's scan API.
+     *
+     * @param entry One scan result
+     * @param candidates Ranked list to insert into
+     * @param count Number of candidates currently in @p candidates
+     * @param maxCandidates Capacity of @p candidates
+     * @return size_t New number of candidates in @p candidates
+     */
+    static size_t insert(const WiFiCredsScanEntry& entry, WiFiCredsCandidate* candidates,
+                         size_t count, size_t maxCandidates);
+
+    /**
+     * @brief Find the strongest result for one SSID in an array of scan results
+     *
+     * Compares the fixed SSID buffers directly; use it instead of
+     * WiFi.SSID(i) == ssid, which builds a String per result.
+     *
+     * @param results Scan results
+     * @param resultCount Number of entries in @p results
+     * @param ssid SSID to look for
+     * @return int Index of the strongest matching result, or -1 if there is none
+     */
+    static int find(const WiFiCredsScanEntry* results, size_t resultCount, const char* ssid);
+
+    /**
+     * @brief Find the strongest result for one SSID in the driver's last scan
+     *
+     * @param driver Driver that ran the scan
+     * @param resultCount Value returned by driver.scanNetworks() (negative means no results)
+     * @param ssid SSID to look for
+     * @param entry Receives the strongest matching result; unspecified if there is none
+     * @return int Index of that result, or -1 if there is none
+     */
+    static int find(WiFiCredsDriver& driver, int resultCount, const char* ssid, WiFiCredsScanEntry& entry);
+
+private:
+    // Prevent instantiation of this class
+    WiFiCredsScan() = delete;
+    WiFiCredsScan(const WiFiCredsScan&) = delete;
+    WiFiCredsScan& operator=(const WiFiCredsScan&) = delete;
+};
+
+#endif // WIFICREDS_SCAN_H
@@ -0,0 +1,256 @@
+/**
+ * @file WiFiCredsScanScheduler.cpp
+ * @brief Implementation of the background scan scheduler
+ * @author Rithik Krisna M
+ * @version 1.0.4
+ * @date 2025
+ */
+
+#include "WiFiCredsScanScheduler.h"
+#include <string.h>     // Required for memcmp
+
+namespace {
+
+/// Same network in both scans: same credential set and access point
+bool sameNetwork(const WiFiCredsCandidate& a, const WiFiCredsCandidate& b) {
+    return a.credentialIndex == b.credentialIndex && memcmp(a.bssid, b.bssid, sizeof(a.bssid)) == 0;
+}
+
+} // namespace
+
+WiFiCredsScanScheduler::WiFiCredsScanScheduler(WiFiCredsDriver& driver)
+    : _driver(driver), _channels(nullptr), _phase(WiFiCredsScanPhase::Waiting),
+      _minPeriod(WIFICREDS_SCAN_MIN_PERIOD), _maxPeriod(WIFICREDS_SCAN_MAX_PERIOD),
+      _period(WIFICREDS_SCAN_MIN_PERIOD), _nextScanAt(0), _startedAt(0), _due(true),
+      _requestedChannels(0), _requested(false),
+      _stepStartedAt(0), _scanChannels(0), _scanChannel(0), _fullSweep(true), _sweepDue(true),
+      _sweepEvery(WIFICREDS_SCAN_FULL_SWEEP_EVERY), _sinceSweep(0),
+      _count(0), _pendingCount(0), _resultCount(0), _nextResult(0), _lastChanges(0), _scanCount(0) {}
+
+WiFiCredsScanScheduler::WiFiCredsScanScheduler(WiFiCredsDriver& driver, WiFiCredsChannelMap& channels)
+    : WiFiCredsScanScheduler(driver) {
+    _channels = &channels;
+}
+
+void WiFiCredsScanScheduler::setPeriodRange(uint32_t minPeriod, uint32_t maxPeriod) {
+    _minPeriod = (minPeriod > 0) ? minPeriod : 1;
+    _maxPeriod = (maxPeriod > _minPeriod) ? maxPeriod : _minPeriod;
+    if (_period < _minPeriod) {
+        _period = _minPeriod;
+    } else if (_period > _maxPeriod) {
+        _period = _maxPeriod;
+    }
+}
+
+void WiFiCredsScanScheduler::setFullSweepInterval(uint8_t scans) {
+    _sweepEvery = (scans > 0) ? scans : 1;
+}
+
+void WiFiCredsScanScheduler::scanNow(bool fullSweep) {
+    _due = true;
+    _sweepDue = _sweepDue || fullSweep;
+    _period = _minPeriod;
+    _requestedChannels = 0;
+}
+
+void WiFiCredsScanScheduler::scanChannels(uint16_t channels) {
+    // Bit 0 and bits above the band would make startStep() scan the whole band or nothing
+    channels &= static_cast<uint16_t>(((1U << (WIFICREDS_MAX_CHANNEL + 1)) - 1) & ~1U);
+    if (channels != 0) {
+        _due = true;
+        _requestedChannels |= channels;
+    }
+}
+
+bool WiFiCredsScanScheduler::poll() {
+    const uint32_t now = _driver.now();
+    
+    if (_phase == WiFiCredsScanPhase::Waiting) {
+        if (!_due && static_cast<int32_t>(now - _nextScanAt) < 0) {
+            return false;
+        }
+        _due = false;
+        startScan();
+    } else if (_phase == WiFiCredsScanPhase::Scanning) {
+        const int result = _driver.scanComplete();
+        if (result == WIFICREDS_SCAN_RUNNING && now - _stepStartedAt < WIFICREDS_SCAN_TIMEOUT) {
+            return false;
+        }
+        if (result < 0) {
+            // Failed or stuck
+            abortScan();
+            return false;
+        }
+        startReading(result);
+    }
+    
+    if (_phase != WiFiCredsScanPhase::Reading) {
+        return false;
+    }
+    
+    // A few results per call keep every poll() short, whatever the scan size
+    WiFiCredsScanEntry entry;
+    for (int read = 0; read < WIFICREDS_SCAN_INGEST_PER_POLL && _nextResult < _resultCount; read++) {
+        if (!_driver.scanResult(_nextResult++, entry)) {
+            continue;
+        }
+        _pendingCount = WiFiCredsScan::insert(entry, _pending, _pendingCount, WIFICREDS_SCAN_TABLE_SIZE);
+        uint16_t match;
+        if (_channels != nullptr && WiFiCreds::findSSID(entry.ssid, &match, 1) > 0) {
+            _channels->learn(entry.ssid, entry.channel);
+        }
+    }
+    
+    if (_nextResult < _resultCount) {
+        return false;
+    }
+    
+    // Directed scans visit the known channels one at a time
+    if (_scanChannels != 0) {
+        startStep();
+        return false;
+    }
+    
+    finishScan();
+    return true;
+}
+
+// ===== PRIVATE HELPER METHODS =====
+
+void WiFiCredsScanScheduler::startScan() {
+    const uint16_t known = (_channels != nullptr) ? _channels->knownChannels() : 0;
+    
+    _startedAt = _driver.now();
+    _pendingCount = 0;
+    _requested = _requestedChannels != 0;
+    if (_requested) {
+        _fullSweep = false;
+        _scanChannels = _requestedChannels;
+        _requestedChannels = 0;
+    } else {
+        _fullSweep = known == 0 || _sweepDue || _sinceSweep + 1 >= _sweepEvery;
+        _scanChannels = _fullSweep ? 0 : known;
+        if (_fullSweep && _channels != nullptr) {
+            _channels->beginSweep();
+        }
+    }
+    startStep();
+}
+
+void WiFiCredsScanScheduler::startStep() {
+    // Lowest channel first; 0 scans the whole band
+    _scanChannel = 0;
+    if (_scanChannels != 0) {
+        while ((_scanChannels & (1U << _scanChannel)) == 0) {
+            _scanChannel++;
+        }
+        _scanChannels &= static_cast<uint16_t>(~(1U << _scanChannel));
+    }
+    
+    _stepStartedAt = _driver.now();
+    if (_driver.startScan(_scanChannel)) {
+        _phase = WiFiCredsScanPhase::Scanning;
+        return;
+    }
+    
+    // No background scans in this driver: the only option is a blocking scan of the whole band
+    if (!_fullSweep) {
+        _fullSweep = true;
+        _scanChannels = 0;
+        _pendingCount = 0;
+        if (_channels != nullptr) {
+            _channels->beginSweep();
+        }
+    }
+    startReading(_driver.scanNetworks());
+}
+
+void WiFiCredsScanScheduler::startReading(int resultCount) {
+    if (resultCount < 0) {
+        abortScan();
+        return;
+    }
+    _phase = WiFiCredsScanPhase::Reading;
+    _resultCount = resultCount;
+    _nextResult = 0;
+}
+
+void WiFiCredsScanScheduler::abortScan() {
+    // A half-done sweep is not ended, so it cannot drop channels
+    _scanChannels = 0;
+    _phase = WiFiCredsScanPhase::Waiting;
+    scheduleNext();
+}
+
+void WiFiCredsScanScheduler::finishScan() {
+    _lastChanges = countChanges();
+    
+    // Halve on any change, double on none; the first scan has nothing to compare with, and a
+    // requested scan of a few channels says little about the rest of the band
+    if (_scanCount > 0 && !_requested) {
+        if (_lastChanges > 0) {
+            _period = (_period / 2 > _minPeriod) ? _period / 2 : _minPeriod;
+        } else {
+            _period = (_period < _maxPeriod / 2) ? _period * 2 : _maxPeriod;
+        }
+    }
+    
+    for (size_t i = 0; i < _pendingCount; i++) {
+        _table[i] = _pending[i];
+    }
+    _count = _pendingCount;
+    _scanCount++;
+    
+    if (_fullSweep) {
+        _sweepDue = false;
+        _sinceSweep = 0;
+    } else if (_requested) {
+        _sweepDue = _sweepDue || _pendingCount == 0;
+    } else {
+        // Nothing known on the known channels: the device may have moved, so look everywhere next time
+        _sweepDue = _pendingCount == 0;
+        _sinceSweep++;
+    }
+    if (_channels != nullptr) {
+        if (_fullSweep) {
+            _channels->endSweep();
+        }
+        _channels->save();
+    }
+    
+    _phase = WiFiCredsScanPhase::Waiting;
+    scheduleNext();
+}
+
+size_t WiFiCredsScanScheduler::countChanges() const {
+    size_t changes = 0;
+    
+    // Networks that are new or whose signal moved by more than the threshold
+    for (size_t i = 0; i < _pendingCount; i++) {
+        size_t j = 0;
+        while (j < _count && !sameNetwork(_pending[i], _table[j])) {
+            j++;
+        }
+        const int delta = (j < _count) ? _pending[i].rssi - _table[j].rssi : 0;
+        if (j == _count || delta >= WIFICREDS_SCAN_RSSI_CHANGE || -delta >= WIFICREDS_SCAN_RSSI_CHANGE) {
+            changes++;
+        }
+    }
+    
+    // Networks that disappeared
+    for (size_t j = 0; j < _count; j++) {
+        size_t i = 0;
+        while (i < _pendingCount && !sameNetwork(_pending[i], _table[j])) {
+            i++;
+        }
+        if (i == _pendingCount) {
+            changes++;
+        }
+    }
+    
+    return changes;
+}
+
+void WiFiCredsScanScheduler::scheduleNext() {
+    _nextScanAt = _driver.now() + _period;
+}
\ No newline at end of file
@@ -0,0 +1,267 @@
+/**
+ * @file WiFiCredsScanScheduler.h
+ * @brief Background scans feeding a ranked table of known networks
+ * @author Rithik Krisna M
+ * @version 1.0.4
+ * @date 2025
+ *
+ * A blocking scan stalls loop() for 2-4 seconds. WiFiCredsScanScheduler
+ * starts background scans through WiFiCredsDriver::startScan() (such as
+ * scanNetworks(true) on the ESP cores) and only checks on them from poll().
+ * Finished results are read a few per poll() call and joined against the
+ * credential table (WiFiCredsScan), so no single call does much work.
+ *
+ * The known-network table is bounded (WIFICREDS_SCAN_TABLE_SIZE entries),
+ * sorted by RSSI, and replaced as a whole when a scan has been read
+ * completely. Readers never see a half-read scan.
+ *
+ * The scan period adapts to how much consecutive scans differ. A network
+ * that appeared, disappeared or moved by WIFICREDS_SCAN_RSSI_CHANGE dB or
+ * more counts as a change. The period is halved after a scan with changes
+ * (the device is moving, or access points come and go) and doubled after a
+ * scan without, within the range set with setPeriodRange().
+ *
+ * With a WiFiCredsChannelMap, the scheduler learns on which channels the
+ * known networks are and scans only those, one channel per background
+ * scan. A full sweep of the band runs every WIFICREDS_SCAN_FULL_SWEEP_EVERY
+ * scans, while the map is still empty, and after a directed scan that
+ * found none of the known networks. The map is saved after a scan that
+ * changed it.
+ *
+ * @note Drivers without background scans fall back to the blocking scanNetworks()
+ */
+
+#ifndef WIFICREDS_SCAN_SCHEDULER_H
+#define WIFICREDS_SCAN_SCHEDULER_H
+
+#include "WiFiCreds.h"
+#include "WiFiCredsChannelMap.h"
+#include "WiFiCredsScan.h"
+
+/**
+ * @def WIFICREDS_SCAN_TABLE_SIZE
+ * @brief Maximum number of known networks kept from a scan, strongest first
+ */
+#ifndef WIFICREDS_SCAN_TABLE_SIZE
+#define WIFICREDS_SCAN_TABLE_SIZE 8
+#endif
+
+/**
+ * @def WIFICREDS_SCAN_INGEST_PER_POLL
+ * @brief Number of scan results read per poll() call
+ */
+#ifndef WIFICREDS_SCAN_INGEST_PER_POLL
+#define WIFICREDS_SCAN_INGEST_PER_POLL 4
+#endif
+
+/// Default shortest scan period in milliseconds
+#ifndef WIFICREDS_SCAN_MIN_PERIOD
+#define WIFICREDS_SCAN_MIN_PERIOD 10000UL
+#endif
+
+/// Default longest scan period in milliseconds
+#ifndef WIFICREDS_SCAN_MAX_PERIOD
+#define WIFICREDS_SCAN_MAX_PERIOD 160000UL
+#endif
+
+/// A background scan still running after this many milliseconds is given up
+#ifndef WIFICREDS_SCAN_TIMEOUT
+#define WIFICREDS_SCAN_TIMEOUT 15000UL
+#endif
+
+/// RSSI change in dB at which a network counts as changed between two scans
+#ifndef WIFICREDS_SCAN_RSSI_CHANGE
+#define WIFICREDS_SCAN_RSSI_CHANGE 6
+#endif
+
+/// With a channel map, every this many scans is a full sweep of the band
+#ifndef WIFICREDS_SCAN_FULL_SWEEP_EVERY
+#define WIFICREDS_SCAN_FULL_SWEEP_EVERY 8
+#endif
+
+/**
+ * @enum WiFiCredsScanPhase
+ * @brief What WiFiCredsScanScheduler is doing
+ */
+enum class WiFiCredsScanPhase : uint8_t {
+    Waiting,  ///< Waiting for the next scan to be due
+    Scanning, ///< A background scan is running
+    Reading   ///< Reading the results of a finished scan
+};
+
+/**
+ * @class WiFiCredsScanScheduler
+ * @brief Non-blocking periodic scans with an adaptive period
+ *
+ * @code
+ * WiFiCredsArduinoDriver driver;
+ * WiFiCredsScanScheduler scanner(driver);
+ *
+ * void loop() {
+ *     if (scanner.poll()) {
+ *         const WiFiCredsCandidate* best = scanner.best();
+ *         // best is the strongest known network, or nullptr
+ *     }
+ *     // ... the rest of loop() keeps running while the radio scans
+ * }
+ * @endcode
+ */
+class WiFiCredsScanScheduler {
+public:
+    /**
+     * @brief Create a scheduler; the first scan starts on the first poll()
+     * @param driver Driver that runs the scans
+     */
+    explicit WiFiCredsScanScheduler(WiFiCredsDriver& driver);
+
+    /**
+     * @brief Create a scheduler that scans only the channels known networks were seen on
+     * @param driver Driver that runs the scans
+     * @param channels Map that is learned from every scan; call its begin() before the first poll()
+     */
+    WiFiCredsScanScheduler(WiFiCredsDriver& driver, WiFiCredsChannelMap& channels);
+
+    /**
+     * @brief Set the range the scan period adapts within
+     *
+     * The current period is clamped to the new range.
+     *
+     * @param minPeriod Shortest period in milliseconds, used while results change
+     * @param maxPeriod Longest period in milliseconds, approached while results are stable
+     */
+    void setPeriodRange(uint32_t minPeriod, uint32_t maxPeriod);
+
+    /**
+     * @brief Set how often a full sweep runs when a channel map is used
+     * @param scans Every this many scans is a full sweep (1 makes every scan one)
+     */
+    void setFullSweepInterval(uint8_t scans);
+
+    /**
+     * @brief Scan at the next poll() instead of waiting for the period to pass
+     *
+     * The period also drops to its minimum. Use it when the application
+     * knows the situation has changed, for example after losing the link.
+     *
+     * @param fullSweep true to scan the whole band even if a channel map is used
+     */
+    void scanNow(bool fullSweep = false);
+    
+    /**
+     * @brief Scan only the given channels at the next poll(), with or without a channel map
+     *
+     * Takes one dwell per channel instead of a sweep of the band, for callers
+     * that know where the networks they care about are (WiFiCredsRoaming
+     * rescans the channels of its roaming targets this way). The table then
+     * holds only the networks on these channels. The scan period and the
+     * schedule of full sweeps are left as they are.
+     *
+     * @param channels Bit n set scans channel n (1 to WIFICREDS_MAX_CHANNEL); 0 does nothing
+     */
+    void scanChannels(uint16_t channels);
+
+    /**
+     * @brief Start, check on or read the current scan; returns quickly
+     * @return true if a scan was completed in this call and the table was replaced
+     */
+    bool poll();
+
+    /// Number of networks in the table
+    size_t count() const { return _count; }
+
+    /**
+     * @brief Access the table of the last completed scan
+     * @param rank 0 is the strongest network
+     * @return const WiFiCredsCandidate* The entry, or nullptr if @p rank is invalid
+     */
+    const WiFiCredsCandidate* candidate(size_t rank) const {
+        return (rank < _count) ? &_table[rank] : nullptr;
+    }
+
+    /// The strongest known network of the last completed scan, or nullptr if none was in range
+    const WiFiCredsCandidate* best() const { return candidate(0); }
+
+    /// What the scheduler is doing
+    WiFiCredsScanPhase phase() const { return _phase; }
+
+    /// Current scan period in milliseconds
+    uint32_t period() const { return _period; }
+
+    /// Number of table entries that changed in the last completed scan
+    size_t lastChanges() const { return _lastChanges; }
+
+    /// Number of completed scans
+    uint32_t scanCount() const { return _scanCount; }
+
+    /// Driver time when the last completed scan was started
+    uint32_t lastScanAt() const { return _startedAt; }
+
+    /// true if the current or last scan covers the whole band
+    bool fullSweep() const { return _fullSweep; }
+
+private:
+    WiFiCredsDriver& _driver;
+    WiFiCredsChannelMap* _channels; ///< nullptr without a channel map
+    WiFiCredsScanPhase _phase;
+    uint32_t _minPeriod;
+    uint32_t _maxPeriod;
+    uint32_t _period;
+    uint32_t _nextScanAt;
+    uint32_t _startedAt;        ///< When the current or last scan was started
+    bool _due;                  ///< Scan at the next poll(), whatever the time
+    uint16_t _requestedChannels; ///< Channels asked for with scanChannels(), 0 for a regular scan
+    bool _requested;            ///< The current or last scan was asked for with scanChannels()
+    uint32_t _stepStartedAt;    ///< When the running background scan was started
+    uint16_t _scanChannels;     ///< Channels of the current directed scan still to be scanned
+    uint8_t _scanChannel;       ///< Channel being scanned, 0 for the whole band
+    bool _fullSweep;            ///< The current or last scan covers the whole band
+    bool _sweepDue;             ///< The next scan is a full sweep
+    uint8_t _sweepEvery;
+    uint8_t _sinceSweep;        ///< Directed scans since the last full sweep
+
+    WiFiCredsCandidate _table[WIFICREDS_SCAN_TABLE_SIZE];   ///< Last completed scan
+    size_t _count;
+    WiFiCredsCandidate _pending[WIFICREDS_SCAN_TABLE_SIZE]; ///< Scan being read
+    size_t _pendingCount;
+    int _resultCount;           ///< Results of the scan being read
+    int _nextResult;            ///< Next result to read
+    size_t _lastChanges;
+    uint32_t _scanCount;
+
+    /**
+     * @brief Start a full sweep or a directed scan of the known channels
+     */
+    void startScan();
+
+    /**
+     * @brief Start the background scan of the next channel, or block if the driver cannot
+     */
+    void startStep();
+
+    /**
+     * @brief Begin reading a finished scan
+     */
+    void startReading(int resultCount);
+
+    /**
+     * @brief Give up the current scan; the table keeps the last good scan
+     */
+    void abortScan();
+
+    /**
+     * @brief Publish the pending table, adapt the period and schedule the next scan
+     */
+    void finishScan();
+
+    /**
+     * @brief Count the entries that differ between the pending and the current table
+     */
+    size_t countChanges() const;
+
+    /**
+     * @brief Wait a full period before the next attempt
+     */
+    void scheduleNext();
+};
+
+#endif // WIFICREDS_SCAN_SCHEDULER_H
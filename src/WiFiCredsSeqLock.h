@@ -0,0 +1,191 @@
+/**
+ * @file WiFiCredsSeqLock.h
+ * @brief Sequence lock for lock-free reads of data with a single writer
+ * @author Rithik Krisna M
+ * @version 1.0.4
+ * @date 2025
+ *
+ * A sequence lock lets any number of readers run without taking a lock
+ * while one writer updates shared data. The writer makes the sequence
+ * number odd before it changes anything and even again afterwards. A
+ * reader notes the sequence number, copies what it needs and checks the
+ * number again; if a write started or finished in between, the copy may be
+ * torn and the reader simply repeats it. Readers never block the writer.
+ * Everything the readers load is kept in WiFiCredsSeqValue atomics.
+ *
+ * @note Internal header, used by WiFiCredsStore
+ * @note On AVR and ESP8266, which run a single task, the lock compiles to a plain counter
+ */
+
+#ifndef WIFICREDS_SEQLOCK_H
+#define WIFICREDS_SEQLOCK_H
+
+#include "WiFiCreds.h"
+
+#if defined(__AVR__) || defined(ESP8266)
+#define WIFICREDS_HAS_SEQLOCK 0
+#else
+#define WIFICREDS_HAS_SEQLOCK 1
+#endif
+
+/**
+ * @def WIFICREDS_SEQLOCK_SPINS
+ * @brief Busy checks of an odd sequence number before a reader yields
+ *
+ * A reader that preempted the writer on the same core would otherwise spin
+ * until its time slice ends; yielding lets the writer finish.
+ */
+#ifndef WIFICREDS_SEQLOCK_SPINS
+#define WIFICREDS_SEQLOCK_SPINS 64
+#endif
+
+#if WIFICREDS_HAS_SEQLOCK
+
+#include <atomic>
+#if !defined(ARDUINO)
+#include <thread>
+#endif
+
+// ThreadSanitizer does not model fences. Under it the guarded values use
+// acquire loads and release stores instead, which order the same accesses.
+#if defined(__SANITIZE_THREAD__)
+#define WIFICREDS_SEQLOCK_FENCES 0
+#elif defined(__has_feature)
+#if __has_feature(thread_sanitizer)
+#define WIFICREDS_SEQLOCK_FENCES 0
+#endif
+#endif
+#ifndef WIFICREDS_SEQLOCK_FENCES
+#define WIFICREDS_SEQLOCK_FENCES 1
+#endif
+
+/**
+ * @class WiFiCredsSeqLock
+ * @brief Sequence number guarding data with one writer and lock-free readers
+ *
+ * Writers must be serialized by the caller. Only loads and stores are used,
+ * no read-modify-write, so it also works on cores without atomic
+ * read-modify-write instructions such as the RP2040.
+ *
+ * @code
+ * uint32_t version;
+ * do {
+ *     version = lock.readBegin();
+ *     copy = shared;
+ * } while (lock.readRetry(version));
+ * @endcode
+ */
+class WiFiCredsSeqLock {
+public:
+    WiFiCredsSeqLock() : _sequence(0) {}
+
+    /**
+     * @brief Start a read, waiting while a write is in progress
+     * @return uint32_t Version to pass to readRetry()
+     */
+    uint32_t readBegin() const {
+        uint8_t spins = 0;
+        for (;;) {
+            const uint32_t version = _sequence.load(std::memory_order_acquire);
+            if ((version & 1) == 0) {
+                return version;
+            }
+            if (++spins >= WIFICREDS_SEQLOCK_SPINS) {
+                spins = 0;
+                relax();
+            }
+        }
+    }
+
+    /**
+     * @brief Finish a read
+     * @param version Value returned by readBegin()
+     * @return true if a write overlapped and the read must be repeated
+     */
+    bool readRetry(uint32_t version) const {
+#if WIFICREDS_SEQLOCK_FENCES
+        // Orders the data reads before the second sequence load
+        std::atomic_thread_fence(std::memory_order_acquire);
+#endif
+        return _sequence.load(std::memory_order_relaxed) != version;
+    }
+
+    /// Start a write; readers wait or retry until writeEnd()
+    void writeBegin() {
+        _sequence.store(_sequence.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+#if WIFICREDS_SEQLOCK_FENCES
+        // Orders the odd sequence number before the data writes
+        std::atomic_thread_fence(std::memory_order_release);
+#endif
+    }
+
+    /// Publish the write
+    void writeEnd() {
+        _sequence.store(_sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+private:
+    std::atomic<uint32_t> _sequence;
+
+    static void relax() {
+#if defined(ARDUINO)
+        delay(1);  // On FreeRTOS cores this lets lower-priority tasks, including the writer, run
+#else
+        std::this_thread::yield();
+#endif
+    }
+};
+
+/**
+ * @class WiFiCredsSeqValue
+ * @brief A value that readers load while the writer may store it
+ *
+ * Data guarded by a WiFiCredsSeqLock is read while it changes; the retry
+ * only discards the result. For plain variables that overlap is a data
+ * race, so guarded data is kept in atomics. Relaxed order is enough, the
+ * fences of the lock order these accesses, and plain loads and stores are
+ * all it compiles to.
+ */
+template <typename T>
+class WiFiCredsSeqValue {
+public:
+    WiFiCredsSeqValue() : _value(T()) {}
+
+#if WIFICREDS_SEQLOCK_FENCES
+    T load() const { return _value.load(std::memory_order_relaxed); }
+    void store(T value) { _value.store(value, std::memory_order_relaxed); }
+#else
+    T load() const { return _value.load(std::memory_order_acquire); }
+    void store(T value) { _value.store(value, std::memory_order_release); }
+#endif
+
+private:
+    std::atomic<T> _value;
+};
+
+#else
+
+// Single task: a read can never overlap a write
+class WiFiCredsSeqLock {
+public:
+    uint32_t readBegin() const { return 0; }
+    bool readRetry(uint32_t) const { return false; }
+    void writeBegin() {}
+    void writeEnd() {}
+};
+
+template <typename T>
+class WiFiCredsSeqValue {
+public:
+    WiFiCredsSeqValue() : _value(T()) {}
+
+    T load() const { return _value; }
+    void store(T value) { _value = value; }
+
+private:
+    T _value;
+};
+
+#endif // WIFICREDS_HAS_SEQLOCK
+
+#endif // WIFICREDS_SEQLOCK_H
@@ -0,0 +1,439 @@
+/**
+ * @file WiFiCredsSimDriver.h
+ * @brief Deterministic simulated Wi-Fi driver for host builds
+ * @author Rithik Krisna M
+ * @version 1.0.4
+ * @date 2025
+ *
+ * WiFiCredsSimDriver implements WiFiCredsDriver against a scripted list of
+ * access points and a virtual clock. Connect latency, RSSI, wrong passwords,
+ * random connect failures and APs going down can all be scripted, so
+ * connection-selection logic can be exercised and timed on a Linux machine
+ * without any hardware. Given the same seed and script, every run produces
+ * the same sequence of events.
+ *
+ * A connect without a channel first searches the band (13 scan dwells),
+ * and one without a static IP configuration waits for DHCP, so directed
+ * reconnects are measurably cheaper than a cold connect.
+ *
+ * Like a WPA2 access point, a scripted AP accepts either its passphrase or
+ * the 64-hex PSK derived from it, which is what WiFiCredsConnection sends
+ * for sets with a precomputed PMK.
+ *
+ * @note Header-only and heap-free; it is not compiled unless included
+ */
+
+#ifndef WIFICREDS_SIM_DRIVER_H
+#define WIFICREDS_SIM_DRIVER_H
+
+#include "WiFiCredsDriver.h"
+#include "WiFiCredsPMK.h"
+#include <string.h>
+
+/// Maximum number of scripted access points
+#ifndef WIFICREDS_SIM_MAX_APS
+#define WIFICREDS_SIM_MAX_APS 32
+#endif
+
+/**
+ * @struct WiFiCredsSimAP
+ * @brief A scripted access point
+ */
+struct WiFiCredsSimAP {
+    const char* ssid;          ///< Network SSID
+    const char* password;      ///< Password the AP accepts (nullptr or "" for an open network)
+    uint8_t bssid[6];          ///< Access point MAC address
+    uint8_t channel;           ///< Wi-Fi channel (1-13)
+    int8_t rssi;               ///< Signal strength in dBm as seen by the device
+    uint32_t connectLatencyMs; ///< Association time, excluding channel search and DHCP
+    uint8_t failPercent;       ///< Chance (0-100) that a connect attempt is rejected
+    bool up;                   ///< false while the AP is powered off
+};
+
+/**
+ * @class WiFiCredsSimDriver
+ * @brief Simulated driver with scripted access points and a virtual clock
+ *
+ * Time only moves when advance() is called or when a blocking scan runs,
+ * which makes the cost of every driver call measurable in virtual time.
+ * A background scan (startScan()) finishes once the clock has moved past
+ * its duration, without stalling the caller. A scan of one channel takes
+ * one dwell and reports only the APs on that channel.
+ */
+class WiFiCredsSimDriver : public WiFiCredsDriver {
+public:
+    /**
+     * @brief Create a simulated driver
+     * @param seed Seed for the deterministic failure generator (must not be 0)
+     */
+    explicit WiFiCredsSimDriver(uint32_t seed = 1)
+        : _apCount(0), _now(0), _random(seed != 0 ? seed : 1), _scanDwellMs(120), _noSsidLatencyMs(2000),
+          _dhcpLatencyMs(0), _linkLossRssi(-128), _staticIP(false),
+          _status(WiFiCredsLinkStatus::Idle), _target(-1), _pendingStatus(WiFiCredsLinkStatus::Idle),
+          _pendingAt(0), _scanCount(0), _scanRunning(false), _scanDoneAt(0),
+          _scanResult(WIFICREDS_SCAN_FAILED), _scanChannel(0), _beginCalls(0), _statusCalls(0), _scanCalls(0),
+          _scanTimeMs(0) {
+        memset(_pskFor, 0, sizeof(_pskFor));
+    }
+
+    // ===== SCRIPTING =====
+
+    /**
+     * @brief Add an access point to the simulated environment
+     * @param ap The access point to add
+     * @return true if added, false if WIFICREDS_SIM_MAX_APS is reached
+     */
+    bool addAP(const WiFiCredsSimAP& ap) {
+        if (_apCount >= WIFICREDS_SIM_MAX_APS) {
+            return false;
+        }
+        _aps[_apCount++] = ap;
+        return true;
+    }
+
+    /**
+     * @brief Access a scripted access point to change it during a run
+     * @param index Index in the order the APs were added
+     * @return WiFiCredsSimAP* The access point, or nullptr if index is invalid
+     */
+    WiFiCredsSimAP* ap(size_t index) {
+        return (index < _apCount) ? &_aps[index] : nullptr;
+    }
+
+    /// Number of scripted access points
+    size_t apCount() const { return _apCount; }
+
+    /**
+     * @brief Set how long a scan spends on each channel
+     * @param ms Dwell time per channel in milliseconds (a full scan visits 13 channels)
+     */
+    void setScanDwell(uint32_t ms) { _scanDwellMs = ms; }
+
+    /**
+     * @brief Set how long begin() takes to report a missing network
+     * @param ms Time in milliseconds until WiFiCredsLinkStatus::NoSsid
+     */
+    void setNoSsidLatency(uint32_t ms) { _noSsidLatencyMs = ms; }
+
+    /**
+     * @brief Set how long DHCP takes after association
+     * @param ms DHCP time in milliseconds (skipped with a static IP configuration)
+     */
+    void setDhcpLatency(uint32_t ms) { _dhcpLatencyMs = ms; }
+
+    /**
+     * @brief Set the signal strength below which an established link is lost
+     * @param dBm RSSI floor; the default of -128 never drops a link
+     */
+    void setLinkLossRssi(int8_t dBm) { _linkLossRssi = dBm; }
+
+    /**
+     * @brief Make the connect attempt in progress fail, as an AP too busy to admit it does
+     *
+     * For load models that can only decide once they have seen every attempt
+     * of a time step; failPercent decides when begin() is called.
+     *
+     * @return true if an attempt that would have succeeded was rejected
+     */
+    bool rejectAttempt() {
+        if (_status != WiFiCredsLinkStatus::Connecting || _pendingStatus != WiFiCredsLinkStatus::Connected) {
+            return false;
+        }
+        _pendingStatus = WiFiCredsLinkStatus::ConnectFailed;
+        return true;
+    }
+
+    // ===== VIRTUAL CLOCK =====
+
+    /**
+     * @brief Move the virtual clock forward
+     * @param ms Milliseconds to advance
+     */
+    void advance(uint32_t ms) {
+        _now += ms;
+        update();
+    }
+
+    // ===== STATISTICS =====
+
+    uint32_t beginCalls() const { return _beginCalls; }   ///< Number of begin() calls
+    uint32_t statusCalls() const { return _statusCalls; } ///< Number of status() calls
+    uint32_t scanCalls() const { return _scanCalls; }     ///< Number of scans started
+    uint32_t scanTimeMs() const { return _scanTimeMs; }   ///< Radio time spent scanning in milliseconds
+
+    /**
+     * @brief Index of the AP currently connected or being connected to
+     * @return int AP index, or -1 if none
+     */
+    int currentAP() const { return _target; }
+
+    // ===== WiFiCredsDriver =====
+
+    void begin(const char* ssid, const char* password, uint8_t channel = 0, const uint8_t* bssid = nullptr) override {
+        _beginCalls++;
+        _target = -1;
+
+        // Like the real stacks, pick the strongest matching AP
+        for (size_t i = 0; i < _apCount; i++) {
+            const WiFiCredsSimAP& candidate = _aps[i];
+            if (!candidate.up || ssid == nullptr || strcmp(candidate.ssid, ssid) != 0) {
+                continue;
+            }
+            if (channel != 0 && candidate.channel != channel) {
+                continue;
+            }
+            if (bssid != nullptr && memcmp(candidate.bssid, bssid, sizeof(candidate.bssid)) != 0) {
+                continue;
+            }
+            if (_target < 0 || candidate.rssi > _aps[_target].rssi) {
+                _target = static_cast<int>(i);
+            }
+        }
+
+        _status = WiFiCredsLinkStatus::Connecting;
+        if (_target < 0) {
+            _pendingStatus = WiFiCredsLinkStatus::NoSsid;
+            _pendingAt = _now + _noSsidLatencyMs;
+            return;
+        }
+
+        const WiFiCredsSimAP& chosen = _aps[_target];
+        const bool passwordOk = passwordsMatch(static_cast<size_t>(_target), password);
+        const bool rejected = chosen.failPercent > 0 && (nextRandom() % 100) < chosen.failPercent;
+        const bool success = passwordOk && !rejected;
+        _pendingStatus = success ? WiFiCredsLinkStatus::Connected : WiFiCredsLinkStatus::ConnectFailed;
+
+        // Channel search and DHCP are skipped by directed, statically configured connects
+        _pendingAt = _now + chosen.connectLatencyMs + ((channel == 0) ? _scanDwellMs * 13 : _scanDwellMs);
+        if (success && !_staticIP) {
+            _pendingAt += _dhcpLatencyMs;
+        }
+    }
+
+    WiFiCredsLinkStatus status() override {
+        _statusCalls++;
+        update();
+        return _status;
+    }
+
+    void disconnect() override {
+        _status = WiFiCredsLinkStatus::Idle;
+        _pendingStatus = WiFiCredsLinkStatus::Idle;
+        _target = -1;
+    }
+
+    int scanNetworks() override {
+        _scanCalls++;
+        _scanRunning = false;
+        // A blocking scan costs its full duration in virtual time
+        _scanChannel = 0;
+        _scanTimeMs += _scanDwellMs * 13;
+        advance(_scanDwellMs * 13);
+        takeScan();
+        _scanResult = static_cast<int>(_scanCount);
+        return _scanResult;
+    }
+
+    bool startScan(uint8_t channel = 0) override {
+        if (!_scanRunning) {
+            _scanCalls++;
+            _scanRunning = true;
+            _scanChannel = channel;
+            _scanDoneAt = _now + ((channel == 0) ? _scanDwellMs * 13 : _scanDwellMs);
+            _scanTimeMs += _scanDoneAt - _now;
+        }
+        return true;
+    }
+
+    int scanComplete() override {
+        update();
+        if (_scanRunning) {
+            return WIFICREDS_SCAN_RUNNING;
+        }
+        return _scanResult;
+    }
+
+    bool scanResult(int index, WiFiCredsScanEntry& entry) override {
+        if (index < 0 || static_cast<size_t>(index) >= _scanCount) {
+            return false;
+        }
+        const WiFiCredsSimAP& source = _aps[_scanIndex[index]];
+        strncpy(entry.ssid, source.ssid, WIFICREDS_SSID_MAX_LENGTH);
+        entry.ssid[WIFICREDS_SSID_MAX_LENGTH] = '\0';
+        memcpy(entry.bssid, source.bssid, sizeof(entry.bssid));
+        entry.channel = source.channel;
+        entry.rssi = source.rssi;
+        entry.open = source.password == nullptr || source.password[0] == '\0';
+        return true;
+    }
+
+    bool config(uint32_t localIP, uint32_t gateway, uint32_t subnet, uint32_t dns) override {
+        (void)gateway;
+        (void)subnet;
+        (void)dns;
+        _staticIP = localIP != 0;
+        return true;
+    }
+
+    int8_t rssi() override {
+        update();
+        return (_status == WiFiCredsLinkStatus::Connected) ? _aps[_target].rssi : 0;
+    }
+
+    bool bssid(uint8_t bssid[6]) override {
+        update();
+        if (_status != WiFiCredsLinkStatus::Connected) {
+            return false;
+        }
+        memcpy(bssid, _aps[_target].bssid, sizeof(_aps[_target].bssid));
+        return true;
+    }
+
+    /// Current virtual time in milliseconds
+    uint32_t now() override { return _now; }
+
+private:
+    WiFiCredsSimAP _aps[WIFICREDS_SIM_MAX_APS];
+    size_t _apCount;
+    uint32_t _now;
+    uint32_t _random;
+    uint32_t _scanDwellMs;
+    uint32_t _noSsidLatencyMs;
+    uint32_t _dhcpLatencyMs;
+    int8_t _linkLossRssi;
+    bool _staticIP;
+
+    WiFiCredsLinkStatus _status;
+    int _target;
+    WiFiCredsLinkStatus _pendingStatus;
+    uint32_t _pendingAt;
+
+    uint8_t _scanIndex[WIFICREDS_SIM_MAX_APS];
+    size_t _scanCount;
+    bool _scanRunning;     ///< A background scan was started and has not finished
+    uint32_t _scanDoneAt;  ///< When the background scan finishes
+    int _scanResult;       ///< Value scanComplete() reports when no scan is running
+    uint8_t _scanChannel;  ///< Channel of the current or last scan, 0 for the whole band
+
+    uint32_t _beginCalls;
+    uint32_t _statusCalls;
+    uint32_t _scanCalls;
+    uint32_t _scanTimeMs;
+
+    char _psk[WIFICREDS_SIM_MAX_APS][WIFICREDS_PSK_HEX_SIZE]; ///< Hex PSK of each AP, derived on first use
+    const char* _pskFor[WIFICREDS_SIM_MAX_APS];              ///< Password _psk was derived from
+
+    /**
+     * @brief Apply pending results and scripted AP changes at the current time
+     */
+    void update() {
+        if (_status == WiFiCredsLinkStatus::Connecting && static_cast<int32_t>(_now - _pendingAt) >= 0) {
+            _status = _pendingStatus;
+        }
+        // A background scan sees the APs as they are when it finishes
+        if (_scanRunning && static_cast<int32_t>(_now - _scanDoneAt) >= 0) {
+            _scanRunning = false;
+            takeScan();
+            _scanResult = static_cast<int>(_scanCount);
+        }
+        // An AP that went down drops an established or pending connection
+        if (_target >= 0 && !_aps[_target].up &&
+            (_status == WiFiCredsLinkStatus::Connected || _status == WiFiCredsLinkStatus::Connecting)) {
+            _status = WiFiCredsLinkStatus::Disconnected;
+            _target = -1;
+        }
+        // So does a signal too weak to hear the AP's beacons
+        if (_target >= 0 && _status == WiFiCredsLinkStatus::Connected && _aps[_target].rssi < _linkLossRssi) {
+            _status = WiFiCredsLinkStatus::Disconnected;
+            _target = -1;
+        }
+    }
+
+    /// Record the APs that are up, on the scanned channel, as the scan result
+    void takeScan() {
+        _scanCount = 0;
+        for (size_t i = 0; i < _apCount; i++) {
+            if (_aps[i].up && (_scanChannel == 0 || _aps[i].channel == _scanChannel)) {
+                _scanIndex[_scanCount++] = static_cast<uint8_t>(i);
+            }
+        }
+    }
+
+    /// xorshift32, deterministic for a given seed
+    uint32_t nextRandom() {
+        _random ^= _random << 13;
+        _random ^= _random >> 17;
+        _random ^= _random << 5;
+        return _random;
+    }
+
+    /**
+     * @brief Check a password given to begin() against the one an AP accepts
+     * @param index AP to connect to
+     * @param given Passphrase or 64-hex PSK from begin()
+     */
+    bool passwordsMatch(size_t index, const char* given) {
+        const WiFiCredsSimAP& ap = _aps[index];
+        const bool expectOpen = ap.password == nullptr || ap.password[0] == '\0';
+        const bool givenOpen = given == nullptr || given[0] == '\0';
+        if (expectOpen || givenOpen) {
+            return expectOpen == givenOpen;
+        }
+        if (strcmp(ap.password, given) == 0) {
+            return true;
+        }
+
+        // Compare as PSKs; the AP's is derived once, as PBKDF2 costs a millisecond even here
+        if (_pskFor[index] != ap.password) {
+            _pskFor[index] = toPsk(ap.ssid, ap.password, _psk[index]) ? ap.password : nullptr;
+        }
+        char givenPsk[WIFICREDS_PSK_HEX_SIZE];
+        return _pskFor[index] != nullptr && toPsk(ap.ssid, given, givenPsk) && hexEqual(_psk[index], givenPsk);
+    }
+
+    /**
+     * @brief Turn a passphrase (8-63 characters) or a 64-hex PSK into a hex PSK
+     * @return false if @p password is neither
+     */
+    static bool toPsk(const char* ssid, const char* password, char psk[WIFICREDS_PSK_HEX_SIZE]) {
+        const size_t length = strlen(password);
+        if (length == WIFICREDS_PSK_HEX_SIZE - 1) {
+            for (size_t i = 0; i < length; i++) {
+                if (hexValue(password[i]) < 0) {
+                    return false;
+                }
+            }
+            memcpy(psk, password, WIFICREDS_PSK_HEX_SIZE);
+            return true;
+        }
+        uint8_t pmk[WIFICREDS_PMK_LENGTH];
+        if (!WiFiCredsPMK::derive(ssid, strlen(ssid), password, length, pmk)) {
+            return false;
+        }
+        WiFiCredsPMK::toHex(pmk, psk);
+        return true;
+    }
+
+    /// Case-insensitive comparison of two hex PSKs
+    static bool hexEqual(const char* a, const char* b) {
+        for (size_t i = 0; i < WIFICREDS_PSK_HEX_SIZE - 1; i++) {
+            if (hexValue(a[i]) != hexValue(b[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// Value of a hex digit, or -1
+    static int hexValue(char c) {
+        if (c >= '0' && c <= '9') {
+            return c - '0';
+        }
+        if (c >= 'a' && c <= 'f') {
+            return c - 'a' + 10;
+        }
+        return (c >= 'A' && c <= 'F') ? c - 'A' + 10 : -1;
+    }
+};
+
+#endif // WIFICREDS_SIM_DRIVER_H
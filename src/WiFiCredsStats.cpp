@@ -0,0 +1,138 @@
+/**
+ * @file WiFiCredsStats.cpp
+ * @brief Implementation of the per-credential connect statistics
+ * @author Rithik Krisna M
+ * @version 1.0.4
+ * @date 2025
+ */
+
+#include "WiFiCredsStats.h"
+#include "WiFiCredsTable.h" // Only the compile-time entry count is used here
+#include <string.h>     // Required for memset
+
+namespace {
+
+// One record per credential set, without the terminator
+constexpr size_t CREDENTIAL_COUNT = WiFiCredsSetCount(CREDENTIAL_SETS);
+
+// EWMA weight of a new sample is 1 / 2^EWMA_SHIFT
+const uint8_t EWMA_SHIFT = 3;
+
+WiFiCredsStatsRecord records[CREDENTIAL_COUNT > 0 ? CREDENTIAL_COUNT : 1];
+
+/**
+ * @brief Integer square root (floor)
+ */
+uint32_t isqrt(uint32_t value) {
+    uint32_t root = 0;
+    uint32_t bit = 1UL << 30;
+
+    while (bit > value) {
+        bit >>= 2;
+    }
+    while (bit != 0) {
+        if (value >= root + bit) {
+            value -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return root;
+}
+
+void addLatency(WiFiCredsStatsRecord& record, uint32_t durationMs) {
+    const int32_t sample = static_cast<int32_t>((durationMs < 0xFFFFUL) ? durationMs : 0xFFFFUL);
+
+    if (record.samples == 0) {
+        record.meanMs = static_cast<uint16_t>(sample);
+        record.varianceMs2 = 0;
+    } else {
+        // Incremental EWMA of mean and variance (Finch, 2009)
+        const int32_t diff = sample - static_cast<int32_t>(record.meanMs);
+        const int32_t step = diff / (1 << EWMA_SHIFT);
+        const uint64_t spread = static_cast<uint64_t>(record.varianceMs2) +
+                                ((static_cast<uint64_t>(static_cast<int64_t>(diff) * diff)) >> EWMA_SHIFT);
+        record.meanMs = static_cast<uint16_t>(record.meanMs + step);
+        record.varianceMs2 = static_cast<uint32_t>(spread - (spread >> EWMA_SHIFT));
+    }
+
+    if (record.samples < 0xFF) {
+        record.samples++;
+    }
+}
+
+void addOutcome(WiFiCredsStatsRecord& record, bool failed) {
+    // Failures round up, so a set that keeps failing reaches 255 as successes reach 0
+    const uint16_t target = failed ? 0xFF + (1 << EWMA_SHIFT) - 1 : 0;
+    record.failureRate = static_cast<uint8_t>((record.failureRate * ((1 << EWMA_SHIFT) - 1) + target) >> EWMA_SHIFT);
+}
+
+} // namespace
+
+void WiFiCredsStats::recordSuccess(size_t credentialIndex, uint32_t durationMs) {
+    if (credentialIndex >= CREDENTIAL_COUNT) {
+        return;
+    }
+    addLatency(records[credentialIndex], durationMs);
+    addOutcome(records[credentialIndex], false);
+}
+
+void WiFiCredsStats::recordFailure(size_t credentialIndex) {
+    if (credentialIndex >= CREDENTIAL_COUNT) {
+        return;
+    }
+    addOutcome(records[credentialIndex], true);
+}
+
+void WiFiCredsStats::recordTimeout(size_t credentialIndex, uint32_t elapsedMs) {
+    if (credentialIndex >= CREDENTIAL_COUNT) {
+        return;
+    }
+    // The real latency is unknown but at least elapsedMs; only learned timeouts need correcting
+    if (records[credentialIndex].samples > 0) {
+        addLatency(records[credentialIndex], elapsedMs);
+    }
+    addOutcome(records[credentialIndex], true);
+}
+
+uint32_t WiFiCredsStats::timeout(size_t credentialIndex) {
+    if (credentialIndex >= CREDENTIAL_COUNT) {
+        return WIFICREDS_CONNECT_TIMEOUT;
+    }
+
+    const WiFiCredsStatsRecord& record = records[credentialIndex];
+    if (record.samples == 0) {
+        // Nothing learned yet: shrink the default towards WIFICREDS_STATS_FAILING_TIMEOUT as failures add up
+        const uint32_t floor = (WIFICREDS_STATS_FAILING_TIMEOUT < WIFICREDS_CONNECT_TIMEOUT)
+                                   ? WIFICREDS_STATS_FAILING_TIMEOUT : WIFICREDS_CONNECT_TIMEOUT;
+        return WIFICREDS_CONNECT_TIMEOUT - ((WIFICREDS_CONNECT_TIMEOUT - floor) * record.failureRate) / 0xFF;
+    }
+
+    uint32_t estimate;
+    if (record.samples < WIFICREDS_STATS_MIN_SAMPLES) {
+        estimate = static_cast<uint32_t>(record.meanMs) * 2;
+    } else {
+        // 2.33 standard deviations above the mean cover 99 % of a normal distribution
+        estimate = record.meanMs + (isqrt(record.varianceMs2) * 233UL) / 100;
+    }
+    estimate += WIFICREDS_STATS_TIMEOUT_MARGIN;
+
+    if (estimate < WIFICREDS_STATS_MIN_TIMEOUT) {
+        return WIFICREDS_STATS_MIN_TIMEOUT;
+    }
+    return (estimate < WIFICREDS_CONNECT_TIMEOUT) ? estimate : WIFICREDS_CONNECT_TIMEOUT;
+}
+
+bool WiFiCredsStats::get(size_t credentialIndex, WiFiCredsStatsRecord& record) {
+    if (credentialIndex >= CREDENTIAL_COUNT) {
+        return false;
+    }
+    record = records[credentialIndex];
+    return true;
+}
+
+void WiFiCredsStats::reset() {
+    memset(records, 0, sizeof(records));
+}
\ No newline at end of file
@@ -0,0 +1,155 @@
+/**
+ * @file WiFiCredsStats.h
+ * @brief Per-credential connect statistics and learned timeouts
+ * @author Rithik Krisna M
+ * @version 1.0.4
+ * @date 2025
+ *
+ * Keeps a small record per credential set: an exponentially weighted
+ * moving average (EWMA) of the connect latency, its variance and the
+ * failure rate. From these a per-network timeout is derived as roughly the
+ * 99th percentile of the latency plus a margin, so an attempt on a network
+ * that usually connects in 800 ms gives up after about 2 s instead of 30.
+ *
+ * Records live in a fixed array with one 8-byte entry per credential set,
+ * indexed by credential index. No heap is used. Statistics are kept in RAM
+ * and start empty after every reset.
+ */
+
+#ifndef WIFICREDS_STATS_H
+#define WIFICREDS_STATS_H
+
+#include "WiFiCreds.h"
+
+/**
+ * @def WIFICREDS_CONNECT_TIMEOUT
+ * @brief Default time in milliseconds before a connection attempt is abandoned
+ *
+ * Also the upper bound of a learned timeout.
+ */
+#ifndef WIFICREDS_CONNECT_TIMEOUT
+#define WIFICREDS_CONNECT_TIMEOUT 30000UL
+#endif
+
+/**
+ * @def WIFICREDS_STATS_MIN_TIMEOUT
+ * @brief Lower bound in milliseconds for a learned timeout
+ */
+#ifndef WIFICREDS_STATS_MIN_TIMEOUT
+#define WIFICREDS_STATS_MIN_TIMEOUT 2000UL
+#endif
+
+/**
+ * @def WIFICREDS_STATS_TIMEOUT_MARGIN
+ * @brief Milliseconds added to the estimated 99th percentile latency
+ */
+#ifndef WIFICREDS_STATS_TIMEOUT_MARGIN
+#define WIFICREDS_STATS_TIMEOUT_MARGIN 500UL
+#endif
+
+/**
+ * @def WIFICREDS_STATS_FAILING_TIMEOUT
+ * @brief Timeout in milliseconds for a set that always fails and never connected
+ *
+ * Without a latency sample the timeout falls from WIFICREDS_CONNECT_TIMEOUT
+ * towards this value as the failure rate rises. It stays long enough for a
+ * slow network to connect once, after which its latency is learned.
+ */
+#ifndef WIFICREDS_STATS_FAILING_TIMEOUT
+#define WIFICREDS_STATS_FAILING_TIMEOUT 10000UL
+#endif
+
+/**
+ * @def WIFICREDS_STATS_MIN_SAMPLES
+ * @brief Successful connects needed before the variance is trusted
+ *
+ * With fewer samples the timeout is twice the mean latency.
+ */
+#ifndef WIFICREDS_STATS_MIN_SAMPLES
+#define WIFICREDS_STATS_MIN_SAMPLES 3
+#endif
+
+/**
+ * @struct WiFiCredsStatsRecord
+ * @brief Connect statistics of one credential set
+ *
+ * The EWMAs weight each new sample with 1/8.
+ */
+struct WiFiCredsStatsRecord {
+    uint32_t varianceMs2; ///< EWMA variance of the connect latency in ms^2
+    uint16_t meanMs;      ///< EWMA connect latency in milliseconds
+    uint8_t failureRate;  ///< EWMA failure rate, 0 (never fails) to 255 (always fails)
+    uint8_t samples;      ///< Number of latency samples, saturating at 255
+};
+
+/**
+ * @class WiFiCredsStats
+ * @brief Learns connect latency per credential set and derives timeouts
+ *
+ * WiFiCredsConnection records every attempt here and uses timeout() when
+ * no explicit timeout is given, so sketches normally only read from it.
+ */
+class WiFiCredsStats {
+public:
+    /**
+     * @brief Record a successful connect
+     * @param credentialIndex Index of the credential set
+     * @param durationMs Time from starting the attempt to being connected
+     */
+    static void recordSuccess(size_t credentialIndex, uint32_t durationMs);
+
+    /**
+     * @brief Record an attempt rejected by the network or with the network not found
+     * @param credentialIndex Index of the credential set
+     */
+    static void recordFailure(size_t credentialIndex);
+
+    /**
+     * @brief Record an attempt that was abandoned after a timeout
+     *
+     * Counts as a failure and as a latency sample of at least @p elapsedMs,
+     * so a network that became slower raises its own timeout again instead
+     * of timing out forever.
+     *
+     * @param credentialIndex Index of the credential set
+     * @param elapsedMs Time the attempt ran before it was abandoned
+     */
+    static void recordTimeout(size_t credentialIndex, uint32_t elapsedMs);
+
+    /**
+     * @brief Learned timeout for a credential set
+     *
+     * mean + 2.33 standard deviations (the 99th percentile of a normal
+     * distribution) + WIFICREDS_STATS_TIMEOUT_MARGIN, clamped to
+     * WIFICREDS_STATS_MIN_TIMEOUT..WIFICREDS_CONNECT_TIMEOUT.
+     *
+     * A set that never connected has no latency samples. Its timeout is
+     * WIFICREDS_CONNECT_TIMEOUT scaled down by the failure rate, to
+     * WIFICREDS_STATS_FAILING_TIMEOUT for a set that keeps failing.
+     *
+     * @param credentialIndex Index of the credential set
+     * @return uint32_t Timeout in milliseconds
+     */
+    static uint32_t timeout(size_t credentialIndex);
+
+    /**
+     * @brief Read the statistics of a credential set
+     * @param credentialIndex Index of the credential set
+     * @param record Receives the statistics
+     * @return true if the index is valid, false otherwise
+     */
+    static bool get(size_t credentialIndex, WiFiCredsStatsRecord& record);
+
+    /**
+     * @brief Forget all statistics
+     */
+    static void reset();
+
+private:
+    // Prevent instantiation of this class
+    WiFiCredsStats() = delete;
+    WiFiCredsStats(const WiFiCredsStats&) = delete;
+    WiFiCredsStats& operator=(const WiFiCredsStats&) = delete;
+};
+
+#endif // WIFICREDS_STATS_H
@@ -0,0 +1,82 @@
+/**
+ * @file WiFiCredsStorage.h
+ * @brief Persistent byte storage interface used by WiFiCredsStore
+ * @author Rithik Krisna M
+ * @version 1.0.4
+ * @date 2025
+ *
+ * WiFiCredsStore keeps its log in a fixed-size region of byte-addressable
+ * storage reached through this interface, so the same store logic runs on
+ * every board and on a host machine.
+ *
+ * Implementations:
+ * - WiFiCredsEepromStorage (WiFiCredsEepromStorage.h): the Arduino EEPROM
+ *   library. Real EEPROM on AVR and the R4, NVS on ESP32, a flash sector on
+ *   ESP8266 and the Pico.
+ * - WiFiCredsFileStorage (WiFiCredsFileStorage.h): a file through POSIX I/O.
+ *   Host builds, and LittleFS or SPIFFS mounted into the ESP32 VFS.
+ */
+
+#ifndef WIFICREDS_STORAGE_H
+#define WIFICREDS_STORAGE_H
+
+#include "WiFiCreds.h"
+
+/**
+ * @class WiFiCredsStorage
+ * @brief Abstract fixed-size persistent byte region
+ *
+ * Offsets are relative to the start of the region. Writes may be buffered
+ * until commit(). When a WiFiCredsStore is read from several tasks,
+ * read() must be safe to call concurrently with itself and with write();
+ * both implementations in this library are.
+ */
+class WiFiCredsStorage {
+public:
+    virtual ~WiFiCredsStorage() {}
+
+    /**
+     * @brief Make the region ready, e.g. open its file
+     *
+     * WiFiCredsStore::begin() and WiFiCredsChannelMap::begin() call this
+     * first, before other tasks read, so no implementation has to set
+     * itself up lazily from a reading task.
+     *
+     * @return true if the region is usable, false otherwise
+     */
+    virtual bool begin() { return true; }
+
+    /**
+     * @brief Size of the region
+     * @return size_t Usable bytes, 0 if the storage is not available
+     */
+    virtual size_t size() = 0;
+
+    /**
+     * @brief Read bytes from the region
+     *
+     * @param offset First byte to read
+     * @param data Receives the bytes
+     * @param length Number of bytes
+     * @return true on success, false if the range is outside the region or the read failed
+     */
+    virtual bool read(size_t offset, void* data, size_t length) = 0;
+
+    /**
+     * @brief Write bytes to the region
+     *
+     * @param offset First byte to write
+     * @param data Bytes to write
+     * @param length Number of bytes
+     * @return true on success, false if the range is outside the region or the write failed
+     */
+    virtual bool write(size_t offset, const void* data, size_t length) = 0;
+
+    /**
+     * @brief Make all previous writes persistent
+     * @return true on success, false otherwise
+     */
+    virtual bool commit() = 0;
+};
+
+#endif // WIFICREDS_STORAGE_H
@@ -0,0 +1,471 @@
+/**
+ * @file WiFiCredsStore.cpp
+ * @brief Implementation of the runtime credential store
+ * @author Rithik Krisna M
+ * @version 1.0.4
+ * @date 2025
+ */
+
+#include "WiFiCredsStore.h"
+#include "WiFiCredsBlob.h"
+#include "WiFiCredsIndex.h"
+#include <string.h>     // Required for strlen, memcpy, memcmp and strcmp
+
+namespace {
+
+const uint32_t HALF_MAGIC = 0x31534357UL; // "WCS1" in little-endian byte order
+const size_t HALF_HEADER_SIZE = 8;
+
+// Record: type, nameLength, ssidLength, passwordLength, crc32 (little-endian), then the strings
+const size_t RECORD_HEADER_SIZE = 8;
+const uint8_t RECORD_PUT = 0x01;
+const uint8_t RECORD_REMOVE = 0x02;
+const uint8_t RECORD_END = 0xFF;        // Erased storage also reads as the end of the log
+
+const size_t MAX_NAME_LENGTH = WIFICREDS_NAME_BUFFER_SIZE - 1;
+const size_t MAX_SSID_LENGTH = WIFICREDS_SSID_BUFFER_SIZE - 1;
+const size_t MAX_PASSWORD_LENGTH = WIFICREDS_PASSWORD_BUFFER_SIZE - 1;
+const size_t MAX_RECORD_SIZE = RECORD_HEADER_SIZE + MAX_NAME_LENGTH + MAX_SSID_LENGTH + MAX_PASSWORD_LENGTH;
+
+// Record offsets are kept as uint16_t in the index
+const uint16_t EMPTY_SLOT = 0xFFFF;
+const size_t MAX_HALF_SIZE = 0x7FFF;
+
+static_assert(WIFICREDS_STORE_MAX_ENTRIES > 0 && WIFICREDS_STORE_INDEX_SIZE <= 0xFFFF,
+              "WIFICREDS_STORE_MAX_ENTRIES out of range");
+
+uint32_t readU32(const uint8_t* p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+void writeU32(uint8_t* p, uint32_t value) {
+    p[0] = static_cast<uint8_t>(value);
+    p[1] = static_cast<uint8_t>(value >> 8);
+    p[2] = static_cast<uint8_t>(value >> 16);
+    p[3] = static_cast<uint8_t>(value >> 24);
+}
+
+/**
+ * @brief Checksum of a record, computed with its crc field zeroed
+ */
+uint32_t recordCrc(uint8_t* record, size_t size) {
+    uint8_t stored[4];
+    memcpy(stored, record + 4, sizeof(stored));
+    memset(record + 4, 0, sizeof(stored));
+    const uint32_t crc = WiFiCredsBlob::crc32(record, size);
+    memcpy(record + 4, stored, sizeof(stored));
+    return crc;
+}
+
+uint8_t tagOf(uint32_t hash) {
+    return static_cast<uint8_t>(hash >> 24);
+}
+
+/**
+ * @brief Copy a string of known length, leaving an empty string if it does not fit
+ */
+template <size_t N>
+bool copyString(char (&buffer)[N], const char* s, size_t length) {
+    if (length >= N) {
+        buffer[0] = '\0';
+        return false;
+    }
+    memcpy(buffer, s, length + 1);
+    return true;
+}
+
+} // namespace
+
+WiFiCredsStore::WiFiCredsStore(WiFiCredsStorage& storage) : _storage(storage) {
+    for (size_t slot = 0; slot < WIFICREDS_STORE_INDEX_SIZE; slot++) {
+        _slots[slot].store(EMPTY_SLOT);
+    }
+    _name[0] = _ssid[0] = _password[0] = '\0';
+}
+
+bool WiFiCredsStore::begin() {
+    if (!_storage.begin()) {
+        return false;
+    }
+    size_t halfSize = _storage.size() / 2;
+    if (halfSize > MAX_HALF_SIZE) {
+        halfSize = MAX_HALF_SIZE;
+    }
+    if (halfSize < HALF_HEADER_SIZE + MAX_RECORD_SIZE) {
+        return false;
+    }
+
+    uint8_t headers[2][HALF_HEADER_SIZE];
+    if (!_storage.read(0, headers[0], HALF_HEADER_SIZE) || !_storage.read(halfSize, headers[1], HALF_HEADER_SIZE)) {
+        return false;
+    }
+
+    const bool valid0 = readU32(headers[0]) == HALF_MAGIC;
+    const bool valid1 = readU32(headers[1]) == HALF_MAGIC;
+    const uint32_t generation0 = readU32(headers[0] + 4);
+    const uint32_t generation1 = readU32(headers[1] + 4);
+
+    size_t active = 0;
+    uint32_t generation;
+    if (!valid0 && !valid1) {
+        // Unformatted: start an empty log in the first half
+        uint8_t header[HALF_HEADER_SIZE + 1];
+        writeU32(header, HALF_MAGIC);
+        writeU32(header + 4, 1);
+        header[HALF_HEADER_SIZE] = RECORD_END;
+        if (!_storage.write(0, header, sizeof(header)) || !_storage.commit()) {
+            return false;
+        }
+        generation = 1;
+    } else if (valid0 && (!valid1 || static_cast<int32_t>(generation0 - generation1) > 0)) {
+        // Signed difference keeps the comparison right across generation wrap-around
+        generation = generation0;
+    } else {
+        active = halfSize;
+        generation = generation1;
+    }
+
+    _lock.writeBegin();
+    _halfSize.store(halfSize);
+    _active.store(active);
+    _generation.store(generation);
+    const bool loaded = load();
+    _lock.writeEnd();
+    return loaded;
+}
+
+bool WiFiCredsStore::put(const char* name, const char* ssid, const char* password) {
+    if (name == nullptr || ssid == nullptr || password == nullptr) {
+        return false;
+    }
+    const size_t nameLength = strlen(name);
+    const size_t ssidLength = strlen(ssid);
+    if (nameLength == 0 || nameLength > MAX_NAME_LENGTH || ssidLength == 0 || ssidLength > MAX_SSID_LENGTH ||
+        strlen(password) > MAX_PASSWORD_LENGTH) {
+        return false;
+    }
+
+    // Rewriting an unchanged set would only wear the storage
+    if (loadStored(name) && strcmp(_ssid, ssid) == 0 && strcmp(_password, password) == 0) {
+        return true;
+    }
+
+    return append(RECORD_PUT, name, ssid, password);
+}
+
+bool WiFiCredsStore::remove(const char* name) {
+    if (name == nullptr || !loadStored(name)) {
+        return false;
+    }
+    return append(RECORD_REMOVE, name, "", "");
+}
+
+CredentialView WiFiCredsStore::resolve(const char* name) {
+    const CredentialView fixed = WiFiCreds::resolve(name);
+
+    if (name != nullptr && loadStored(name)) {
+        return makeView(CredentialResolution::Found,
+                        (fixed.resolution == CredentialResolution::Found) ? fixed.index : WiFiCreds::getCredentialCount());
+    }
+
+    // The default set the static tier fell back to may itself be replaced in the store
+    if (fixed.resolution != CredentialResolution::Found && fixed.resolution != CredentialResolution::None &&
+        loadStored(fixed.name)) {
+        return makeView(fixed.resolution, fixed.index);
+    }
+
+    return fixed;
+}
+
+bool WiFiCredsStore::hasCredential(const char* name) {
+    return WiFiCreds::hasCredential(name) || isStored(name);
+}
+
+bool WiFiCredsStore::isStored(const char* name) {
+    return name != nullptr && loadStored(name);
+}
+
+bool WiFiCredsStore::resolveInto(const char* name, WiFiCredsCopy& copy) const {
+    // The static tier never changes, so only the store part has to be repeated
+    const CredentialView fixed = WiFiCreds::resolve(name);
+    const bool fallback = fixed.resolution == CredentialResolution::Default ||
+                          fixed.resolution == CredentialResolution::Fallback;
+
+    uint8_t record[MAX_RECORD_SIZE];
+    bool stored;
+    bool replacesDefault;
+    uint32_t version;
+    do {
+        version = _lock.readBegin();
+        stored = name != nullptr && readStored(name, record);
+        replacesDefault = !stored && fallback && readStored(fixed.name, record);
+    } while (_lock.readRetry(version));
+
+    if (stored || replacesDefault) {
+        const uint8_t* strings = record + RECORD_HEADER_SIZE;
+        memcpy(copy.name, strings, record[1]);
+        copy.name[record[1]] = '\0';
+        memcpy(copy.ssid, strings + record[1], record[2]);
+        copy.ssid[record[2]] = '\0';
+        memcpy(copy.password, strings + record[1] + record[2], record[3]);
+        copy.password[record[3]] = '\0';
+        memset(record, 0, sizeof(record));
+        if (stored) {
+            copy.index = (fixed.resolution == CredentialResolution::Found) ? fixed.index : WiFiCreds::getCredentialCount();
+            copy.resolution = CredentialResolution::Found;
+        } else {
+            copy.index = fixed.index;
+            copy.resolution = fixed.resolution;
+        }
+        return true;
+    }
+
+    copy.index = fixed.index;
+    copy.resolution = fixed.resolution;
+    if (fixed.resolution == CredentialResolution::None) {
+        copy.name[0] = copy.ssid[0] = copy.password[0] = '\0';
+        return false;
+    }
+    return copyString(copy.name, fixed.name, strlen(fixed.name)) &&
+           copyString(copy.ssid, fixed.ssid, fixed.ssidLength) &&
+           (fixed.sealed ? WiFiCreds::copyPassword(fixed.name, copy.password, sizeof(copy.password))
+                         : copyString(copy.password, fixed.password, fixed.passwordLength));
+}
+
+bool WiFiCredsStore::compact() {
+    const size_t halfSize = _halfSize.load();
+    if (halfSize == 0) {
+        return false;
+    }
+
+    const size_t target = (_active.load() == 0) ? halfSize : 0;
+    size_t position = target + HALF_HEADER_SIZE;
+    uint8_t record[MAX_RECORD_SIZE];
+
+    // Copy live sets first; the target only becomes active once its header is written
+    for (size_t slot = 0; slot < WIFICREDS_STORE_INDEX_SIZE; slot++) {
+        const uint16_t offset = _slots[slot].load();
+        if (offset == EMPTY_SLOT) {
+            continue;
+        }
+        const size_t size = readRecord(offset, record);
+        if (size == 0 || record[0] != RECORD_PUT) {
+            continue;
+        }
+        if (!_storage.write(position, record, size)) {
+            return false;
+        }
+        position += size;
+    }
+    if (position < target + halfSize && !_storage.write(position, &RECORD_END, 1)) {
+        return false;
+    }
+    if (!_storage.commit()) {
+        return false;
+    }
+
+    uint8_t header[HALF_HEADER_SIZE];
+    writeU32(header, HALF_MAGIC);
+    writeU32(header + 4, _generation.load() + 1);
+    if (!_storage.write(target, header, sizeof(header)) || !_storage.commit()) {
+        return false;
+    }
+
+    _lock.writeBegin();
+    _active.store(target);
+    _generation.store(_generation.load() + 1);
+    const bool loaded = load();
+    _lock.writeEnd();
+    return loaded;
+}
+
+// ===== PRIVATE HELPER METHODS =====
+
+bool WiFiCredsStore::load() {
+    for (size_t slot = 0; slot < WIFICREDS_STORE_INDEX_SIZE; slot++) {
+        _slots[slot].store(EMPTY_SLOT);
+    }
+
+    uint8_t record[MAX_RECORD_SIZE];
+    size_t position = _active.load() + HALF_HEADER_SIZE;
+    size_t size;
+
+    // The log ends at the first record that is missing or fails its checksum
+    while ((size = readRecord(position, record)) != 0) {
+        memcpy(_name, record + RECORD_HEADER_SIZE, record[1]);
+        _name[record[1]] = '\0';
+
+        const uint32_t hash = WiFiCredsIndex::hashName(_name, 0);
+        const size_t slot = findSlot(_name, hash);
+        if (_slots[slot].load() == EMPTY_SLOT && usedSlots() >= WIFICREDS_STORE_MAX_ENTRIES) {
+            return false;
+        }
+        _slots[slot].store(static_cast<uint16_t>(position));
+        _tags[slot].store(tagOf(hash));
+        position += size;
+    }
+    _end.store(position);
+
+    size_t count = 0;
+    for (size_t slot = 0; slot < WIFICREDS_STORE_INDEX_SIZE; slot++) {
+        const uint16_t offset = _slots[slot].load();
+        uint8_t type;
+        if (offset != EMPTY_SLOT && _storage.read(offset, &type, 1) && type == RECORD_PUT) {
+            count++;
+        }
+    }
+    _count.store(count);
+    return true;
+}
+
+size_t WiFiCredsStore::findSlot(const char* name, uint32_t hash) const {
+    const size_t length = strlen(name);
+    const uint8_t tag = tagOf(hash);
+    size_t slot = hash % WIFICREDS_STORE_INDEX_SIZE;
+
+    // put() never stores a longer name, and its record would not fit the buffer below;
+    // probing on without reads ends at the empty slot, which reports "not found"
+    const bool storable = length <= MAX_NAME_LENGTH;
+
+    // The index is at most half full, so an empty slot is always reached; the
+    // probe limit only matters for a reader racing an index rebuild
+    uint16_t offset;
+    for (size_t probes = 0; (offset = _slots[slot].load()) != EMPTY_SLOT && probes < WIFICREDS_STORE_INDEX_SIZE;
+         probes++) {
+        if (storable && _tags[slot].load() == tag) {
+            // One read covers the record header and a name of the wanted length
+            uint8_t stored[RECORD_HEADER_SIZE + MAX_NAME_LENGTH];
+            if (_storage.read(offset, stored, RECORD_HEADER_SIZE + length) && stored[1] == length &&
+                memcmp(stored + RECORD_HEADER_SIZE, name, length) == 0) {
+                return slot;
+            }
+        }
+        slot = (slot + 1) % WIFICREDS_STORE_INDEX_SIZE;
+    }
+    return slot;
+}
+
+size_t WiFiCredsStore::usedSlots() const {
+    size_t used = 0;
+    for (size_t slot = 0; slot < WIFICREDS_STORE_INDEX_SIZE; slot++) {
+        if (_slots[slot].load() != EMPTY_SLOT) {
+            used++;
+        }
+    }
+    return used;
+}
+
+size_t WiFiCredsStore::readRecord(size_t offset, uint8_t* record) const {
+    const size_t limit = _active.load() + _halfSize.load();
+    if (offset + RECORD_HEADER_SIZE > limit || !_storage.read(offset, record, RECORD_HEADER_SIZE)) {
+        return 0;
+    }
+
+    const uint8_t type = record[0];
+    if ((type != RECORD_PUT && type != RECORD_REMOVE) || record[1] == 0 || record[1] > MAX_NAME_LENGTH ||
+        record[2] > MAX_SSID_LENGTH || record[3] > MAX_PASSWORD_LENGTH) {
+        return 0;
+    }
+
+    const size_t size = RECORD_HEADER_SIZE + record[1] + record[2] + record[3];
+    if (offset + size > limit || !_storage.read(offset + RECORD_HEADER_SIZE, record + RECORD_HEADER_SIZE,
+                                                size - RECORD_HEADER_SIZE)) {
+        return 0;
+    }
+    return (recordCrc(record, size) == readU32(record + 4)) ? size : 0;
+}
+
+bool WiFiCredsStore::append(uint8_t type, const char* name, const char* ssid, const char* password) {
+    uint8_t record[MAX_RECORD_SIZE + 1];
+    const size_t nameLength = strlen(name);
+    const size_t ssidLength = strlen(ssid);
+    const size_t passwordLength = strlen(password);
+    const size_t size = RECORD_HEADER_SIZE + nameLength + ssidLength + passwordLength;
+
+    record[0] = type;
+    record[1] = static_cast<uint8_t>(nameLength);
+    record[2] = static_cast<uint8_t>(ssidLength);
+    record[3] = static_cast<uint8_t>(passwordLength);
+    memcpy(record + RECORD_HEADER_SIZE, name, nameLength);
+    memcpy(record + RECORD_HEADER_SIZE + nameLength, ssid, ssidLength);
+    memcpy(record + RECORD_HEADER_SIZE + nameLength + ssidLength, password, passwordLength);
+    writeU32(record + 4, 0);
+    writeU32(record + 4, recordCrc(record, size));
+    record[size] = RECORD_END;
+
+    const uint32_t hash = WiFiCredsIndex::hashName(name, 0);
+    size_t slot = findSlot(name, hash);
+
+    // Compaction reclaims the space of replaced sets and the index slots of removed names
+    const bool indexFull = _slots[slot].load() == EMPTY_SLOT && usedSlots() >= WIFICREDS_STORE_MAX_ENTRIES;
+    if (indexFull || _end.load() + size > _active.load() + _halfSize.load()) {
+        if (!compact()) {
+            return false;
+        }
+        slot = findSlot(name, hash);
+        if ((_slots[slot].load() == EMPTY_SLOT && usedSlots() >= WIFICREDS_STORE_MAX_ENTRIES) ||
+            _end.load() + size > _active.load() + _halfSize.load()) {
+            return false;
+        }
+    }
+
+    const uint16_t previousOffset = _slots[slot].load();
+    uint8_t previous = RECORD_END;
+    if (previousOffset != EMPTY_SLOT && !_storage.read(previousOffset, &previous, 1)) {
+        return false;
+    }
+
+    // The end marker is only needed if the log does not fill the half exactly
+    const size_t end = _end.load();
+    const size_t length = (end + size < _active.load() + _halfSize.load()) ? size + 1 : size;
+    if (!_storage.write(end, record, length) || !_storage.commit()) {
+        return false;
+    }
+
+    // The record is complete before the index points to it; readers only have to
+    // retry if they overlap this publication
+    _lock.writeBegin();
+    _slots[slot].store(static_cast<uint16_t>(end));
+    _tags[slot].store(tagOf(hash));
+    _end.store(end + size);
+    _lock.writeEnd();
+
+    if (type == RECORD_PUT && previous != RECORD_PUT) {
+        _count.store(_count.load() + 1);
+    } else if (type == RECORD_REMOVE && previous == RECORD_PUT) {
+        _count.store(_count.load() - 1);
+    }
+    return true;
+}
+
+bool WiFiCredsStore::readStored(const char* name, uint8_t* record) const {
+    if (_halfSize.load() == 0) {
+        return false;
+    }
+
+    const size_t slot = findSlot(name, WiFiCredsIndex::hashName(name, 0));
+    const uint16_t offset = _slots[slot].load();
+    return offset != EMPTY_SLOT && readRecord(offset, record) != 0 && record[0] == RECORD_PUT;
+}
+
+bool WiFiCredsStore::loadStored(const char* name) {
+    uint8_t record[MAX_RECORD_SIZE];
+    if (!readStored(name, record)) {
+        return false;
+    }
+
+    const uint8_t* strings = record + RECORD_HEADER_SIZE;
+    memcpy(_name, strings, record[1]);
+    _name[record[1]] = '\0';
+    memcpy(_ssid, strings + record[1], record[2]);
+    _ssid[record[2]] = '\0';
+    memcpy(_password, strings + record[1] + record[2], record[3]);
+    _password[record[3]] = '\0';
+    return true;
+}
+
+CredentialView WiFiCredsStore::makeView(CredentialResolution resolution, size_t index) const {
+    CredentialView view = {_name, _ssid, _password, strlen(_ssid), strlen(_password), nullptr, index, resolution, false};
+    return view;
+}
\ No newline at end of file
@@ -0,0 +1,256 @@
+/**
+ * @file WiFiCredsStore.h
+ * @brief Runtime-updatable credential store with persistent log and RAM index
+ * @author Rithik Krisna M
+ * @version 1.0.4
+ * @date 2025
+ *
+ * Credentials in credentials.h can only change by reflashing. WiFiCredsStore
+ * adds a second, writable tier on top of them: credential sets written with
+ * put() are kept in persistent storage (WiFiCredsStorage) and take
+ * precedence over the compile-time table, which stays as the read-only
+ * fallback for every name the store does not hold.
+ *
+ * Storage layout: the region is split into two halves, each starting with
+ * an 8-byte header (magic "WCS1", uint32 generation). The half with the
+ * valid header and the highest generation is active. Changes are appended
+ * to the active half as checksummed records; nothing is rewritten in
+ * place, so writes move through the whole half instead of wearing out the
+ * same cells. When the half is full, the live records are copied into the
+ * other half, which then becomes active with the next generation. A torn
+ * write at the end of the log fails its checksum and is ignored.
+ *
+ * begin() replays the log once and builds an open-addressing hash index of
+ * names in RAM (3 bytes per slot, two slots per entry), so a lookup costs
+ * one hash and usually a single record read.
+ *
+ * @note Strings in views returned by resolve() point into buffers of the
+ *       store and stay valid until the next call on the same store
+ *
+ * Concurrent use (ESP32 and other FreeRTOS cores, host threads): one task
+ * may write with put(), remove() and compact() while any number of tasks
+ * read with resolveInto(). Readers take no lock; a sequence lock
+ * (WiFiCredsSeqLock) tells them to repeat a read that overlapped an index
+ * update. Writes are published atomically: a reader sees a set either
+ * before or after a put(), never a mix. Call begin() before the readers
+ * start. resolve(), hasCredential() and
+ * isStored() share the view buffers and are for single-task use.
+ */
+
+#ifndef WIFICREDS_STORE_H
+#define WIFICREDS_STORE_H
+
+#include "WiFiCreds.h"
+#include "WiFiCredsSeqLock.h"
+#include "WiFiCredsStorage.h"
+
+/**
+ * @def WIFICREDS_STORE_MAX_ENTRIES
+ * @brief Maximum number of distinct names in the store
+ *
+ * Sizes the RAM index. Removed names count until the next compaction.
+ */
+#ifndef WIFICREDS_STORE_MAX_ENTRIES
+#define WIFICREDS_STORE_MAX_ENTRIES 16
+#endif
+
+/// Number of hash index slots, kept at most half full
+#define WIFICREDS_STORE_INDEX_SIZE (WIFICREDS_STORE_MAX_ENTRIES * 2)
+
+/**
+ * @struct WiFiCredsCopy
+ * @brief A credential set copied into caller-owned buffers
+ *
+ * @warning Holds the password; clear it when done if the memory is reused
+ */
+struct WiFiCredsCopy {
+    char name[WIFICREDS_NAME_BUFFER_SIZE];
+    char ssid[WIFICREDS_SSID_BUFFER_SIZE];
+    char password[WIFICREDS_PASSWORD_BUFFER_SIZE];
+    size_t index;                    ///< As CredentialView::index of WiFiCredsStore::resolve()
+    CredentialResolution resolution; ///< How the requested name was resolved
+};
+
+/**
+ * @class WiFiCredsStore
+ * @brief Persistent credential sets with the static table as fallback
+ *
+ * @code
+ * WiFiCredsEepromStorage storage(0, 512);
+ * WiFiCredsStore store(storage);
+ *
+ * void setup() {
+ *     store.begin();
+ *     store.put("office", "OfficeNetwork", "NewOfficePassword"); // replaces the compiled-in password
+ *     CredentialView creds = store.resolve("office");
+ *     WiFi.begin(creds.ssid, creds.password);
+ * }
+ * @endcode
+ */
+class WiFiCredsStore {
+public:
+    /**
+     * @brief Create a store
+     * @param storage Persistent region holding the log
+     */
+    explicit WiFiCredsStore(WiFiCredsStorage& storage);
+
+    /**
+     * @brief Load the log and build the RAM index
+     *
+     * An unformatted region is formatted. Call once before any other method.
+     *
+     * @return true if the store is usable, false if the storage is too small,
+     *         cannot be read or holds more than WIFICREDS_STORE_MAX_ENTRIES names
+     */
+    bool begin();
+
+    /**
+     * @brief Add or replace a credential set
+     *
+     * Writing a set that is already stored unchanged costs no write.
+     *
+     * @param name Name of the set (1-32 characters)
+     * @param ssid Network SSID (1-32 characters)
+     * @param password Network password (0-64 characters)
+     * @return true if stored persistently, false if invalid or the store is full
+     */
+    bool put(const char* name, const char* ssid, const char* password);
+
+    /**
+     * @brief Remove a credential set from the store
+     *
+     * A compile-time set with the same name becomes visible again.
+     *
+     * @param name Name of the set
+     * @return true if removed, false if the store does not hold it or the write failed
+     */
+    bool remove(const char* name);
+
+    /**
+     * @brief Resolve a credential set by name, store first
+     *
+     * nullptr selects the default set, which is the first compile-time set
+     * or its replacement in the store. Names in neither tier fall back to the
+     * default set, as with WiFiCreds::resolve().
+     *
+     * @param name The name of the credential set, or nullptr for default
+     * @return CredentialView For stored sets, index is the index of the
+     *         compile-time set with the same name, or getCredentialCount() of
+     *         WiFiCreds if there is none; pmk is nullptr
+     */
+    CredentialView resolve(const char* name = nullptr);
+
+    /**
+     * @brief Resolve a credential set like resolve(), copying it out lock-free
+     *
+     * Safe to call from any number of tasks while one task writes. Only the
+     * store index and the record being copied are read, so a read that has
+     * to be repeated costs about as much as the first attempt.
+     *
+     * @param name The name of the credential set, or nullptr for default
+     * @param copy Receives the set; empty strings with CredentialResolution::None if there is none
+     * @return true if a set was copied, false if no credential sets are available or a
+     *         compiled-in string is longer than its WiFiCredsCopy buffer
+     * @note The static tier is read without copying through shared buffers, except in
+     *       PROGMEM mode, which is only used on single-task boards
+     */
+    bool resolveInto(const char* name, WiFiCredsCopy& copy) const;
+
+    /**
+     * @brief Check if a credential set exists in either tier
+     * @param name The name to check
+     * @return true if found, false otherwise
+     */
+    bool hasCredential(const char* name);
+
+    /**
+     * @brief Check if a credential set is held by the store itself
+     * @param name The name to check
+     * @return true if stored, false otherwise
+     */
+    bool isStored(const char* name);
+
+    /// Number of credential sets held by the store
+    size_t getCredentialCount() const { return _count.load(); }
+
+    /**
+     * @brief Copy the live records into the other half and switch to it
+     *
+     * put() and remove() compact automatically when the active half is full.
+     *
+     * @return true on success, false if the storage failed
+     */
+    bool compact();
+
+    /// Bytes of the active half in use, including its header
+    size_t usedBytes() const { return _end.load() - _active.load(); }
+
+    /// Size of one half, the most a compacted log can occupy
+    size_t capacity() const { return _halfSize.load(); }
+
+    /// Generation of the active half, incremented by every compaction
+    uint32_t generation() const { return _generation.load(); }
+
+private:
+    WiFiCredsStorage& _storage;
+
+    // Read by resolveInto() while the writer changes them, hence WiFiCredsSeqValue
+    WiFiCredsSeqValue<size_t> _halfSize;
+    WiFiCredsSeqValue<size_t> _active;            ///< Offset of the active half
+    WiFiCredsSeqValue<size_t> _end;               ///< Offset where the next record is appended
+    WiFiCredsSeqValue<uint32_t> _generation;
+    WiFiCredsSeqValue<size_t> _count;
+
+    WiFiCredsSeqLock _lock;    ///< Odd while the index or the active half changes
+
+    WiFiCredsSeqValue<uint16_t> _slots[WIFICREDS_STORE_INDEX_SIZE]; ///< Offset of the newest record per name
+    WiFiCredsSeqValue<uint8_t> _tags[WIFICREDS_STORE_INDEX_SIZE];   ///< High hash bits, skips most record reads
+
+    char _name[WIFICREDS_NAME_BUFFER_SIZE];
+    char _ssid[WIFICREDS_SSID_BUFFER_SIZE];
+    char _password[WIFICREDS_PASSWORD_BUFFER_SIZE];
+
+    /**
+     * @brief Replay the active half into the index
+     */
+    bool load();
+
+    /**
+     * @brief Find the index slot of a name
+     * @return size_t The slot holding @p name, or the empty slot where it would be inserted
+     */
+    size_t findSlot(const char* name, uint32_t hash) const;
+
+    /// Number of occupied index slots
+    size_t usedSlots() const;
+
+    /**
+     * @brief Read and check the record at @p offset of the active half
+     * @param record Receives the header and strings
+     * @return size_t Record size, or 0 if there is no valid record
+     */
+    size_t readRecord(size_t offset, uint8_t* record) const;
+
+    /**
+     * @brief Append a record, compacting first if the half or the index is full
+     */
+    bool append(uint8_t type, const char* name, const char* ssid, const char* password);
+
+    /**
+     * @brief Read the live record of a stored set
+     * @param record Receives the record
+     * @return true if the store holds a live set named @p name
+     */
+    bool readStored(const char* name, uint8_t* record) const;
+
+    /**
+     * @brief Load a stored set into the view buffers
+     * @return true if the store holds a live set named @p name
+     */
+    bool loadStored(const char* name);
+
+    CredentialView makeView(CredentialResolution resolution, size_t index) const;
+};
+
+#endif // WIFICREDS_STORE_H
@@ -0,0 +1,28 @@
+/**
+ * @file WiFiCredsTable.h
+ * @brief Selects the credentials header that defines CREDENTIAL_SETS
+ * @author Rithik Krisna M
+ * @version 1.0.4
+ * @date 2025
+ *
+ * credentials.h next to the library sources is used unless the build names
+ * another table, e.g. one per site or a test fixture:
+ *
+ *     -DWIFICREDS_CREDENTIALS_HEADER='"site_credentials.h"'
+ *
+ * @note Internal header; every translation unit that reads CREDENTIAL_SETS
+ *       includes it, so they all see the same table
+ */
+
+#ifndef WIFICREDS_TABLE_H
+#define WIFICREDS_TABLE_H
+
+#include "WiFiCreds.h"
+
+#ifdef WIFICREDS_CREDENTIALS_HEADER
+#include WIFICREDS_CREDENTIALS_HEADER
+#else
+#include "credentials.h" // Contains actual SSID and password definitions
+#endif
+
+#endif // WIFICREDS_TABLE_H
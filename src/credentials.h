@@ -11,40 +11,31 @@
  * Add credentials.h to your .gitignore file.
  * 
  * NOTE: The first credential set is always used as the default.
+ * NOTE: The array must be constexpr so the name index can be built at compile time.
  */
 
 #ifndef CREDENTIALS_H
 #define CREDENTIALS_H
 
 // Multiple credential sets
-const CredentialSet CREDENTIAL_SETS[] = {
+// WIFICREDS_SET(name, ssid, password) also stores the string lengths
+// WIFICREDS_SET_PMK(name, ssid, password, pmk) additionally stores a precomputed 32-byte PMK
+//
+// To keep the table in flash on AVR/ESP8266 (PROGMEM mode), define the strings first:
+//   #define WIFICREDS_USE_PROGMEM 1
+//   WIFICREDS_FLASH_ENTRY(home, "MyHomeWiFi", "HomePassword123");
+//   constexpr CredentialSet CREDENTIAL_SETS[] WIFICREDS_FLASH = {
+//       WIFICREDS_FLASH_SET(home),
+//       WIFICREDS_TERMINATOR
+//   };
+constexpr CredentialSet CREDENTIAL_SETS[] = {
     // First set is always the default
-    {
-        .name = "home",
-        .ssid = "MyHomeWiFi",
-        .password = "HomePassword123"
-    },
-    {
-        .name = "office",
-        .ssid = "OfficeNetwork",
-        .password = "OfficePassword456"
-    },
-    {
-        .name = "guest",
-        .ssid = "GuestWiFi",
-        .password = "GuestPassword789"
-    },
-    {
-        .name = "mobile",
-        .ssid = "MyPhoneHotspot",
-        .password = "MobilePassword"
-    },
+    WIFICREDS_SET("home", "MyHomeWiFi", "HomePassword123"),
+    WIFICREDS_SET("office", "OfficeNetwork", "OfficePassword456"),
+    WIFICREDS_SET("guest", "GuestWiFi", "GuestPassword789"),
+    WIFICREDS_SET("mobile", "MyPhoneHotspot", "MobilePassword"),
     // Terminator entry - must be last!
-    {
-        .name = nullptr,
-        .ssid = nullptr,
-        .password = nullptr
-    }
+    WIFICREDS_TERMINATOR
 };
 
 #endif // CREDENTIALS_H 